@@ -9,5 +9,11 @@ if(WITH_TESTING)
     new_test(SOURCES BasicTest.cpp ${SIMPLE_TEST_MAIN})
     new_test(SOURCES KernelTest.cpp ${SIMPLE_TEST_MAIN})
   endif()
+
+  if(HAVE_SICONOS_MECHANICS AND WITH_HDF5)
+    begin_tests(src/test DEPS "CPPUNIT::CPPUNIT")
+    new_test(SOURCES MechanicsHDF5WriterTest.cpp ${SIMPLE_TEST_MAIN} DEPS "${HDF5_C_LIBRARIES}")
+    target_include_directories(MechanicsHDF5WriterTest PRIVATE ${HDF5_C_INCLUDE_DIRS})
+  endif()
   
 endif()
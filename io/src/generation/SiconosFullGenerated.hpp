@@ -334,7 +334,10 @@ SICONOS_IO_REGISTER_WITH_BASES(LagrangianDS,(DynamicalSystem),
   (_q0)
   (_qMemory)
   (_reactionToBoundaryConditions)
+  (_restingSteps)
   (_rhsMatrices)
+  (_sleeping)
+  (_sleepingForces)
   (_velocity0)
   (_velocityMemory))
 SICONOS_IO_REGISTER_WITH_BASES(NewtonEulerDS,(DynamicalSystem),
@@ -385,8 +388,11 @@ SICONOS_IO_REGISTER_WITH_BASES(NewtonEulerDS,(DynamicalSystem),
   (_qDim)
   (_qMemory)
   (_reactionToBoundaryConditions)
+  (_restingSteps)
   (_rhsMatrices)
   (_scalarMass)
+  (_sleeping)
+  (_sleepingForces)
   (_twist)
   (_twist0)
   (_twistMemory)
@@ -496,9 +502,13 @@ SICONOS_IO_REGISTER(Simulation,
   (_nsds)
   (_nsdsChangeLogPosition)
   (_numberOfIndexSets)
+  (_numberOfSleepingDS)
   (_printStat)
   (_relativeConvergenceCriterionHeld)
   (_relativeConvergenceTol)
+  (_sleeping)
+  (_sleepingSteps)
+  (_sleepingVelocityThreshold)
   (_staticLevels)
   (_tend)
   (_tinit)
@@ -561,6 +571,7 @@ SICONOS_IO_REGISTER(OneStepIntegrator,
   (_levelMaxForOutput)
   (_levelMinForInput)
   (_levelMinForOutput)
+  (_parallelDSLoops)
   (_simulation)
   (_sizeMem)
   (_steps))
@@ -609,6 +620,7 @@ SICONOS_IO_REGISTER(OneStepNSProblem,
   (_indexSetLevel)
   (_inputOutputLevel)
   (_maxSize)
+  (_parallelAssembly)
   (_simulation)
   (_sizeOutput))
 SICONOS_IO_REGISTER(OSNSMatrix,
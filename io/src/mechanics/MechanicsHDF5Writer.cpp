@@ -0,0 +1,273 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2024 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "MechanicsHDF5Writer.hpp"
+
+#ifdef WITH_HDF5
+
+#include <hdf5.h>
+
+#include "SiconosException.hpp"
+
+//#define DEBUG_MESSAGES 1
+#include "siconos_debug.h"
+
+/* names of the datasets, as in siconos.io.mechanics_hdf5 */
+static const char* dataset_names[] = { "dynamic", "velocities", "cf" };
+
+/* rows of a chunk, as in siconos.io.mechanics_hdf5 */
+static const hsize_t chunk_rows = 4000;
+
+struct MechanicsHDF5Writer::Storage
+{
+  hid_t file = -1;
+  hid_t group = -1;
+  hid_t datasets[NUMBER_OF_DATASETS] = { -1, -1, -1 };
+
+  ~Storage()
+  {
+    for(hid_t dataset : datasets)
+      if(dataset >= 0) H5Dclose(dataset);
+    if(group >= 0) H5Gclose(group);
+    if(file >= 0) H5Fclose(file);
+  }
+};
+
+/* open the dataset name of group, or create it with columns columns */
+static hid_t open_dataset(hid_t group, const char* name, hsize_t columns,
+                          unsigned int compressionLevel)
+{
+  hsize_t dims[2];
+  if(H5Lexists(group, name, H5P_DEFAULT) > 0)
+  {
+    hid_t dataset = H5Dopen2(group, name, H5P_DEFAULT);
+    if(dataset < 0)
+      THROW_EXCEPTION("cannot open dataset " + std::string(name));
+    hid_t space = H5Dget_space(dataset);
+    int rank = H5Sget_simple_extent_ndims(space);
+    if(rank == 2) H5Sget_simple_extent_dims(space, dims, NULL);
+    H5Sclose(space);
+    if(rank != 2 || dims[1] != columns)
+    {
+      H5Dclose(dataset);
+      THROW_EXCEPTION("dataset " + std::string(name) + " has not "
+                      + std::to_string(columns) + " columns");
+    }
+    return dataset;
+  }
+
+  dims[0] = 0;
+  dims[1] = columns;
+  hsize_t maxdims[2] = { H5S_UNLIMITED, columns };
+  hsize_t chunk[2] = { chunk_rows, columns };
+  hid_t space = H5Screate_simple(2, dims, maxdims);
+  hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(properties, 2, chunk);
+  if(compressionLevel)
+    H5Pset_deflate(properties, compressionLevel);
+  hid_t dataset = H5Dcreate2(group, name, H5T_NATIVE_DOUBLE, space,
+                             H5P_DEFAULT, properties, H5P_DEFAULT);
+  H5Pclose(properties);
+  H5Sclose(space);
+  if(dataset < 0)
+    THROW_EXCEPTION("cannot create dataset " + std::string(name));
+  return dataset;
+}
+
+/* append rows to a dataset with columns columns */
+static void append_rows(hid_t dataset, const std::vector<double>& rows,
+                        hsize_t columns)
+{
+  hsize_t dims[2];
+  hid_t space = H5Dget_space(dataset);
+  H5Sget_simple_extent_dims(space, dims, NULL);
+  H5Sclose(space);
+
+  hsize_t start[2] = { dims[0], 0 };
+  hsize_t count[2] = { rows.size() / columns, columns };
+  dims[0] += count[0];
+  if(H5Dset_extent(dataset, dims) < 0)
+    THROW_EXCEPTION("cannot extend dataset");
+
+  space = H5Dget_space(dataset);
+  H5Sselect_hyperslab(space, H5S_SELECT_SET, start, NULL, count, NULL);
+  hid_t memory = H5Screate_simple(2, count, NULL);
+  herr_t status = H5Dwrite(dataset, H5T_NATIVE_DOUBLE, memory, space,
+                           H5P_DEFAULT, rows.data());
+  H5Sclose(memory);
+  H5Sclose(space);
+  if(status < 0)
+    THROW_EXCEPTION("cannot write dataset");
+}
+
+MechanicsHDF5Writer::MechanicsHDF5Writer(const std::string& filename,
+                                         unsigned int flushInterval,
+                                         unsigned int compressionLevel):
+  _flushInterval(flushInterval), _compressionLevel(compressionLevel),
+  _storage(new Storage())
+{
+  H5E_BEGIN_TRY
+  {
+    _storage->file = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+  }
+  H5E_END_TRY;
+  if(_storage->file < 0)
+    _storage->file = H5Fcreate(filename.c_str(), H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT);
+  if(_storage->file < 0)
+    THROW_EXCEPTION("cannot open " + filename);
+
+  if(H5Lexists(_storage->file, "data", H5P_DEFAULT) > 0)
+    _storage->group = H5Gopen2(_storage->file, "data", H5P_DEFAULT);
+  else
+    _storage->group = H5Gcreate2(_storage->file, "data", H5P_DEFAULT,
+                                 H5P_DEFAULT, H5P_DEFAULT);
+  if(_storage->group < 0)
+    THROW_EXCEPTION("cannot open group data of " + filename);
+
+  _thread = std::thread(&MechanicsHDF5Writer::_run, this);
+}
+
+MechanicsHDF5Writer::~MechanicsHDF5Writer()
+{
+  try
+  {
+    flush();
+  }
+  catch(...)
+  {
+    // a destructor must not throw: call wait() before to get the errors
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _condition.notify_all();
+  _thread.join();
+}
+
+void MechanicsHDF5Writer::output(const NonSmoothDynamicalSystem& nsds, double time)
+{
+  unsigned int columns[NUMBER_OF_DATASETS] = {};
+  size_t sizes[NUMBER_OF_DATASETS];
+  for(unsigned int d = 0; d < NUMBER_OF_DATASETS; ++d)
+    sizes[d] = _rows[d].size();
+
+  columns[DYNAMIC] = _io.appendPositions(nsds, time, _rows[DYNAMIC]);
+  if(_outputVelocities)
+    columns[VELOCITIES] = _io.appendVelocities(nsds, time, _rows[VELOCITIES]);
+  if(_outputContactPoints)
+    columns[CONTACT_POINTS] = _io.appendContactPoints(nsds, time, _rows[CONTACT_POINTS],
+                                                      _contactIndexSet);
+
+  for(unsigned int d = 0; d < NUMBER_OF_DATASETS; ++d)
+  {
+    if(!columns[d]) continue;
+    if(!_columns[d])
+      _columns[d] = columns[d];
+    if(columns[d] != _columns[d] || (_rows[d].size() - sizes[d]) % columns[d])
+    {
+      for(unsigned int e = 0; e < NUMBER_OF_DATASETS; ++e)
+        _rows[e].resize(sizes[e]);
+      THROW_EXCEPTION("the rows of dataset " + std::string(dataset_names[d])
+                      + " do not have the same number of columns");
+    }
+  }
+
+  if(_flushInterval && ++_steps % _flushInterval == 0)
+    flush();
+}
+
+void MechanicsHDF5Writer::_waitPending(std::unique_lock<std::mutex>& lock)
+{
+  _condition.wait(lock, [this] { return !_pending; });
+  if(_error)
+  {
+    std::exception_ptr error = _error;
+    _error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void MechanicsHDF5Writer::flush()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _waitPending(lock);
+  // the buffers emptied by the background thread are reused, so that
+  // nothing is allocated once the first buffers have grown
+  for(unsigned int d = 0; d < NUMBER_OF_DATASETS; ++d)
+  {
+    std::swap(_rows[d], _pendingRows[d]);
+    _pendingColumns[d] = _columns[d];
+  }
+  _pending = true;
+  lock.unlock();
+  _condition.notify_all();
+}
+
+void MechanicsHDF5Writer::wait()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _waitPending(lock);
+}
+
+void MechanicsHDF5Writer::_run()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while(true)
+  {
+    _condition.wait(lock, [this] { return _pending || _stop; });
+    if(!_pending) break;
+
+    lock.unlock();
+    std::exception_ptr error;
+    try
+    {
+      _write();
+    }
+    catch(...)
+    {
+      error = std::current_exception();
+    }
+    for(std::vector<double>& rows : _pendingRows)
+      rows.clear();
+    lock.lock();
+    if(error) _error = error;
+    _pending = false;
+    _condition.notify_all();
+  }
+}
+
+void MechanicsHDF5Writer::_write()
+{
+  for(unsigned int d = 0; d < NUMBER_OF_DATASETS; ++d)
+  {
+    std::vector<double>& rows = _pendingRows[d];
+    if(rows.empty()) continue;
+    DEBUG_PRINTF("write %zu rows in %s\n", rows.size() / _pendingColumns[d],
+                 dataset_names[d]);
+
+    hid_t& dataset = _storage->datasets[d];
+    if(dataset < 0)
+      dataset = open_dataset(_storage->group, dataset_names[d],
+                             _pendingColumns[d], _compressionLevel);
+    append_rows(dataset, rows, _pendingColumns[d]);
+  }
+  H5Fflush(_storage->file, H5F_SCOPE_LOCAL);
+}
+
+#endif
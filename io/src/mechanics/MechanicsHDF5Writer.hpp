@@ -0,0 +1,179 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2024 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef MechanicsHDF5Writer_hpp
+#define MechanicsHDF5Writer_hpp
+
+#include "SiconosConfig.h"
+
+#ifdef WITH_HDF5
+
+#include "MechanicsIO.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Output of a mechanical simulation in a HDF5 file.
+ *
+ * The rows of MechanicsIO::positions(), velocities() and contactPoints(),
+ * preceded by the time, are appended to the datasets data/dynamic,
+ * data/velocities and data/cf, as siconos.io.mechanics_run does. They are
+ * filled directly from the graphs of the topology and kept in memory for
+ * flushInterval steps, then written to the file by a background thread
+ * while the simulation goes on.
+ *
+ * The datasets are extendible and chunked, and compressed with deflate if
+ * a compression level is given. An existing file is opened in append mode
+ * and its datasets are extended. The file must not be opened by another
+ * writer in the meantime, and the HDF5 library must not be used by the
+ * rest of the program while a flush is pending (see wait()), unless it is
+ * built thread-safe.
+ *
+ * The rows are written as MechanicsIO returns them, without the
+ * conversion of the 2D rows to the 3D layout done by mechanics_run.
+ *
+ * siconos.io.mechanics_run does not use this writer: its file stays open
+ * in h5py, which writes other groups at each step and may be linked to
+ * another HDF5 library. The writer is meant for the programs, in C++ or
+ * Python, that drive the simulation and own the output file.
+ */
+class MechanicsHDF5Writer
+{
+private:
+
+  enum { DYNAMIC, VELOCITIES, CONTACT_POINTS, NUMBER_OF_DATASETS };
+
+  /** file, group and dataset handles, only used by the background thread */
+  struct Storage;
+
+  MechanicsIO _io;
+
+  unsigned int _flushInterval;
+
+  unsigned int _compressionLevel;
+
+  unsigned int _contactIndexSet = 1;
+
+  bool _outputVelocities = true;
+
+  bool _outputContactPoints = true;
+
+  unsigned int _steps = 0;
+
+  /** rows filled by output() */
+  std::vector<double> _rows[NUMBER_OF_DATASETS];
+
+  unsigned int _columns[NUMBER_OF_DATASETS] = {};
+
+  /** rows handed to the background thread by flush() */
+  std::vector<double> _pendingRows[NUMBER_OF_DATASETS];
+
+  unsigned int _pendingColumns[NUMBER_OF_DATASETS] = {};
+
+  std::unique_ptr<Storage> _storage;
+
+  std::mutex _mutex;
+
+  std::condition_variable _condition;
+
+  bool _pending = false;
+
+  bool _stop = false;
+
+  /** an error of the background thread, rethrown by flush() or wait() */
+  std::exception_ptr _error;
+
+  std::thread _thread;
+
+  void _run();
+
+  void _write();
+
+  void _waitPending(std::unique_lock<std::mutex>& lock);
+
+public:
+
+  /** open (or create) the file and start the background thread
+   * \param filename the HDF5 file
+   * \param flushInterval number of calls to output() between two writes
+   * \param compressionLevel deflate level of new datasets, 0 for none
+   */
+  MechanicsHDF5Writer(const std::string& filename,
+                      unsigned int flushInterval = 100,
+                      unsigned int compressionLevel = 0);
+
+  /** write the remaining rows and close the file */
+  ~MechanicsHDF5Writer();
+
+  MechanicsHDF5Writer(const MechanicsHDF5Writer&) = delete;
+  MechanicsHDF5Writer& operator=(const MechanicsHDF5Writer&) = delete;
+
+  /** \return the number of calls to output() between two writes */
+  unsigned int flushInterval() const
+  {
+    return _flushInterval;
+  }
+
+  /** \param n number of calls to output() between two writes */
+  void setFlushInterval(unsigned int n)
+  {
+    _flushInterval = n;
+  }
+
+  /** \param b true if the velocities are written (default) */
+  void setOutputVelocities(bool b)
+  {
+    _outputVelocities = b;
+  }
+
+  /** \param b true if the contact points are written (default) */
+  void setOutputContactPoints(bool b)
+  {
+    _outputContactPoints = b;
+  }
+
+  /** \param index_set the index set of the written contact points (default 1) */
+  void setContactIndexSet(unsigned int index_set)
+  {
+    _contactIndexSet = index_set;
+  }
+
+  /** buffer the output of the current step, and flush the buffers every
+   * flushInterval calls
+   * \param nsds current nonsmooth dynamical system
+   * \param time current time
+   */
+  void output(const NonSmoothDynamicalSystem& nsds, double time);
+
+  /** hand the buffered rows to the background thread, after the previous
+   * ones have been written. Returns without waiting for the write.
+   */
+  void flush();
+
+  /** wait until the rows handed to the background thread are written */
+  void wait();
+};
+
+#endif
+
+#endif
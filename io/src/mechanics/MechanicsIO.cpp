@@ -168,6 +168,37 @@ struct GetVelocity : public SiconosVisitor
   }
 };
 
+/* append time, number, q to a row-major buffer */
+struct AppendPosition : public SiconosVisitor
+{
+  std::vector<double>* rows;
+  double time;
+
+  template<typename T>
+  void operator()(const T& ds)
+  {
+    const SiconosVector& q = *ds.q();
+    rows->push_back(time);
+    rows->push_back(ds.number());
+    rows->insert(rows->end(), q.getArray(), q.getArray() + q.size());
+  }
+};
+
+struct AppendVelocity : public SiconosVisitor
+{
+  std::vector<double>* rows;
+  double time;
+
+  template<typename T>
+  void operator()(const T& ds)
+  {
+    const SiconosVector& v = *ds.velocity();
+    rows->push_back(time);
+    rows->push_back(ds.number());
+    rows->insert(rows->end(), v.getArray(), v.getArray() + v.size());
+  }
+};
+
 struct ForMu : public Question<double>
 {
   using SiconosVisitor::visit;
@@ -685,6 +716,18 @@ SP::SimpleMatrix MechanicsIO::velocities(const NonSmoothDynamicalSystem& nsds) c
          (*nsds.topology()->dSG(0));
 }
 
+/* a visitor for the relations of the contact points */
+typedef Visitor < Classes <
+  NewtonEuler1DR,
+  NewtonEuler3DR,
+  NewtonEuler5DR,
+  Lagrangian2d2DR,
+  Lagrangian2d3DR,
+  CircleCircleR,
+  DiskDiskR,
+  DiskPlanR>,
+ContactPointVisitor>::Make ContactPointInspector;
+
 SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds,
     unsigned int index_set) const
 {
@@ -703,17 +746,6 @@ SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds
     {
       DEBUG_PRINTF("process interaction : %p\n", &*graph.bundle(*vi));
 
-      /* create a visitor for specified classes */
-      typedef Visitor < Classes <
-        NewtonEuler1DR,
-        NewtonEuler3DR,
-        NewtonEuler5DR,
-        Lagrangian2d2DR,
-        Lagrangian2d3DR,
-        CircleCircleR,
-        DiskDiskR,
-        DiskPlanR>,
-      ContactPointVisitor>::Make ContactPointInspector;
       ContactPointInspector inspector;
       inspector.inter = graph.bundle(*vi);
       graph.bundle(*vi)->relation()->accept(inspector);
@@ -752,6 +784,72 @@ SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds
   return result;
 }
 
+template<typename T, typename G>
+unsigned int MechanicsIO::visitAllVerticesForRows(const G& graph, double time,
+                                                  std::vector<double>& rows) const
+{
+  size_t start = rows.size();
+  unsigned int columns = 0;
+  typename G::VIterator vi, viend;
+  for(std::tie(vi,viend)=graph.vertices(); vi!=viend; ++vi)
+  {
+    T getter;
+    getter.rows = &rows;
+    getter.time = time;
+    graph.bundle(*vi)->accept(getter);
+    if(!columns) columns = rows.size() - start;
+  }
+  return columns;
+}
+
+unsigned int MechanicsIO::appendPositions(const NonSmoothDynamicalSystem& nsds,
+                                          double time, std::vector<double>& rows) const
+{
+  typedef
+  Visitor < Classes < LagrangianDS, NewtonEulerDS >,
+          AppendPosition >::Make Appender;
+
+  return visitAllVerticesForRows<Appender>(*nsds.topology()->dSG(0), time, rows);
+}
+
+unsigned int MechanicsIO::appendVelocities(const NonSmoothDynamicalSystem& nsds,
+                                           double time, std::vector<double>& rows) const
+{
+  typedef
+  Visitor < Classes < LagrangianDS, NewtonEulerDS >,
+          AppendVelocity >::Make Appender;
+
+  return visitAllVerticesForRows<Appender>(*nsds.topology()->dSG(0), time, rows);
+}
+
+unsigned int MechanicsIO::appendContactPoints(const NonSmoothDynamicalSystem& nsds,
+                                              double time, std::vector<double>& rows,
+                                              unsigned int index_set) const
+{
+  unsigned int columns = 0;
+  if(nsds.topology()->numberOfIndexSet() > index_set)
+  {
+    InteractionsGraph& graph = *nsds.topology()->indexSet(index_set);
+    InteractionsGraph::VIterator vi, viend;
+    for(std::tie(vi,viend) = graph.vertices(); vi!=viend; ++vi)
+    {
+      ContactPointInspector inspector;
+      inspector.inter = graph.bundle(*vi);
+      graph.bundle(*vi)->relation()->accept(inspector);
+      const SiconosVector& data = inspector.answer;
+      if(data.size() == 0) continue; // not a contact point (perhaps a joint)
+
+      // same row as contactPoints(), with the time in front
+      rows.push_back(time);
+      rows.insert(rows.end(), data.getArray(), data.getArray() + data.size());
+      rows.push_back(graph.properties(*vi).source->number());
+      rows.push_back(graph.properties(*vi).target->number());
+      if(!columns) columns = data.size() + 3;
+    }
+  }
+  return columns;
+}
+
 /* Get contact informations */
 /* default: a visitor that do nothing */
 struct ContactInfoVisitor : public SiconosVisitor
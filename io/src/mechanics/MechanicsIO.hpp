@@ -26,6 +26,8 @@
 #include <SiconosPointers.hpp>
 #include <SiconosFwd.hpp>
 
+#include <vector>
+
 class MechanicsIO
 {
 protected:
@@ -36,6 +38,10 @@ protected:
   template<typename T, typename G>
   SP::SiconosVector visitAllVerticesForDouble(const G& graph) const;
 
+  template<typename T, typename G>
+  unsigned int visitAllVerticesForRows(const G& graph, double time,
+                                       std::vector<double>& rows) const;
+
 public:
   /** default constructor
    */
@@ -93,6 +99,38 @@ public:
    * \return a matrix where the columns are domain, id
   */
   SP::SimpleMatrix domains(const NonSmoothDynamicalSystem& nsds) const;
+
+  /** append the rows of positions(), preceded by the time, to a row-major
+   * buffer, without building the intermediate matrix.
+   * \param nsds current nonsmooth dynamical system
+   * \param time value of the first column
+   * \param rows the buffer, rows time, id, x, y, z, qw, qx, qy, qz are appended
+   * \return the number of columns of the appended rows, 0 if none
+   */
+  unsigned int appendPositions(const NonSmoothDynamicalSystem& nsds, double time,
+                               std::vector<double>& rows) const;
+
+  /** append the rows of velocities(), preceded by the time, to a row-major
+   * buffer, without building the intermediate matrix.
+   * \param nsds current nonsmooth dynamical system
+   * \param time value of the first column
+   * \param rows the buffer, rows time, id, xdot, ydot, zdot, ox, oy, oz are appended
+   * \return the number of columns of the appended rows, 0 if none
+   */
+  unsigned int appendVelocities(const NonSmoothDynamicalSystem& nsds, double time,
+                                std::vector<double>& rows) const;
+
+  /** append the rows of contactPoints(), preceded by the time, to a row-major
+   * buffer, without building the intermediate matrix.
+   * \param nsds current nonsmooth dynamical system
+   * \param time value of the first column
+   * \param rows the buffer
+   * \param index_set the index set number.
+   * \return the number of columns of the appended rows, 0 if none
+   */
+  unsigned int appendContactPoints(const NonSmoothDynamicalSystem& nsds, double time,
+                                   std::vector<double>& rows,
+                                   unsigned int index_set=1) const;
 };
 
 
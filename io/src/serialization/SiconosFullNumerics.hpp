@@ -114,6 +114,7 @@ void siconos_io(Archive& ar, SparseBlockStructuredMatrix& v, unsigned int versio
   if (Archive::is_loading::value)
   {
     v.block = (double **) malloc(v.nbblocks * sizeof(double *));
+    v.block_data = NULL;
     v.blocksize1 = (unsigned int *) malloc (v.blocknumber1* sizeof(unsigned int));
     v.blocksize0 = (unsigned int *) malloc (v.blocknumber0* sizeof(unsigned int));
     SERIALIZE_C_ARRAY(v.blocknumber1, v, blocksize1, ar);
@@ -0,0 +1,166 @@
+#include "MechanicsHDF5WriterTest.hpp"
+
+#include "MechanicsIO.hpp"
+#include "MechanicsHDF5Writer.hpp"
+#include "SiconosKernel.hpp"
+#include "RigidBodyDS.hpp"
+#include "ContactR.hpp"
+
+#include <hdf5.h>
+
+#include <cstdio>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MechanicsHDF5WriterTest);
+
+static const char* filename = "MechanicsHDF5WriterTest.hdf5";
+
+void MechanicsHDF5WriterTest::setUp()
+{
+  std::remove(filename);
+}
+
+void MechanicsHDF5WriterTest::tearDown()
+{
+  std::remove(filename);
+}
+
+/* two spheres of radius 1 stacked on the plane z = 0 and sliding on it,
+ * so that both contacts are active at each step */
+static SP::TimeStepping stack_of_spheres(SP::NonSmoothDynamicalSystem nsds)
+{
+  SP::NonSmoothLaw nslaw(new NewtonImpactFrictionNSL(0., 0., 0.5, 3));
+  SP::RigidBodyDS spheres[2];
+  for(unsigned int i = 0; i < 2; ++i)
+  {
+    SP::SiconosVector q(new SiconosVector(7));
+    SP::SiconosVector v(new SiconosVector(6));
+    (*q)(2) = 1. + 2. * i;
+    (*q)(3) = 1.;
+    (*v)(0) = 1.;
+    SP::SimpleMatrix I(new SimpleMatrix(3, 3));
+    I->eye();
+    *I *= 0.4;
+    spheres[i].reset(new RigidBodyDS(q, v, 1., I));
+    SP::SiconosVector weight(new SiconosVector(3));
+    (*weight)(2) = -9.81;
+    spheres[i]->setFExtPtr(weight);
+    nsds->insertDynamicalSystem(spheres[i]);
+  }
+
+  // the contact points are given in the absolute frame and kept fixed,
+  // with a small penetration
+  SP::ContactR ground(new ContactR());
+  (*ground->pc1())(2) = -1e-3;
+  (*ground->nc())(2) = 1.;
+  nsds->link(SP::Interaction(new Interaction(nslaw, ground)), spheres[0]);
+  SP::ContactR contact(new ContactR());
+  (*contact->pc1())(2) = 2. - 1e-3;
+  (*contact->pc2())(2) = 2.;
+  (*contact->nc())(2) = 1.;
+  nsds->link(SP::Interaction(new Interaction(nslaw, contact)), spheres[1], spheres[0]);
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(0., 1e-3));
+  SP::OneStepIntegrator osi(new MoreauJeanOSI(0.5));
+  SP::OneStepNSProblem osnspb(new FrictionContact(3));
+  return SP::TimeStepping(new TimeStepping(nsds, td, osi, osnspb));
+}
+
+/* append the rows of a matrix of MechanicsIO, with the time in front */
+static void append_rows(const SimpleMatrix& m, double time, std::vector<double>& rows)
+{
+  for(unsigned int i = 0; i < m.size(0); ++i)
+  {
+    rows.push_back(time);
+    for(unsigned int j = 0; j < m.size(1); ++j)
+      rows.push_back(m(i, j));
+  }
+}
+
+/* run steps steps, write them with writer and keep the rows of
+ * MechanicsIO in the order of the datasets */
+static void run(TimeStepping& simulation, MechanicsHDF5Writer& writer,
+                unsigned int steps, std::vector<double> expected[3])
+{
+  MechanicsIO io;
+  const NonSmoothDynamicalSystem& nsds = *simulation.nonSmoothDynamicalSystem();
+  for(unsigned int k = 0; k < steps; ++k)
+  {
+    simulation.computeOneStep();
+    double time = simulation.nextTime();
+    writer.output(nsds, time);
+    append_rows(*io.positions(nsds), time, expected[0]);
+    append_rows(*io.velocities(nsds), time, expected[1]);
+    append_rows(*io.contactPoints(nsds), time, expected[2]);
+    simulation.nextStep();
+  }
+}
+
+/* the dimensions and values of data/name */
+static std::vector<double> read_dataset(hid_t file, const char* name, hsize_t dims[2])
+{
+  std::vector<double> values;
+  dims[0] = dims[1] = 0;
+  hid_t dataset = H5Dopen2(file, name, H5P_DEFAULT);
+  if(dataset < 0) return values;
+  hid_t space = H5Dget_space(dataset);
+  if(H5Sget_simple_extent_ndims(space) == 2)
+  {
+    H5Sget_simple_extent_dims(space, dims, NULL);
+    values.resize(dims[0] * dims[1]);
+    H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+  }
+  H5Sclose(space);
+  H5Dclose(dataset);
+  return values;
+}
+
+static void check_datasets(const std::vector<double> expected[3])
+{
+  static const char* names[] = { "data/dynamic", "data/velocities", "data/cf" };
+  static const hsize_t columns[] = { 9, 8, 26 };
+  hid_t file = H5Fopen(filename, H5F_ACC_RDONLY, H5P_DEFAULT);
+  CPPUNIT_ASSERT_MESSAGE("file", file >= 0);
+  for(unsigned int d = 0; d < 3; ++d)
+  {
+    hsize_t dims[2];
+    std::vector<double> values = read_dataset(file, names[d], dims);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(names[d], columns[d], dims[1]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(names[d], expected[d].size() / columns[d], dims[0]);
+    CPPUNIT_ASSERT_MESSAGE(names[d], values == expected[d]);
+  }
+  H5Fclose(file);
+}
+
+void MechanicsHDF5WriterTest::t1()
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  SP::TimeStepping simulation = stack_of_spheres(nsds);
+  std::vector<double> expected[3];
+  {
+    // 7 steps: two flushes by output() and the last step by the destructor
+    MechanicsHDF5Writer writer(filename, 3);
+    run(*simulation, writer, 7, expected);
+    writer.wait();
+  }
+  // two spheres and two contacts at each step
+  CPPUNIT_ASSERT_EQUAL(7u * 2u * 9u, (unsigned int)expected[0].size());
+  CPPUNIT_ASSERT_EQUAL(7u * 2u * 26u, (unsigned int)expected[2].size());
+  check_datasets(expected);
+}
+
+void MechanicsHDF5WriterTest::t2()
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  SP::TimeStepping simulation = stack_of_spheres(nsds);
+  std::vector<double> expected[3];
+  {
+    MechanicsHDF5Writer writer(filename, 2);
+    run(*simulation, writer, 4, expected);
+  }
+  {
+    MechanicsHDF5Writer writer(filename, 2);
+    run(*simulation, writer, 3, expected);
+  }
+  check_datasets(expected);
+}
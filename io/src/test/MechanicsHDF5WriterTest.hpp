@@ -0,0 +1,25 @@
+#ifndef MECHANICS_HDF5_WRITER_TEST_HPP
+#define MECHANICS_HDF5_WRITER_TEST_HPP
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class MechanicsHDF5WriterTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(MechanicsHDF5WriterTest);
+
+  CPPUNIT_TEST(t1);
+  CPPUNIT_TEST(t2);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  // datasets written by several flushes, compared with MechanicsIO
+  void t1();
+  // an existing file is extended
+  void t2();
+
+public:
+  void setUp();
+  void tearDown();
+};
+
+#endif
@@ -31,3 +31,9 @@
 #include <MechanicsIO.hpp>
 %}
 #endif
+#if defined(WITH_MECHANICS) && defined(WITH_HDF5)
+%{
+#include <MechanicsHDF5Writer.hpp>
+%}
+%include <MechanicsHDF5Writer.hpp>
+#endif
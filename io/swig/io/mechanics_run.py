@@ -2351,6 +2351,9 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
 
     def output_results(self,with_timer=False):
 
+        # The rows are written with h5py, not with the C++
+        # MechanicsHDF5Writer: the file is held open by h5py, which also
+        # writes the other groups below at each step.
         self.log(self.output_static_objects, with_timer)()
 
         self.log(self.output_dynamic_objects, with_timer)()
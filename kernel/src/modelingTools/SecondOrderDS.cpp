@@ -22,7 +22,10 @@
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES
 #include "siconos_debug.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 void SecondOrderDS::setBoundaryConditions(SP::BoundaryCondition newbd)
 {
@@ -33,3 +36,41 @@ void SecondOrderDS::setBoundaryConditions(SP::BoundaryCondition newbd)
   _boundaryConditions = newbd;
   _reactionToBoundaryConditions.reset(new SiconosVector(_boundaryConditions->velocityIndices()->size()));
 };
+
+void SecondOrderDS::sleep(double time)
+{
+  velocity()->zero();
+  computeForces(time, q(), velocity());
+  if(forces())
+  {
+    if(!_sleepingForces)
+      _sleepingForces.reset(new SiconosVector(*forces()));
+    else
+      *_sleepingForces = *forces();
+  }
+  _sleeping = true;
+}
+
+void SecondOrderDS::wakeUp()
+{
+  _sleeping = false;
+  _restingSteps = 0;
+}
+
+bool SecondOrderDS::forcesChangedSinceSleep(double time)
+{
+  computeForces(time, q(), velocity());
+  if(!forces() || !_sleepingForces)
+    return forces() != _sleepingForces;
+
+  // relative comparison, the forces are computed again with the same
+  // state and may only differ by rounding errors
+  const SiconosVector& f = *forces();
+  const SiconosVector& f0 = *_sleepingForces;
+  double tol = 100 * std::numeric_limits<double>::epsilon()
+               * std::max(1., f0.normInf());
+  for(unsigned int i = 0; i < f.size(); ++i)
+    if(std::fabs(f(i) - f0(i)) > tol)
+      return true;
+  return false;
+}
@@ -148,6 +148,18 @@ protected:
   /** Reaction to an applied  boundary condition */
   SP::SiconosVector _reactionToBoundaryConditions;
 
+  /** true if the system has been put to sleep by the simulation (see
+   *  Simulation::setSleeping()): it is not integrated, and its
+   *  interactions are kept out of the index sets */
+  bool _sleeping = false;
+
+  /** number of consecutive steps with a velocity under the sleeping
+   *  threshold of the simulation */
+  unsigned int _restingSteps = 0;
+
+  /** forces when the system was put to sleep */
+  SP::SiconosVector _sleepingForces;
+
   // /** Default constructor */
   SecondOrderDS() : DynamicalSystem(Type::SecondOrderDS){};
 
@@ -409,6 +421,47 @@ public:
     return _reactionToBoundaryConditions;
   };
 
+  /** \return true if the system has been put to sleep
+   */
+  inline bool isSleeping() const
+  {
+    return _sleeping;
+  };
+
+  /** \return the number of consecutive steps with a velocity under the
+   *  sleeping threshold of the simulation
+   */
+  inline unsigned int restingSteps() const
+  {
+    return _restingSteps;
+  };
+
+  /** \param n the number of consecutive steps at rest
+   */
+  inline void setRestingSteps(unsigned int n)
+  {
+    _restingSteps = n;
+  };
+
+  /** put the system to sleep: its velocity is set to zero and the forces
+   *  at this velocity are saved, see forcesChangedSinceSleep()
+   *
+   *  \param time the current time
+   */
+  void sleep(double time);
+
+  /** wake the system up, after sleep()
+   */
+  void wakeUp();
+
+  /** compute the forces of a sleeping system
+   *
+   *  \param time the current time
+   *  \return true if they are not the ones saved by sleep(), e.g. if
+   *  an external force has been changed
+   */
+  bool forcesChangedSinceSleep(double time);
+
   /** 
       Allocate memory for the lu factorization of the mass of the system.
       Useful for some integrators with system inversion involving the mass
@@ -20,6 +20,7 @@
 
 #include "BlockCSRMatrix.hpp"
 #include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <algorithm>
 #include "NonSmoothLaw.hpp"
 #include "Interaction.hpp"
 
@@ -294,6 +295,31 @@ void BlockCSRMatrix::convert()
     free(_sparseBlockStructuredMatrix->diagonal_blocks);
     _sparseBlockStructuredMatrix->diagonal_blocks = nullptr;
   }
+
+  // Blocks of the same square size (the contacts of a frictional
+  // problem) are copied in a contiguous array, in the order of the
+  // sweeps of the numerics solvers. The copy is done at each conversion,
+  // since the blocks of the interactions are updated in place.
+  _sparseBlockStructuredMatrix->block_data = nullptr;
+  unsigned int size = _nr ? (*_diagsize0)[0] : 0;
+  bool uniform = size > 0;
+  for(unsigned int i = 0; uniform && i < _nr; ++i)
+    uniform = (*_diagsize0)[i] == (i + 1) * size && (*_diagsize1)[i] == (i + 1) * size;
+  if(uniform)
+  {
+    size_t nbblocks = _sparseBlockStructuredMatrix->nbblocks;
+    size_t length = size * size;
+    _packedBlocks.resize(nbblocks * length);
+    _packedBlockPointers.resize(nbblocks);
+    double ** blocks = _blockCSR->value_data().begin();
+    for(size_t i = 0; i < nbblocks; ++i)
+    {
+      _packedBlockPointers[i] = &_packedBlocks[i * length];
+      std::copy(blocks[i], blocks[i] + length, _packedBlockPointers[i]);
+    }
+    _sparseBlockStructuredMatrix->block = _packedBlockPointers.data();
+    _sparseBlockStructuredMatrix->block_data = _packedBlocks.data();
+  }
   //   // Loop through the non-null blocks
   //   for (SpMatIt1 i1 = _blockCSR->begin1(); i1 != _blockCSR->end1(); ++i1)
   //     {
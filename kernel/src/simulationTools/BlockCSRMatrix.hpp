@@ -27,6 +27,7 @@ Definition of a compressed row sparse block matrix of SiconosMatrix*
 #include "SimulationTypeDef.hpp"
 
 #include <boost/numeric/ublas/fwd.hpp> // Boost forward declarations
+#include <vector>
 
 /* with signed int typedef  boost::numeric::ublas::compressed_matrix<double*>
  * CompressedRowMat; */
@@ -132,6 +133,13 @@ private:
   /** List of non null blocks positions (in col) */
   SP::IndexInt colPos;
 
+  /** Copy of the blocks in a single contiguous array, when they all
+      have the same square size (see convert()) */
+  std::vector<double> _packedBlocks;
+
+  /** Pointers to the blocks in _packedBlocks */
+  std::vector<double *> _packedBlockPointers;
+
   /** Private copy constructor => no copy nor pass by value */
   BlockCSRMatrix(const BlockCSRMatrix &);
 
@@ -236,7 +244,11 @@ public:
    */
   void fillH(InteractionsGraph &indexSet);
 
-  /** fill the numerics structure _sparseBlockStructuredMatrix using _blockCSR
+  /** fill the numerics structure _sparseBlockStructuredMatrix using
+   *  _blockCSR. If all the blocks have the same square size, they are
+   *  copied in a single contiguous array (packed storage, see
+   *  SBM_pack_blocks()), otherwise the numerics structure links the
+   *  blocks of the interactions.
    */
   void convert();
 
@@ -25,6 +25,8 @@
 #include "NonSmoothDrivers.h" // from numerics, for fcX_driver
 #include <fc2d_Solvers.h>
 #include <fc3d_Solvers.h>
+#include <NumericsMatrix.h>
+#include <numeric>
 
 using namespace RELATION;
 
@@ -146,7 +148,189 @@ int FrictionContact::solve(SP::FrictionContactProblem problem)
 }
 
 
+/* The options of an island share the callback of the source options,
+ * which they only read, but not its solver data and parameters: they are
+ * owned by the solver of each island, possibly run in another thread. */
+static void unlink_solver_data(SolverOptions& island)
+{
+  island.solverData = nullptr;
+  island.solverParameters = nullptr;
+  for(size_t i = 0; i < island.numberOfInternalSolvers; ++i)
+    unlink_solver_data(*island.internalSolvers[i]);
+}
+
+/* the callback is owned by the source options */
+static void unlink_callback(SolverOptions& island)
+{
+  island.callback = nullptr;
+  for(size_t i = 0; i < island.numberOfInternalSolvers; ++i)
+    unlink_callback(*island.internalSolvers[i]);
+}
+
+static void island_options_delete(SolverOptions* island)
+{
+  unlink_callback(*island);
+  solver_options_delete(island);
+  free(island);
+}
+
+/* copy the parameters of source into the options of an island, if they
+ * are options of the same solvers. The work arrays and solver data of the
+ * island are kept.
+ * \return false if the solvers differ */
+static bool update_parameters(SolverOptions& island, const SolverOptions& source)
+{
+  if(island.solverId != source.solverId || island.iSize != source.iSize
+      || island.dSize != source.dSize
+      || island.numberOfInternalSolvers != source.numberOfInternalSolvers)
+    return false;
+  for(size_t i = 0; i < island.numberOfInternalSolvers; ++i)
+    if(!update_parameters(*island.internalSolvers[i], *source.internalSolvers[i]))
+      return false;
+  std::copy(source.iparam, source.iparam + source.iSize, island.iparam);
+  std::copy(source.dparam, source.dparam + source.dSize, island.dparam);
+  island.filterOn = source.filterOn;
+  island.callback = source.callback;
+  return true;
+}
+
+int FrictionContact::solveIslands()
+{
+  SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  unsigned int dim = _contactProblemDim;
+  unsigned int nc = _sizeOutput / dim;
+
+  // Connected components of the index set (union-find on the contacts,
+  // numbered by their position in M): two interactions sharing a
+  // dynamical system are linked by an edge.
+  std::vector<unsigned int> root(nc);
+  std::iota(root.begin(), root.end(), 0);
+  auto find = [&root](unsigned int c)
+  {
+    while(root[c] != c)
+      c = root[c] = root[root[c]];
+    return c;
+  };
+  InteractionsGraph::EIterator ei, eiend;
+  for(std::tie(ei, eiend) = indexSet->edges(); ei != eiend; ++ei)
+  {
+    unsigned int c1 = find(indexSet->properties(indexSet->source(*ei)).absolute_position / dim);
+    unsigned int c2 = find(indexSet->properties(indexSet->target(*ei)).absolute_position / dim);
+    if(c1 < c2)
+      root[c2] = c1;
+    else if(c2 < c1)
+      root[c1] = c2;
+  }
+
+  // contacts of each island, in increasing order
+  std::vector<std::vector<unsigned int>> islands;
+  std::vector<int> island(nc, -1);
+  for(unsigned int c = 0; c < nc; ++c)
+  {
+    unsigned int r = find(c);
+    if(island[r] < 0)
+    {
+      island[r] = islands.size();
+      islands.emplace_back();
+    }
+    islands[island[r]].push_back(c);
+  }
+
+  if(islands.size() == 1)
+    return solve();
+
+  // one problem per island, warm-started with the current z and w
+  int n = islands.size();
+  NumericsMatrix* M = &*_M->numericsMatrix();
+  double* q = _q->getArray();
+  double* z = _z->getArray();
+  double* w = _w->getArray();
+  _islandProblems.resize(n);
+  _islandOptions.resize(n);
+  _islandReactions.resize(n);
+  _islandVelocities.resize(n);
+  std::vector<FrictionContactProblem*> problems(n);
+  std::vector<SolverOptions*> options(n);
+  std::vector<double*> reactions(n), velocities(n);
+  std::vector<int> infos(n);
+  for(int k = 0; k < n; ++k)
+  {
+    const std::vector<unsigned int>& contacts = islands[k];
+    unsigned int size = contacts.size() * dim;
+    SP::FrictionContactProblem& problem = _islandProblems[k];
+    if(!problem || problem->numberOfContacts != (int)contacts.size())
+    {
+      problem.reset(frictionContactProblem_new_with_data(
+                      dim, contacts.size(), nullptr,
+                      (double*)malloc(size * sizeof(double)),
+                      (double*)malloc(contacts.size() * sizeof(double))),
+                    frictionContactProblem_free);
+    }
+    else
+    {
+      NM_clear(problem->M);
+      free(problem->M);
+    }
+    problem->M = NM_extract_principal_submatrix(M, dim, contacts.size(), contacts.data());
+
+    _islandReactions[k].resize(size);
+    _islandVelocities[k].resize(size);
+    for(unsigned int i = 0; i < contacts.size(); ++i)
+    {
+      std::copy(q + contacts[i] * dim, q + (contacts[i] + 1) * dim, problem->q + i * dim);
+      std::copy(z + contacts[i] * dim, z + (contacts[i] + 1) * dim, &_islandReactions[k][i * dim]);
+      std::copy(w + contacts[i] * dim, w + (contacts[i] + 1) * dim, &_islandVelocities[k][i * dim]);
+      problem->mu[i] = (*_mu)[contacts[i]];
+    }
+
+    SP::SolverOptions& islandOptions = _islandOptions[k];
+    if(!islandOptions || !update_parameters(*islandOptions, *_numerics_solver_options))
+    {
+      islandOptions.reset(solver_options_copy(&*_numerics_solver_options),
+                          island_options_delete);
+      unlink_solver_data(*islandOptions);
+    }
+
+    problems[k] = &*problem;
+    options[k] = &*islandOptions;
+    reactions[k] = _islandReactions[k].data();
+    velocities[k] = _islandVelocities[k].data();
+  }
+
+  int info = 0;
+  if(_frictionContact_driver == &fc3d_driver)
+    info = fc3d_driver_batch(n, problems.data(), reactions.data(), velocities.data(),
+                             options.data(), infos.data(), nullptr);
+  else
+  {
+    for(int k = 0; k < n; ++k)
+    {
+      infos[k] = (*_frictionContact_driver)(problems[k], reactions[k], velocities[k], options[k]);
+      if(infos[k])
+        info++;
+    }
+  }
 
+  // scatter the results, the reported iterations and error are the worst
+  // ones over the islands
+  int iter = 0;
+  double error = 0.;
+  for(int k = 0; k < n; ++k)
+  {
+    const std::vector<unsigned int>& contacts = islands[k];
+    for(unsigned int i = 0; i < contacts.size(); ++i)
+    {
+      std::copy(reactions[k] + i * dim, reactions[k] + (i + 1) * dim, z + contacts[i] * dim);
+      std::copy(velocities[k] + i * dim, velocities[k] + (i + 1) * dim, w + contacts[i] * dim);
+    }
+    iter = std::max(iter, options[k]->iparam[SICONOS_IPARAM_ITER_DONE]);
+    error = std::max(error, options[k]->dparam[SICONOS_DPARAM_RESIDU]);
+  }
+  _numerics_solver_options->iparam[SICONOS_IPARAM_ITER_DONE] = iter;
+  _numerics_solver_options->dparam[SICONOS_DPARAM_RESIDU] = error;
+
+  return info;
+}
 
 bool FrictionContact::checkCompatibleNSLaw(NonSmoothLaw& nslaw)
 {
@@ -197,7 +381,10 @@ int FrictionContact::compute(double time)
   if(_sizeOutput != 0)
   {
     // Call Numerics Driver for FrictionContact
-    info = solve();
+    if(_islandDecomposition)
+      info = solveIslands();
+    else
+      info = solve();
     postCompute();
   }
 
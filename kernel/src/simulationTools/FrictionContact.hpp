@@ -84,6 +84,25 @@ protected:
 
   FrictionContactProblem _numerics_problem;
 
+  /** if true, the interactions are split into islands (connected
+   *  components of the index set) solved as independent problems */
+  bool _islandDecomposition = false;
+
+  /** problems, solver options and unknowns of the islands, kept from one
+   *  call of solveIslands to the next. The buffers and options of an
+   *  island are reused while its number of contacts is unchanged. */
+  std::vector<SP::FrictionContactProblem> _islandProblems;
+  std::vector<SP::SolverOptions> _islandOptions;
+  std::vector<std::vector<double>> _islandReactions;
+  std::vector<std::vector<double>> _islandVelocities;
+
+  /** solve one friction contact problem per island of the index set and
+   *  scatter the results into z and w
+   *
+   *  \return the number of islands for which the solver failed
+   */
+  int solveIslands();
+
 public:
   /** constructor (solver id and dimension)
    *
@@ -145,6 +164,21 @@ public:
     _frictionContact_driver = newFunction;
   };
 
+  /** split the problem into islands before solving it. Two interactions
+   *  are in the same island if they are connected (through the dynamical
+   *  systems) in the index set. Each island is solved as an independent
+   *  problem with a copy of the solver options, so that a hard cluster of
+   *  contacts does not slow down the convergence of the other ones. In 3D,
+   *  the islands are solved in parallel (see fc3d_driver_batch()).
+   *
+   *  \param val true to enable the decomposition (default: false)
+   */
+  inline void setIslandDecomposition(bool val) { _islandDecomposition = val; }
+
+  /** \return true if the problem is split into islands before solving it
+   */
+  inline bool islandDecomposition() const { return _islandDecomposition; }
+
   // --- Others functions ---
 
   /**
@@ -103,6 +103,14 @@ public:
   void computeDiagonalInteractionBlock(
       const InteractionsGraph::VDescriptor &vd) override;
 
+  /** \return false: computeDiagonalInteractionBlock adds the
+   *  subproblems to the numerics problem in the order of the interactions
+   */
+  bool hasThreadSafeInteractionBlocks() const override
+  {
+    return false;
+  }
+
   /** print the data to the screen */
   void display() const override;
 
@@ -44,7 +44,11 @@
 #include "OSNSMatrix.hpp"
 
 #include "Tools.hpp"
+#include <SiconosConfig.h>
 #include <chrono>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace RELATION;
 // #define DEBUG_NOCOLOR
@@ -52,6 +56,102 @@ using namespace RELATION;
 //#define DEBUG_MESSAGES
 #include "siconos_debug.h"
 //#define WITH_TIMER
+
+// Solve W X = B with the OSI matrix W of a ds. When the blocks are
+// computed in parallel, W has been factorized beforehand (see
+// OneStepNSProblem::_factorizeOSIMatrices) and the solves with its dense
+// factors only read it; the sparse factors share a workspace, so the
+// solves with a sparse W are serialized.
+static void solveWithOSIMatrix(SiconosMatrix& W, SiconosMatrix& B)
+{
+#ifdef WITH_OPENMP
+  if(omp_in_parallel() && W.num() != Siconos::DENSE)
+  {
+    #pragma omp critical(LinearOSNS_solveWithOSIMatrix)
+    W.Solve(B);
+    return;
+  }
+#endif
+  W.Solve(B);
+}
+
+// Solve W X = B in place, B being an array of nrhs columns, with the
+// factors of a dense OSI matrix W (same choice of factorization as
+// SimpleMatrix::Solve).
+static void solveWithOSIMatrix(SimpleMatrix& W, double* B, unsigned int nrhs)
+{
+  if(!W.isFactorized())
+    W.Factorize();
+  int info;
+  if(W.isSymmetric() && W.isPositiveDefinite())
+    info = NM_Cholesky_solve(W.numericsMatrix(), B, nrhs);
+  else
+    info = NM_LU_solve(W.numericsMatrix(), B, nrhs);
+  if(info != 0)
+    THROW_EXCEPTION("LinearOSNS: solve with the OSI matrix failed.");
+}
+
+// Diagonal block of a contact on a ds of dimension N, for a nonsmooth
+// law of size M: block += H W^{-1} H^T, with H the M x N part of the
+// relation jacobian starting at column pos. The sizes are known at
+// compile time, the products are unrolled by the compiler and the
+// intermediate W^{-1} H^T stays on the stack.
+template<unsigned int M, unsigned int N>
+static void smallDiagonalBlock(const SimpleMatrix& H, unsigned int pos,
+                               SimpleMatrix& W, SimpleMatrix& block)
+{
+  const unsigned int ldH = H.size(0);
+  const double* h = H.getArray() + pos * ldH;
+  double* b = block.getArray();
+
+  // X = H^T, then X = W^{-1} H^T
+  double X[N * M];
+  for(unsigned int i = 0; i < M; ++i)
+    for(unsigned int j = 0; j < N; ++j)
+      X[j + i * N] = h[i + j * ldH];
+  solveWithOSIMatrix(W, X, M);
+
+  // block += H X
+  for(unsigned int c = 0; c < M; ++c)
+    for(unsigned int r = 0; r < M; ++r)
+    {
+      double s = 0.;
+      for(unsigned int k = 0; k < N; ++k)
+        s += h[r + k * ldH] * X[k + c * N];
+      b[r + c * M] += s;
+    }
+}
+
+// Try the fixed-size kernels for the contact shapes of Lagrangian and
+// NewtonEuler systems (nonsmooth law of size 1, 2 or 3, ds of dimension
+// 3 or 6), with dense matrices. Returns false if the shape or the
+// storage is not handled, the block must then be computed by the
+// generic path.
+static bool smallDiagonalBlock(unsigned int nslawSize, unsigned int sizeDS,
+                               const SiconosMatrix& H, unsigned int pos,
+                               SiconosMatrix& W, SiconosMatrix& block)
+{
+  if(H.num() != Siconos::DENSE || W.num() != Siconos::DENSE || block.num() != Siconos::DENSE)
+    return false;
+  if(H.size(0) < nslawSize || H.size(1) < pos + sizeDS
+      || W.size(0) != sizeDS || block.size(0) != nslawSize)
+    return false;
+
+  const SimpleMatrix& h = static_cast<const SimpleMatrix&>(H);
+  SimpleMatrix& w = static_cast<SimpleMatrix&>(W);
+  SimpleMatrix& b = static_cast<SimpleMatrix&>(block);
+  switch(nslawSize * 10 + sizeDS)
+  {
+  case 13: smallDiagonalBlock<1, 3>(h, pos, w, b); return true;
+  case 23: smallDiagonalBlock<2, 3>(h, pos, w, b); return true;
+  case 33: smallDiagonalBlock<3, 3>(h, pos, w, b); return true;
+  case 16: smallDiagonalBlock<1, 6>(h, pos, w, b); return true;
+  case 26: smallDiagonalBlock<2, 6>(h, pos, w, b); return true;
+  case 36: smallDiagonalBlock<3, 6>(h, pos, w, b); return true;
+  default: return false;
+  }
+}
+
 void LinearOSNS::initVectorsMemory()
 {
   // Memory allocation for _w, M, z and q.
@@ -449,6 +549,28 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
     OSI::TYPES osiType = osi.getType();
     unsigned int sizeDS = ds->dimension();
 
+    // common contact shapes: H W^{-1} H^T with the fixed-size kernels,
+    // without copying H into leftInteractionBlock
+    if((relationType == Lagrangian || relationType == NewtonEuler)
+        && relationSubType != CompliantLinearTIR
+        && osiType != OSI::MOREAUJEANBILBAOOSI
+        && Type::value(*ds) != Type::LagrangianLinearDiagonalDS
+        && !std::static_pointer_cast<SecondOrderDS>(ds)->boundaryConditions())
+    {
+      SP::SiconosMatrix H;
+      if(relationType == Lagrangian)
+        H = std::static_pointer_cast<LagrangianR>(inter->relation())->jachq();
+      else
+        H = std::static_pointer_cast<NewtonEulerR>(inter->relation())->jachqT();
+      if(H && smallDiagonalBlock(nslawSize, sizeDS, *H, pos,
+                                 *getOSIMatrix(osi, ds), *currentInteractionBlock))
+      {
+        DEBUG_EXPR(currentInteractionBlock->display(););
+        pos = pos2;
+        continue;
+      }
+    }
+
     // get _interactionBlocks corresponding to the current DS
     // These _interactionBlocks depends on the relation type.
     leftInteractionBlock = inter->getLeftInteractionBlockForDS(pos, nslawSize, sizeDS);
@@ -480,7 +602,7 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
         // centralInteractionBlock contains a lu-factorized matrix and we solve
         // centralInteractionBlock * X = rightInteractionBlock with PLU
         SP::SiconosMatrix centralInteractionBlock = getOSIMatrix(osi, ds);
-        centralInteractionBlock->Solve(*rightInteractionBlock);
+        solveWithOSIMatrix(*centralInteractionBlock, *rightInteractionBlock);
         VectorOfSMatrices& workMInter = *indexSet->properties(vd).workMatrices;
         static_cast<EulerMoreauOSI&>(osi).computeKhat(*inter, *rightInteractionBlock,
             workMInter, h);
@@ -544,7 +666,7 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
         work->trans();
         SP::SiconosMatrix centralInteractionBlock = getOSIMatrix(osi, ds);
         DEBUG_EXPR_WE(std::cout <<  std::boolalpha << " centralInteractionBlock->isFactorized() = "<< centralInteractionBlock->isFactorized() << std::endl;);
-        centralInteractionBlock->Solve(*work);
+        solveWithOSIMatrix(*centralInteractionBlock, *work);
         //*currentInteractionBlock +=  *leftInteractionBlock ** work;
         DEBUG_EXPR(work->display(););
         prod(*leftInteractionBlock, *work, *currentInteractionBlock, false);
@@ -681,7 +803,7 @@ void LinearOSNS::computeInteractionBlock(const InteractionsGraph::EDescriptor& e
     // centralInteractionBlock contains a lu-factorized matrix and we solve
     // centralInteractionBlock * X = rightInteractionBlock with PLU
     SP::SiconosMatrix centralInteractionBlock = getOSIMatrix(osi, ds);
-    centralInteractionBlock->Solve(*rightInteractionBlock);
+    solveWithOSIMatrix(*centralInteractionBlock, *rightInteractionBlock);
 
     //      integration of r with theta method removed
     //      *currentInteractionBlock += h *Theta[*itDS]* *leftInteractionBlock * (*rightInteractionBlock); //left = C, right = W.B
@@ -742,7 +864,7 @@ void LinearOSNS::computeInteractionBlock(const InteractionsGraph::EDescriptor& e
       // size checking inside the getBlock function, a
       // getRight call will fail.
       SP::SimpleMatrix centralInteractionBlock = getOSIMatrix(osi, ds);
-      centralInteractionBlock->Solve(*rightInteractionBlock);
+      solveWithOSIMatrix(*centralInteractionBlock, *rightInteractionBlock);
       //*currentInteractionBlock +=  *leftInteractionBlock ** work;
       prod(*leftInteractionBlock, *rightInteractionBlock, *currentInteractionBlock, false);
     }
@@ -770,6 +892,17 @@ void LinearOSNS::computeqBlock(InteractionsGraph::VDescriptor& vertex_inter, uns
   DEBUG_END("LinearOSNS::computeqBlock(SP::Interaction inter, unsigned int pos)\n");
 }
 
+/* the free output of these relations writes in the relation
+ * (LagrangianRheonomousR::computehDot) or in the velocity of the ds
+ * (LagrangianCompliantLinearTIR with MoreauJeanOSI), which may be shared
+ * with other interactions */
+static bool hasThreadSafeFreeOutput(const Interaction& inter)
+{
+  RELATION::SUBTYPES subType = inter.relation()->getSubType();
+  return !(inter.relation()->getType() == RELATION::Lagrangian
+           && (subType == RELATION::RheonomousR || subType == RELATION::CompliantLinearTIR));
+}
+
 void LinearOSNS::computeq(double time)
 {
   DEBUG_BEGIN("void LinearOSNS::computeq(double time)\n");
@@ -782,14 +915,27 @@ void LinearOSNS::computeq(double time)
   // === Loop through "active" Interactions (ie present in
   // indexSets[level]) ===
 
-  unsigned int pos = 0;
-  InteractionsGraph::VIterator ui, uiend;
-  for(std::tie(ui, uiend) = indexSet->vertices(); ui != uiend; ++ui)
+  // The blocks of q are written at distinct positions, they are
+  // computed concurrently if _parallelAssembly is set, except the ones
+  // of the relations whose free output is not thread-safe, computed
+  // afterwards.
+  const InteractionsGraph::FlatGraph& interactions = indexSet->flat();
+  bool parallel = _parallelAssembly && hasThreadSafeInteractionBlocks();
+  auto computeq_k = [&](size_t k, bool concurrent)
   {
+    if(parallel && concurrent != hasThreadSafeFreeOutput(*interactions.bundles[k]))
+      return;
     // Compute q, this depends on the type of non smooth problem, on
     // the relation type and on the non smooth law
-    pos = indexSet->properties(*ui).absolute_position;
-    computeqBlock(*ui, pos); // free output is saved in y
+    InteractionsGraph::VDescriptor vertex_inter = interactions.vertices[k];
+    unsigned int pos = interactions.properties[k]->absolute_position;
+    computeqBlock(vertex_inter, pos); // free output is saved in y
+  };
+  _forEach(interactions.size(), [&](size_t k) { computeq_k(k, true); }, parallel);
+  if(parallel)
+  {
+    for(size_t k = 0; k < interactions.size(); ++k)
+      computeq_k(k, false);
   }
   DEBUG_END("void LinearOSNS::computeq(double time)\n");
 }
@@ -860,6 +1006,8 @@ void LinearOSNS::computeM()
 	  OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
 	  double theta =(static_cast<MoreauJeanOSI&>(osi)).theta();
 	  NM_scal(theta,&*_M->numericsMatrix());
+	  // the interaction blocks linked in M may have been scaled too
+	  resetInteractionBlocks();
 	}
       break;
     }
@@ -947,13 +1095,13 @@ bool LinearOSNS::preCompute(double time)
     // Note : sizeOuput can be unchanged, but positions may have changed. (??)
     if(_keepLambdaAndYState)
     {
-      InteractionsGraph::VIterator ui, uiend;
-      for(std::tie(ui, uiend) = indexSet.vertices(); ui != uiend; ++ui)
+      const InteractionsGraph::FlatGraph& interactions = indexSet.flat();
+      for(size_t k = 0; k < interactions.size(); ++k)
       {
-        Interaction& inter = *indexSet.bundle(*ui);
+        Interaction& inter = *interactions.bundles[k];
         // Get the position of inter-interactionBlock in the vector w
         // or z
-        unsigned int pos = indexSet.properties(*ui).absolute_position;
+        unsigned int pos = interactions.properties[k]->absolute_position;
         // VA 30/08/2021  : Warning. the values of y_k and lambda_k that are stored in Memory
         // may be undefined at the first time step.
         const SiconosVector& yOutput_k = inter.y_k(inputOutputLevel());
@@ -1014,13 +1162,13 @@ void LinearOSNS::postCompute()
 
   unsigned int pos = 0;
 
-  InteractionsGraph::VIterator ui, uiend;
-  for(std::tie(ui, uiend) = indexSet.vertices(); ui != uiend; ++ui)
+  const InteractionsGraph::FlatGraph& interactions = indexSet.flat();
+  for(size_t k = 0; k < interactions.size(); ++k)
   {
-    Interaction& inter = *indexSet.bundle(*ui);
+    Interaction& inter = *interactions.bundles[k];
     // Get the  position of inter-interactionBlock in the vector w
     // or z
-    pos = indexSet.properties(*ui).absolute_position;
+    pos = interactions.properties[k]->absolute_position;
 
     // Get Y and Lambda for the current Interaction
     y = inter.y(inputOutputLevel());
@@ -262,6 +262,14 @@ public:
    */
   void computeDiagonalInteractionBlock(
       const InteractionsGraph::VDescriptor &vd) override;
+
+  /** \return true: the blocks of different interactions or pairs of
+   *  interactions are written by independent calls
+   */
+  bool hasThreadSafeInteractionBlocks() const override
+  {
+    return true;
+  }
   
   /** compute matrix M */
   virtual void computeM();
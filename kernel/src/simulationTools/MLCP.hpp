@@ -139,6 +139,14 @@ public:
   void computeDiagonalInteractionBlock(
       const InteractionsGraph::VDescriptor &vd) override;
 
+  /** \return false: computeDiagonalInteractionBlock builds the options
+   *  of the problem in the order of the interactions
+   */
+  bool hasThreadSafeInteractionBlocks() const override
+  {
+    return false;
+  }
+
   /** Compute the unknown z and w and update the Interaction (y and lambda )
    * 
    *  \param time current time
@@ -40,6 +40,9 @@
 
 #include "BlockVector.hpp"
 
+#include <atomic>
+#include <vector>
+
 // #define DEBUG_NOCOLOR
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES
@@ -85,9 +88,6 @@ MoreauJeanOSI::MoreauJeanOSI(double theta, double gamma)
     _gamma = 1.0 / 2.0;
     _useGamma = false;
   }
-  _selected_coordinates.resize(8);
-  for (unsigned int i =0; i<8;i++)
-    _selected_coordinates[i]=0;
 
 }
 
@@ -651,7 +651,7 @@ void MoreauJeanOSI::computeInitialNewtonState()
 }
 
 void MoreauJeanOSI::applyBoundaryConditions(SecondOrderDS& d,  SiconosVector& residu,
-    DynamicalSystemsGraph::VIterator dsi, double t,
+    DynamicalSystemProperties& ds_properties, double t,
     const SiconosVector & v)
 {
   DEBUG_BEGIN("MoreauJeanOSI::applyBoundaryConditions(...)\n");
@@ -660,7 +660,7 @@ void MoreauJeanOSI::applyBoundaryConditions(SecondOrderDS& d,  SiconosVector& re
     d.boundaryConditions()->computePrescribedVelocity(t);
 
     unsigned int columnindex = 0;
-    SimpleMatrix & WBoundaryConditions  = *_dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions ;
+    SimpleMatrix & WBoundaryConditions  = *ds_properties.WBoundaryConditions ;
     SP::SiconosVector columntmp(new SiconosVector(d.dimension()));
 
     for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
@@ -709,19 +709,21 @@ double MoreauJeanOSI::computeResidu()
   // Iteration through the set of Dynamical Systems.
   //
   //SP::DynamicalSystem ds; // Current Dynamical System.
-  Type::Siconos dsType ; // Type of the current DS.
 
   double maxResidu = 0;
-  double normResidu = maxResidu;
 
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  // residu of each ds, the max is taken after the (possibly parallel) loop
+  std::vector<double> residus(_dynamicalSystemsGraph->flat().size(), 0.);
+
+  _forEachDS([&](size_t k, DynamicalSystem& ds, DynamicalSystemProperties& ds_properties)
   {
-    if(!checkOSI(dsi)) continue;
-    DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
-    VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(*dsi).workVectors;
+    // a sleeping ds is not integrated, its residu is left to zero
+    if(static_cast<SecondOrderDS&>(ds).isSleeping()) return;
 
-    dsType = Type::value(ds); // Its type
+    VectorOfVectors& ds_work_vectors = *ds_properties.workVectors;
+    double normResidu = 0.;
+
+    Type::Siconos dsType = Type::value(ds); // Its type
 
     // 3 - Lagrangian Non Linear Systems
     if(dsType == Type::LagrangianDS)
@@ -784,7 +786,7 @@ double MoreauJeanOSI::computeResidu()
 
       }
 
-      applyBoundaryConditions(d, residuFree, dsi, t, v);
+      applyBoundaryConditions(d, residuFree, ds_properties, t, v);
 
       free = residuFree; // copy residuFree into Workfree
       DEBUG_EXPR(residuFree.display());
@@ -792,7 +794,7 @@ double MoreauJeanOSI::computeResidu()
       if(d.p(1))
         free -= *d.p(1); // Compute Residu in Workfree Notation !!
 
-      applyBoundaryConditions(d, free, dsi, t, v);
+      applyBoundaryConditions(d, free, ds_properties, t, v);
 
       DEBUG_EXPR(free.display());
       normResidu = free.norm2();
@@ -890,7 +892,7 @@ double MoreauJeanOSI::computeResidu()
       //         scal(coeff, *Fext, *realresiduFree, false); // vfree -= h*_theta * fext(ti+1)
       //       }
 
-      applyBoundaryConditions(d, residuFree, dsi, t, vold);
+      applyBoundaryConditions(d, residuFree, ds_properties, t, vold);
 
       free = residuFree; // copy residuFree into free
       if(d.p(1))
@@ -955,7 +957,7 @@ double MoreauJeanOSI::computeResidu()
       }
 
 
-      applyBoundaryConditions(d, residuFree, dsi, t, vold);
+      applyBoundaryConditions(d, residuFree, ds_properties, t, vold);
 
 
       free = residuFree; // copy residuFree into free
@@ -1026,7 +1028,7 @@ double MoreauJeanOSI::computeResidu()
 
       }
 
-      applyBoundaryConditions(d, residuFree, dsi, t, v);
+      applyBoundaryConditions(d, residuFree, ds_properties, t, v);
 
 
 
@@ -1035,7 +1037,7 @@ double MoreauJeanOSI::computeResidu()
       if(d.p(1))
         free -= *d.p(1);
 
-      applyBoundaryConditions(d, free, dsi, t, v);
+      applyBoundaryConditions(d, free, ds_properties, t, v);
 
 
       DEBUG_PRINT("MoreauJeanOSI::computeResidu :\n");
@@ -1049,9 +1051,11 @@ double MoreauJeanOSI::computeResidu()
     else
       THROW_EXCEPTION("MoreauJeanOSI::computeResidu - not yet implemented for Dynamical system of type: " + Type::name(ds));
 
-    if(normResidu > maxResidu) maxResidu = normResidu;
+    residus[k] = normResidu;
+  });
 
-  }
+  for(double normResidu : residus)
+    if(normResidu > maxResidu) maxResidu = normResidu;
   DEBUG_END("MoreauJeanOSI::computeResidu()\n");
   return maxResidu;
 
@@ -1077,17 +1081,19 @@ void MoreauJeanOSI::computeFreeState()
 
   //SP::DynamicalSystem ds; // Current Dynamical System.
   //SP::SiconosMatrix W; // W MoreauJeanOSI matrix of the current DS.
-  Type::Siconos dsType ; // Type of the current DS.
-
-  DynamicalSystemsGraph::VIterator dsi, dsend;
 
-  for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  _forEachDS([&](size_t, DynamicalSystem& ds, DynamicalSystemProperties& ds_properties)
   {
-    if(!checkOSI(dsi)) continue;
-    DynamicalSystem & ds = *_dynamicalSystemsGraph->bundle(*dsi);
-    dsType = Type::value(ds); // Its type
-    SiconosMatrix& W = *_dynamicalSystemsGraph->properties(*dsi).W; // Its W MoreauJeanOSI matrix of iteration.
-    VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(*dsi).workVectors;
+    Type::Siconos dsType = Type::value(ds); // Its type
+    SiconosMatrix& W = *ds_properties.W; // Its W MoreauJeanOSI matrix of iteration.
+    VectorOfVectors& ds_work_vectors = *ds_properties.workVectors;
+
+    // a sleeping ds keeps its (zero) velocity
+    if(static_cast<SecondOrderDS&>(ds).isSleeping())
+    {
+      *ds_work_vectors[MoreauJeanOSI::VFREE] = *static_cast<SecondOrderDS&>(ds).velocity();
+      return;
+    }
     // // 3 - Lagrangian Non Linear Systems
     // if(dsType == Type::LagrangianDS ||
     //    dsType == Type::NewtonEulerDS)
@@ -1130,7 +1136,7 @@ void MoreauJeanOSI::computeFreeState()
       computeW(t, d, W);
       if(d.boundaryConditions())
       {
-        _computeWBoundaryConditions(d, *_dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions,W);
+        _computeWBoundaryConditions(d, *ds_properties.WBoundaryConditions,W);
       }
     }
 
@@ -1280,35 +1286,36 @@ void MoreauJeanOSI::computeFreeState()
     // else
     //   THROW_EXCEPTION("MoreauJeanOSI::computeFreeState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
 
-  }
+  });
   DEBUG_END("MoreauJeanOSI::computeFreeState()\n");
 }
 
 void MoreauJeanOSI::prepareNewtonIteration(double time)
 {
   DEBUG_BEGIN(" MoreauJeanOSI::prepareNewtonIteration(double time)\n");
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  _forEachDS([&](size_t, DynamicalSystem& ds, DynamicalSystemProperties& ds_properties)
   {
-    if(!checkOSI(dsi)) continue;
-    SecondOrderDS &sods = * (std::static_pointer_cast<SecondOrderDS> (_dynamicalSystemsGraph->bundle(*dsi)));
-    computeW(time, sods, *_dynamicalSystemsGraph->properties(*dsi).W);
-  }
+    SecondOrderDS& d = static_cast<SecondOrderDS&>(ds);
+    // a sleeping ds is not integrated, see Simulation::setSleeping()
+    if(d.isSleeping()) return;
+    computeW(time, d, *ds_properties.W);
+  });
+
+  const DynamicalSystemsGraph::FlatGraph& dsg = _dynamicalSystemsGraph->flat();
 
   if(!_explicitNewtonEulerDSOperators)
   {
-    DynamicalSystemsGraph::VIterator dsi, dsend;
-
-    for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+    for(size_t k = 0; k < dsg.size(); ++k)
     {
-      if(!checkOSI(dsi)) continue;
+      if(!checkOSI(dsg, k)) continue;
 
-      SP::DynamicalSystem ds = _dynamicalSystemsGraph->bundle(*dsi);
+      SP::DynamicalSystem ds = dsg.bundles[k];
 
       //  VA <2016-04-19 Tue> We compute T to be consistent with the Jacobian
       //   at the beginning of the Newton iteration and not at the end
       Type::Siconos dsType = Type::value(*ds);
-      if(dsType == Type::NewtonEulerDS)
+      if(dsType == Type::NewtonEulerDS
+         && !static_cast<SecondOrderDS&>(*ds).isSleeping())
       {
         SP::NewtonEulerDS d = std::static_pointer_cast<NewtonEulerDS> (ds);
         computeT(d->q(),d->T());
@@ -1467,15 +1474,17 @@ void MoreauJeanOSI::computeFreeOutput(InteractionsGraph::VDescriptor& vertex_int
   {
     unsigned int sizeY = inter.nonSmoothLaw()->size();
 
-    //Index _selected_coordinates(8);
-    _selected_coordinates[0] = 0;
-    _selected_coordinates[1] = sizeY;
-    _selected_coordinates[2] = 0;
-    _selected_coordinates[3] = sizeY;
-    _selected_coordinates[4] = 0;
-    _selected_coordinates[5] = sizeY;
-    _selected_coordinates[6] = 0;
-    _selected_coordinates[7] = sizeY;
+    // local, the free outputs of several interactions may be computed
+    // concurrently (see OneStepNSProblem::setParallelAssembly)
+    Index selected_coordinates(8);
+    selected_coordinates[0] = 0;
+    selected_coordinates[1] = sizeY;
+    selected_coordinates[2] = 0;
+    selected_coordinates[3] = sizeY;
+    selected_coordinates[4] = 0;
+    selected_coordinates[5] = sizeY;
+    selected_coordinates[6] = 0;
+    selected_coordinates[7] = sizeY;
 
     VectorOfBlockVectors& DSlink = inter.linkToDSVariables();
     // For the relation of type LagrangianRheonomousR
@@ -1489,7 +1498,7 @@ void MoreauJeanOSI::computeFreeOutput(InteractionsGraph::VDescriptor& vertex_int
         SP::SiconosMatrix ID(new SimpleMatrix(sizeY, sizeY));
         ID->eye();
         // This should be optimized -- vacary
-        subprod(*ID, *(std::static_pointer_cast<LagrangianRheonomousR>(inter.relation())->hDot()), osnsp_rhs, _selected_coordinates, false); // y += hDot
+        subprod(*ID, *(std::static_pointer_cast<LagrangianRheonomousR>(inter.relation())->hDot()), osnsp_rhs, selected_coordinates, false); // y += hDot
       }
       else
         THROW_EXCEPTION("MoreauJeanOSI::computeFreeOutput not yet implemented for SICONOS_OSNSP ");
@@ -1505,11 +1514,11 @@ void MoreauJeanOSI::computeFreeOutput(InteractionsGraph::VDescriptor& vertex_int
 
         /* we have to check that the value are at the beginnning of the time step */
         // + C q_k
-        subprod(C, *DSlink[LagrangianR::q0], osnsp_rhs, _selected_coordinates, false);
+        subprod(C, *DSlink[LagrangianR::q0], osnsp_rhs, selected_coordinates, false);
         // + h(1-_theta)v_k
 
         *DSlink[LagrangianR::q1] *= (1-_theta)* h ;
-        subprod(C, *DSlink[LagrangianR::q1], osnsp_rhs, _selected_coordinates, false);
+        subprod(C, *DSlink[LagrangianR::q1], osnsp_rhs, selected_coordinates, false);
 
 
         if(std::static_pointer_cast<LagrangianCompliantLinearTIR>(inter.relation())->e())
@@ -1710,18 +1719,17 @@ void MoreauJeanOSI::updateState(const unsigned int)
 
   double RelativeTol = _simulation->relativeConvergenceTol();
   bool useRCC = _simulation->useRelativeConvergenceCriteron();
-  if(useRCC)
-    _simulation->setRelativeConvergenceCriterionHeld(true);
+  // shared by the threads, the simulation is only updated after the loop
+  std::atomic<bool> criterionHeld(true);
 
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  _forEachDS([&](size_t, DynamicalSystem& ds, DynamicalSystemProperties& ds_properties)
   {
-    if(!checkOSI(dsi)) continue;
-    DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
+    // a sleeping ds keeps its state
+    if(static_cast<SecondOrderDS&>(ds).isSleeping()) return;
 
-    VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(*dsi).workVectors;
+    VectorOfVectors& ds_work_vectors = *ds_properties.workVectors;
 
-    SiconosMatrix& W = *_dynamicalSystemsGraph->properties(*dsi).W;
+    SiconosMatrix& W = *ds_properties.W;
     // Get the DS type
 
     Type::Siconos dsType = Type::value(ds);
@@ -1736,7 +1744,7 @@ void MoreauJeanOSI::updateState(const unsigned int)
 
       //    SiconosVector *vfree = d.velocityFree();
       SiconosVector& v = *d.velocity();
-      bool baux = dsType == Type::LagrangianDS && useRCC && _simulation->relativeConvergenceCriterionHeld();
+      bool baux = dsType == Type::LagrangianDS && useRCC && criterionHeld;
 
       if(d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
       {
@@ -1780,7 +1788,7 @@ void MoreauJeanOSI::updateState(const unsigned int)
             itindex != d.boundaryConditions()->velocityIndices()->end();
             ++itindex)
         {
-          _dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions->getCol(bc, *columntmp);
+          ds_properties.WBoundaryConditions->getCol(bc, *columntmp);
           /*\warning we assume that W is symmetric in the Lagrangian case*/
 
           double value = - inner_prod(*columntmp, v);
@@ -1811,7 +1819,7 @@ void MoreauJeanOSI::updateState(const unsigned int)
         local_buffer -= q;
         double aux = (local_buffer.norm2()) / ds_norm_ref;
         if(aux > RelativeTol)
-          _simulation->setRelativeConvergenceCriterionHeld(false);
+          criterionHeld = false;
       }
     }
     else if(dsType == Type::NewtonEulerDS)
@@ -1847,7 +1855,7 @@ void MoreauJeanOSI::updateState(const unsigned int)
               ++itindex)
             v.setValue(*itindex, 0.0);
 
-        _dynamicalSystemsGraph->properties(*dsi).W->Solve(v);
+        ds_properties.W->Solve(v);
 
         DEBUG_EXPR(d.p(_levelMaxForInput)->display());
         DEBUG_PRINT("MoreauJeanOSI::updatestate W CT lambda\n");
@@ -1871,7 +1879,7 @@ void MoreauJeanOSI::updateState(const unsigned int)
             itindex != d.boundaryConditions()->velocityIndices()->end();
             ++itindex)
         {
-          _dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions->getCol(bc, *columntmp);
+          ds_properties.WBoundaryConditions->getCol(bc, *columntmp);
           /*\warning we assume that W is symmetric in the Lagrangian case*/
           double value = - inner_prod(*columntmp, v);
           if(d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
@@ -1891,7 +1899,9 @@ void MoreauJeanOSI::updateState(const unsigned int)
     }
     else THROW_EXCEPTION("MoreauJeanOSI::updateState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
 
-  }
+  });
+  if(useRCC)
+    _simulation->setRelativeConvergenceCriterionHeld(criterionHeld);
   DEBUG_END("MoreauJeanOSI::updateState(const unsigned int)\n");
 }
 
@@ -156,12 +156,6 @@ protected:
    */
   double _constraintActivationThresholdVelocity;
 
-  /**
-      A set of work indices for the selected coordinates when
-      we subprod in computeFreeOuput
-  */
-  std::vector<std::size_t> _selected_coordinates;
-
   /** nslaw effects
    */
   // struct _NSLEffectOnFreeOutput;
@@ -474,7 +468,7 @@ public:
       SecondOrderDS &ds, const DynamicalSystemsGraph::VDescriptor &dsv);
 
   void applyBoundaryConditions(SecondOrderDS &d, SiconosVector &residu,
-                               DynamicalSystemsGraph::VIterator dsi, double t,
+                               DynamicalSystemProperties &ds_properties, double t,
                                const SiconosVector &v);
 
   /** compute the initial state of the Newton loop.
@@ -149,14 +149,14 @@ unsigned OSNSMatrix::updateSizeAndPositions(InteractionsGraph& indexSet)
   // Computes real size of the current matrix = sum of the dim. of all
   // Interactionin indexSet
   unsigned dim = 0;
-  InteractionsGraph::VIterator vd, vdend;
-  for(std::tie(vd, vdend) = indexSet.vertices(); vd != vdend; ++vd)
-  {
-    assert(indexSet.descriptor(indexSet.bundle(*vd)) == *vd);
-    indexSet.properties(*vd).absolute_position = dim;
-    dim += (indexSet.bundle(*vd)->nonSmoothLaw()->size());
-    DEBUG_PRINTF("Position = %i for interaction %zu\n",dim, indexSet.bundle(*vd)->number());
-    assert(indexSet.properties(*vd).absolute_position < dim);
+  const InteractionsGraph::FlatGraph& interactions = indexSet.flat();
+  for(size_t k = 0; k < interactions.size(); ++k)
+  {
+    assert(indexSet.descriptor(interactions.bundles[k]) == interactions.vertices[k]);
+    interactions.properties[k]->absolute_position = dim;
+    dim += (interactions.bundles[k]->nonSmoothLaw()->size());
+    DEBUG_PRINTF("Position = %i for interaction %zu\n",dim, interactions.bundles[k]->number());
+    assert(interactions.properties[k]->absolute_position < dim);
   }
 
   return dim;
@@ -268,18 +268,39 @@ void OSNSMatrix::fillM(InteractionsGraph& indexSet, bool update)
   }
   else if(_storageType == NM_SPARSE_BLOCK)
   {
+    // _M2 only links the data of the interaction blocks: if the blocks and
+    // their positions did not change, it is up to date and is not refilled.
+    std::vector<std::uintptr_t> pattern;
+    pattern.reserve(3 * indexSet.size() + 4 * indexSet.edges_number());
+    const InteractionsGraph::FlatGraph& interactions = indexSet.flat();
+    for(size_t k = 0; k < interactions.size(); ++k)
+    {
+      pattern.push_back(indexSet.index(interactions.vertices[k]));
+      pattern.push_back(interactions.bundles[k]->nonSmoothLaw()->size());
+      pattern.push_back(reinterpret_cast<std::uintptr_t>(interactions.properties[k]->block->getArray()));
+    }
+    InteractionsGraph::EIterator ei, eiend;
+    for(std::tie(ei, eiend) = indexSet.edges(); ei != eiend; ++ei)
+    {
+      pattern.push_back(indexSet.index(indexSet.source(*ei)));
+      pattern.push_back(indexSet.index(indexSet.target(*ei)));
+      pattern.push_back(reinterpret_cast<std::uintptr_t>(indexSet.properties(*ei).upper_block->getArray()));
+      pattern.push_back(reinterpret_cast<std::uintptr_t>(indexSet.properties(*ei).lower_block->getArray()));
+    }
+
     if(! _M2)
     {
       DEBUG_PRINT("Reset _M2 shared pointer using new BlockCSRMatrix(indexSet) \n ");
       _M2.reset(new BlockCSRMatrix(indexSet));
 
     }
-    else
+    else if(pattern.empty() || pattern != _blockPattern)
     {
       DEBUG_PRINT("fill existing _M2\n");
       _M2->fill(indexSet);
       DEBUG_EXPR(_M2->display(););
     }
+    _blockPattern.swap(pattern);
   }
   if(update)
     convert();
@@ -329,6 +350,29 @@ void OSNSMatrix::convert()
   DEBUG_END("OSNSMatrix::convert()\n");
 }
 
+CSparseMatrix* OSNSMatrix::beginTripletFill()
+{
+  NumericsMatrix* M = _numericsMatrix.get();
+  if(M && M->storageType == NM_SPARSE
+     && M->size0 == (int)_dimRow && M->size1 == (int)_dimColumn
+     && M->matrix2->origin == NSM_TRIPLET && M->matrix2->triplet)
+  {
+    M->matrix2->triplet->nz = 0;
+    return M->matrix2->triplet;
+  }
+  _numericsMatrix.reset(NM_create(NM_SPARSE, _dimRow, _dimColumn), NM_free);
+  NM_triplet_alloc(_numericsMatrix.get(), _triplet_nzmax);
+  return NM_triplet(_numericsMatrix.get());
+}
+
+void OSNSMatrix::endTripletFill()
+{
+  // same entries as at the previous fill: the compressed storages and the
+  // symbolic analyses of the matrix are kept
+  NM_update_values(_numericsMatrix.get());
+  _triplet_nzmax = NM_nnz(_numericsMatrix.get());
+}
+
 // Fill the matrix W
 // Used only in GlobalFrictionContact
 void OSNSMatrix::fillW(DynamicalSystemsGraph & DSG, bool update)
@@ -347,16 +391,11 @@ void OSNSMatrix::fillW(DynamicalSystemsGraph & DSG, bool update)
   {
     if(update)
     {
-      size_t sizeM = _dimRow;
-      DEBUG_PRINTF("sizeM = %lu \n", sizeM);
+      DEBUG_PRINTF("sizeM = %u \n", _dimRow);
 
       // We choose a triplet matrix format for inserting values.
       // This simplifies the memory manipulation.
-      _numericsMatrix.reset(NM_create(NM_SPARSE, sizeM, sizeM),NM_free);
-
-      NumericsMatrix& M_NM = *numericsMatrix();
-      NM_triplet_alloc(&M_NM, _triplet_nzmax);
-      CSparseMatrix* Mtriplet = NM_triplet(&M_NM);
+      CSparseMatrix* Mtriplet = beginTripletFill();
 
       unsigned int pos =0;
       // Loop over the DS for filling M
@@ -369,7 +408,7 @@ void OSNSMatrix::fillW(DynamicalSystemsGraph & DSG, bool update)
         W->fillTriplet(Mtriplet, pos, pos);
         DEBUG_PRINTF("pos = %u \n", pos);
       }
-      _triplet_nzmax =  NM_nnz(&M_NM);
+      endTripletFill();
     }
     break;
   }
@@ -402,16 +441,11 @@ void OSNSMatrix::fillWinverse(DynamicalSystemsGraph & DSG, bool update)
   {
     if(update)
     {
-      size_t sizeM = _dimRow;
-      DEBUG_PRINTF("sizeM = %lu \n", sizeM);
+      DEBUG_PRINTF("sizeM = %u \n", _dimRow);
 
       // We choose a triplet matrix format for inserting values.
       // This simplifies the memory manipulation.
-      _numericsMatrix.reset(NM_create(NM_SPARSE, sizeM, sizeM),NM_free);
-
-      NumericsMatrix& M_NM = *numericsMatrix();
-      NM_triplet_alloc(&M_NM, _triplet_nzmax);
-      CSparseMatrix* Mtriplet = NM_triplet(&M_NM);
+      CSparseMatrix* Mtriplet = beginTripletFill();
 
       unsigned int pos =0;
       // Loop over the DS for filling M
@@ -447,7 +481,7 @@ void OSNSMatrix::fillWinverse(DynamicalSystemsGraph & DSG, bool update)
       //   Mtriplet->x[k] = 1.0/Mtriplet->x[k];
       // }
       //NM_display(numericsMatrix().get());
-      _triplet_nzmax =  NM_nnz(&M_NM);
+      endTripletFill();
       //getchar();
     }
     break;
@@ -498,10 +532,7 @@ void OSNSMatrix::fillHtrans(DynamicalSystemsGraph & DSG, InteractionsGraph& inde
     {
       // We choose a triplet matrix format for inserting values.
       // This simplifies the memory manipulation.
-      _numericsMatrix.reset(NM_create(NM_SPARSE, _dimRow, _dimColumn),NM_free);
-      NumericsMatrix& H_NM = *numericsMatrix();
-      NM_triplet_alloc(&H_NM, _triplet_nzmax);
-      CSparseMatrix* Htriplet= NM_triplet(&H_NM);
+      CSparseMatrix* Htriplet = beginTripletFill();
 
       unsigned int pos = 0, abs_pos_ds=0;
       SP::SiconosMatrix leftInteractionBlock;
@@ -570,7 +601,7 @@ void OSNSMatrix::fillHtrans(DynamicalSystemsGraph & DSG, InteractionsGraph& inde
           CSparseMatrix_block_dense_zentry(Htriplet,  pos, abs_pos_ds, array+posBlock*sizeY, sizeY, sizeDS, DBL_EPSILON);
         }
       }
-      _triplet_nzmax =  NM_nnz(&H_NM);
+      endTripletFill();
     }
     break;
   }
@@ -26,6 +26,8 @@
 #include "SiconosSerialization.hpp" // for ACCEPT_SERIALIZATION
 #include "SimulationTypeDef.hpp"
 #include "NumericsMatrix.h" // for NM_types
+#include <cstdint>
+#include <vector>
 
 /**
    Interface to some specific storage types for matrices used in
@@ -117,6 +119,10 @@ protected:
       (_storageType = NM_SPARSE_BLOCK) */
   SP::BlockCSRMatrix _M2;
 
+  /** structure of _M2 at the last fillM (index, size and data address of
+   *  each block), used to skip its refill when it did not change */
+  std::vector<std::uintptr_t> _blockPattern;
+
   /** For each Interaction in the graph, compute its absolute position
    * 
    *  \param indexSet the index set ot the concerned interactios.
@@ -133,6 +139,20 @@ protected:
    */
   virtual unsigned updateSizeAndPositions(DynamicalSystemsGraph & DSG);
 
+  /** Triplet storage of _numericsMatrix (NM_SPARSE, of size _dimRow x
+   *  _dimColumn), emptied for a new fill. The current matrix is kept when
+   *  it is a triplet of the same size, so that its other storages are
+   *  updated in place by endTripletFill(); otherwise a new matrix is
+   *  created.
+   *
+   *  \return the triplet to be filled
+   */
+  CSparseMatrix* beginTripletFill();
+
+  /** End of a fill started with beginTripletFill(): the new values are
+   *  propagated to the other storages of _numericsMatrix. */
+  void endTripletFill();
+
 private:
   /** Private copy constructor => no copy nor pass by value */
   OSNSMatrix(const OSNSMatrix&);
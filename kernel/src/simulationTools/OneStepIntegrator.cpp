@@ -24,7 +24,11 @@
 #include "Relation.hpp"
 #include "EventsManager.hpp"
 #include <SiconosConfig.h>
+#include <exception>
 #include <functional>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 using namespace std::placeholders;
 
 SP::VectorOfVectors
@@ -48,6 +52,44 @@ OneStepIntegrator::_initializeDSWorkVectors(SP::DynamicalSystem ds)
   return wv;
 }
 
+void OneStepIntegrator::_forEachDS(
+  const std::function<void(size_t, DynamicalSystem&, DynamicalSystemProperties&)>& f)
+{
+  const DynamicalSystemsGraph::FlatGraph& dsg = _dynamicalSystemsGraph->flat();
+  long int n = (long int) dsg.size();
+
+#ifdef WITH_OPENMP
+  if(_parallelDSLoops && n > 1 && omp_get_max_threads() > 1)
+  {
+    // exceptions must not escape the parallel region
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic, 8)
+    for(long int k = 0; k < n; ++k)
+    {
+      if(!checkOSI(dsg, k)) continue;
+      try
+      {
+        f(k, *dsg.bundles[k], *dsg.properties[k]);
+      }
+      catch(...)
+      {
+        #pragma omp critical(OneStepIntegrator_forEachDS)
+        if(!error)
+          error = std::current_exception();
+      }
+    }
+    if(error)
+      std::rethrow_exception(error);
+    return;
+  }
+#endif
+
+  for(long int k = 0; k < n; ++k)
+  {
+    if(!checkOSI(dsg, k)) continue;
+    f(k, *dsg.bundles[k], *dsg.properties[k]);
+  }
+}
 
 void OneStepIntegrator::initialize()
 {
@@ -30,6 +30,8 @@
 #include "SimulationGraphs.hpp"
 #include "Simulation.hpp"
 
+#include <functional>
+
 /**
    Generic class to manage DynamicalSystem(s) time-integration
 
@@ -102,7 +104,11 @@ protected:
 
   bool _explicitJacobiansOfRelation;
 
-
+  /** if true, the per-ds phases of the integrator (computation of W,
+   *  of the free state, of the residu and update of the state) are
+   *  spread over the OpenMP threads. Default false.
+   */
+  bool _parallelDSLoops;
 
   /** A link to the simulation that owns this OSI */
   SP::Simulation _simulation;
@@ -115,7 +121,8 @@ protected:
     : _integratorType(type), _sizeMem(1), _steps(0),
       _levelMinForOutput(0), _levelMaxForOutput(0),
       _levelMinForInput(0), _levelMaxForInput(0),
-      _isInitialized(false), _explicitJacobiansOfRelation(false) {};
+      _isInitialized(false), _explicitJacobiansOfRelation(false),
+      _parallelDSLoops(false) {};
 
   /** struct to add terms in the integration. Useful for Control */
   SP::ExtraAdditionalTerms _extraAdditionalTerms;
@@ -135,6 +142,20 @@ protected:
    */
   SP::VectorOfVectors _initializeDSWorkVectors(SP::DynamicalSystem ds);
 
+  /** apply a function to each dynamical system integrated by this osi,
+   *  in parallel if _parallelDSLoops is true (and siconos is built with
+   *  OpenMP).
+   *
+   *  The function is called with the position of the ds in the flat
+   *  snapshot of the ds graph, the ds and its properties. It must only
+   *  modify this ds, its properties and its work vectors. If it throws,
+   *  the first exception caught is rethrown once all the threads are done.
+   *
+   *  \param f the function
+   */
+  void _forEachDS(const std::function<void(size_t, DynamicalSystem&,
+                                           DynamicalSystemProperties&)>& f);
+
   /** default constructor */
   OneStepIntegrator() {};
 
@@ -266,6 +287,24 @@ public:
     _explicitJacobiansOfRelation = newval;
   };
 
+  bool parallelDSLoops() const
+  {
+    return _parallelDSLoops;
+  }
+
+  /** run the per-ds phases of the integration on the OpenMP threads.
+   *  The dynamical systems must not share any data modified during the
+   *  integration (e.g. a matrix or a vector given to several ds) and
+   *  their plugins must be thread-safe. Without OpenMP, the loops remain
+   *  serial.
+   *
+   *  \param newval true to enable the parallel loops
+   */
+  void setParallelDSLoops(bool newval)
+  {
+    _parallelDSLoops = newval;
+  };
+
   /** initialise the integrator
    */
   virtual void initialize();
@@ -493,6 +532,17 @@ public:
     return  (_dynamicalSystemsGraph->properties(dsgv).osi.get()) == this;
   };
 
+  /**
+     True if the dynamical system at a given position of the flat snapshot of the ds graph is integrated by this osi.
+
+     \param dsg the flat snapshot of the ds graph, see SiconosGraph::flat()
+     \param k the position of the dynamical system in the snapshot
+   */
+  inline bool checkOSI(const DynamicalSystemsGraph::FlatGraph& dsg, size_t k)
+  {
+    return  (dsg.properties[k]->osi.get()) == this;
+  };
+
   /**
      True if the dynamical system (a vertex in the ds graph) is integrated by this osi.
 
@@ -20,6 +20,7 @@
 #include "NonSmoothDynamicalSystem.hpp"
 //#include "Interaction.hpp"
 #include "Interaction.hpp"
+#include "Relation.hpp"
 #include "Topology.hpp"
 #include "Simulation.hpp"
 #include "EulerMoreauOSI.hpp"
@@ -32,12 +33,44 @@
 #include "ZeroOrderHoldOSI.hpp"
 #include "NonSmoothLaw.hpp"
 #include "Simulation.hpp"
+#include <SiconosConfig.h>
+#include <exception>
+#include <vector>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES
 #include "siconos_debug.h"
 #include "numerics_verbose.h" // numerics to set verbose mode ...
 
+// The interaction blocks of an interaction do not change from one step to the
+// next if its relation is linear and time-invariant and if the OSI matrices of
+// its dynamical systems are constant (linear time-invariant systems, for a
+// given time step).
+static bool hasConstantInteractionBlocks(InteractionsGraph& indexSet,
+                                         InteractionsGraph::VDescriptor vd)
+{
+  Interaction& inter = *indexSet.bundle(vd);
+  if(inter.relation()->getSubType() != RELATION::LinearTIR)
+    return false;
+
+  // the assembled matrix is scaled in place for this law, see LinearOSNS::computeM
+  if(Type::value(*inter.nonSmoothLaw()) == Type::FremondImpactFrictionNSL)
+    return false;
+
+  for(SP::DynamicalSystem ds : {indexSet.properties(vd).source, indexSet.properties(vd).target})
+  {
+    Type::Siconos dsType = Type::value(*ds);
+    if(dsType != Type::LagrangianLinearTIDS
+        && dsType != Type::LagrangianLinearDiagonalDS
+        && dsType != Type::FirstOrderLinearTIDS)
+      return false;
+  }
+  return true;
+}
+
 // --- CONSTRUCTORS/DESTRUCTOR ---
 
 
@@ -69,11 +102,35 @@ void OneStepNSProblem::updateInteractionBlocks()
   //  - If 1 == true, 2 == false, 3 == true, it computes the interactionBlock.
   //  - If 1==false, 2 is not checked, and the interactionBlock is computed if 3==true.
   //
+  // Moreover, an interactionBlock computed at the previous call is kept as
+  // it is if its interactions have constant blocks (see
+  // hasConstantInteractionBlocks) and are still in the index set, and if
+  // the time step did not change. Only the blocks of new or changed
+  // interactions are computed.
+  //
+  // The blocks are allocated (and zeroed) in a first pass over the graph,
+  // which also lists the blocks to be computed; these are then computed,
+  // possibly concurrently (see setParallelAssembly). The blocks of two
+  // interactions linked by two edges (two common ds) are shared by the
+  // edges, so their computations are grouped in one task.
 
   // Get index set from Simulation
   SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
 
   bool isLinear = simulation()->nonSmoothDynamicalSystem()->isLinear();
+  bool compute = !isLinear || !_hasBeenUpdated;
+  bool parallel = _parallelAssembly && hasThreadSafeInteractionBlocks();
+
+  if(simulation()->timeStep() != _upToDateBlocksTimeStep)
+  {
+    _upToDateBlocks.clear();
+    _upToDateBlocksTimeStep = simulation()->timeStep();
+  }
+  // blocks computed during this call (or kept) that remain valid for the next one
+  std::unordered_set<SP::SiconosMatrix> upToDateBlocks;
+
+  if(compute && parallel)
+    _factorizeOSIMatrices(*indexSet);
 
   // we put diagonal information on vertices
   // self loops with bgl are a *nightmare* at the moment
@@ -81,6 +138,7 @@ void OneStepNSProblem::updateInteractionBlocks()
   if(indexSet->properties().symmetric)
   {
     DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Symmetric case");
+    std::vector<InteractionsGraph::VDescriptor> diagonalBlocks;
     InteractionsGraph::VIterator vi, viend;
     for(std::tie(vi, viend) = indexSet->vertices();
         vi != viend; ++vi)
@@ -92,17 +150,30 @@ void OneStepNSProblem::updateInteractionBlocks()
         indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
       }
 
-      if(!isLinear || !_hasBeenUpdated)
+      bool constant = hasConstantInteractionBlocks(*indexSet, *vi);
+      bool upToDate = constant && _upToDateBlocks.count(indexSet->properties(*vi).block);
+      if(compute && !upToDate)
       {
-        computeDiagonalInteractionBlock(*vi);
+        diagonalBlocks.push_back(*vi);
       }
+      if(constant)
+        upToDateBlocks.insert(indexSet->properties(*vi).block);
     }
 
+    _forEach(diagonalBlocks.size(), [&](size_t k)
+    {
+      computeDiagonalInteractionBlock(diagonalBlocks[k]);
+    }, parallel);
+
     /* interactionBlock must be zeroed at init */
     std::vector<bool> initialized;
     initialized.resize(indexSet->edges_number());
     std::fill(initialized.begin(), initialized.end(), false);
 
+    /* edges to be computed, grouped by first edge between their interactions */
+    std::vector<std::vector<InteractionsGraph::EDescriptor>> edgeBlocks;
+    std::vector<int> edgeBlocksTask(indexSet->edges_number(), -1);
+
     InteractionsGraph::EIterator ei, eiend;
     for(std::tie(ei, eiend) = indexSet->edges();
         ei != eiend; ++ei)
@@ -148,19 +219,41 @@ void OneStepNSProblem::updateInteractionBlocks()
         currentInteractionBlock = indexSet->properties(ed1).lower_block;
       }
 
-      if(!initialized[indexSet->index(ed1)])
+      bool constant = hasConstantInteractionBlocks(*indexSet, indexSet->source(*ei))
+                      && hasConstantInteractionBlocks(*indexSet, indexSet->target(*ei));
+      bool upToDate = constant && _upToDateBlocks.count(currentInteractionBlock);
+      if(constant)
+        upToDateBlocks.insert(currentInteractionBlock);
+
+      if(!initialized[indexSet->index(ed1)] && !upToDate)
       {
         initialized[indexSet->index(ed1)] = true;
         currentInteractionBlock->zero();
       }
-      if(!isLinear || !_hasBeenUpdated)
+      if(compute && !upToDate)
       {
+        int& task = edgeBlocksTask[indexSet->index(ed1)];
+        if(task < 0)
         {
-          computeInteractionBlock(*ei);
+          task = (int) edgeBlocks.size();
+          edgeBlocks.emplace_back();
         }
+        edgeBlocks[task].push_back(*ei);
+      }
+    }
+
+    _forEach(edgeBlocks.size(), [&](size_t k)
+    {
+      for(const InteractionsGraph::EDescriptor& ed : edgeBlocks[k])
+      {
+        computeInteractionBlock(ed);
 
         // allocation for transposed block
         // should be avoided
+        InteractionsGraph::EDescriptor ed1, ed2;
+        std::tie(ed1, ed2) = indexSet->edges(indexSet->source(ed), indexSet->target(ed));
+        unsigned int isrc = indexSet->index(indexSet->source(ed));
+        unsigned int itar = indexSet->index(indexSet->target(ed));
 
         if(itar > isrc)  // upper block has been computed
         {
@@ -186,12 +279,22 @@ void OneStepNSProblem::updateInteractionBlocks()
           indexSet->properties(ed2).upper_block = indexSet->properties(ed1).upper_block;
         }
       }
-    }
+    }, parallel);
   }
   else // not symmetric => follow out_edges for each vertices
   {
     DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Non symmetric case\n");
 
+    /* blocks to be computed for each vertex: its diagonal block and the
+     * blocks of its out edges, which are only written from this vertex */
+    struct VertexBlocks
+    {
+      InteractionsGraph::VDescriptor vd;
+      bool diagonal;
+      std::vector<InteractionsGraph::EDescriptor> edges;
+    };
+    std::vector<VertexBlocks> vertexBlocks;
+
     InteractionsGraph::VIterator vi, viend;
     for(std::tie(vi, viend) = indexSet->vertices();
         vi != viend; ++vi)
@@ -204,10 +307,14 @@ void OneStepNSProblem::updateInteractionBlocks()
         indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
       }
 
-      if(!isLinear || !_hasBeenUpdated)
-      {
-        computeDiagonalInteractionBlock(*vi);
-      }
+      VertexBlocks blocks;
+      blocks.vd = *vi;
+
+      bool constant = hasConstantInteractionBlocks(*indexSet, *vi);
+      bool upToDate = constant && _upToDateBlocks.count(indexSet->properties(*vi).block);
+      blocks.diagonal = compute && !upToDate;
+      if(constant)
+        upToDateBlocks.insert(indexSet->properties(*vi).block);
 
       /* on a undirected graph, out_edges gives all incident edges */
       InteractionsGraph::OEIterator oei, oeiend;
@@ -289,23 +396,41 @@ void OneStepNSProblem::updateInteractionBlocks()
         }
 
 
-        if(!initialized[currentInteractionBlock])
+        bool constant = hasConstantInteractionBlocks(*indexSet, indexSet->source(*oei))
+                        && hasConstantInteractionBlocks(*indexSet, indexSet->target(*oei));
+        bool upToDate = constant && _upToDateBlocks.count(currentInteractionBlock);
+        if(constant)
+          upToDateBlocks.insert(currentInteractionBlock);
+
+        if(!initialized[currentInteractionBlock] && !upToDate)
         {
           initialized[currentInteractionBlock] = true;
           currentInteractionBlock->zero();
         }
 
-        if(!isLinear || !_hasBeenUpdated)
+        if(compute && !upToDate)
         {
           if(isrc != itar)
-            computeInteractionBlock(*oei);
+            blocks.edges.push_back(*oei);
         }
 
       }
+      if(blocks.diagonal || !blocks.edges.empty())
+        vertexBlocks.push_back(std::move(blocks));
     }
+
+    _forEach(vertexBlocks.size(), [&](size_t k)
+    {
+      if(vertexBlocks[k].diagonal)
+        computeDiagonalInteractionBlock(vertexBlocks[k].vd);
+      for(const InteractionsGraph::EDescriptor& ed : vertexBlocks[k].edges)
+        computeInteractionBlock(ed);
+    }, parallel);
   }
 
 
+  _upToDateBlocks.swap(upToDateBlocks);
+
   DEBUG_EXPR(displayBlocks(indexSet););
 
   DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks() ends\n");
@@ -313,6 +438,66 @@ void OneStepNSProblem::updateInteractionBlocks()
 
 }
 
+void OneStepNSProblem::_forEach(size_t n, const std::function<void(size_t)>& f,
+                                bool parallel)
+{
+#ifdef WITH_OPENMP
+  if(parallel && n > 1 && omp_get_max_threads() > 1)
+  {
+    // exceptions must not escape the parallel region
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic, 8)
+    for(long int k = 0; k < (long int) n; ++k)
+    {
+      try
+      {
+        f(k);
+      }
+      catch(...)
+      {
+        #pragma omp critical(OneStepNSProblem_forEach)
+        if(!error)
+          error = std::current_exception();
+      }
+    }
+    if(error)
+      std::rethrow_exception(error);
+    return;
+  }
+#endif
+
+  for(size_t k = 0; k < n; ++k)
+    f(k);
+}
+
+void OneStepNSProblem::_factorizeOSIMatrices(InteractionsGraph& indexSet)
+{
+  // The dense factors of a matrix are only read by the solves once it
+  // is factorized. Matrices that are not solved against are left
+  // untouched: the inverse iteration matrices (MoreauJeanBilbaoOSI,
+  // LagrangianLinearDiagonalDS) and the copies made by getOSIMatrix
+  // (D1MinusLinearOSI, ZeroOrderHoldOSI).
+  DynamicalSystemsGraph& DSG0 = *simulation()->nonSmoothDynamicalSystem()->dynamicalSystems();
+  const InteractionsGraph::FlatGraph& interactions = indexSet.flat();
+  for(size_t k = 0; k < interactions.size(); ++k)
+  {
+    for(SP::DynamicalSystem ds : {interactions.properties[k]->source,
+                                  interactions.properties[k]->target})
+    {
+      OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds)).osi;
+      OSI::TYPES osiType = osi.getType();
+      if(osiType == OSI::MOREAUJEANBILBAOOSI
+          || osiType == OSI::D1MINUSLINEAROSI
+          || osiType == OSI::ZOHOSI
+          || Type::value(*ds) == Type::LagrangianLinearDiagonalDS)
+        continue;
+      SP::SimpleMatrix W = getOSIMatrix(osi, ds);
+      if(W && !W->isFactorized())
+        W->Factorize();
+    }
+  }
+}
+
 void OneStepNSProblem::displayBlocks(SP::InteractionsGraph indexSet)
 {
 
@@ -26,6 +26,8 @@
 #include "SiconosVisitor.hpp"
 #include "SimulationTypeDef.hpp"
 #include "SimulationGraphs.hpp"
+#include <functional>
+#include <unordered_set>
 
 /**
    Non Smooth Problem Formalization and Simulation
@@ -108,6 +110,37 @@ protected:
   /*During Newton it, this flag allows to update the numerics matrices only once if necessary.*/
   bool _hasBeenUpdated = false;
 
+  /** interaction blocks that are still valid and need not be computed again
+   *  by updateInteractionBlocks (blocks of linear time-invariant
+   *  interactions, kept as long as they stay in the index set) */
+  std::unordered_set<SP::SiconosMatrix> _upToDateBlocks;
+
+  /** time step used to compute the blocks of _upToDateBlocks */
+  double _upToDateBlocksTimeStep = 0.;
+
+  /** if true, the interaction blocks and the free output of the
+   *  interactions are computed on the OpenMP threads. Default false.
+   */
+  bool _parallelAssembly = false;
+
+  /** call f(k) for k in [0, n), on the OpenMP threads if parallel is
+   *  true (and siconos is built with OpenMP). If f throws, the first
+   *  exception caught is rethrown once all the threads are done.
+   *
+   *  \param n the number of calls
+   *  \param f the function
+   *  \param parallel true to spread the calls over the threads
+   */
+  void _forEach(size_t n, const std::function<void(size_t)>& f, bool parallel);
+
+  /** factorize the OSI matrices of the dynamical systems of an index
+   *  set that are solved against in the computation of the interaction
+   *  blocks, so that the blocks can then be computed concurrently
+   *
+   *  \param indexSet the index set
+   */
+  void _factorizeOSIMatrices(InteractionsGraph& indexSet);
+
   // --- CONSTRUCTORS/DESTRUCTOR ---
   /** default constructor */
   OneStepNSProblem() = default;
@@ -277,6 +310,48 @@ public:
     _hasBeenUpdated = v;
   }
 
+  /** force the computation of all the interaction blocks at the next call
+   *  of updateInteractionBlocks (to be called if the matrices of linear
+   *  time-invariant relations or systems are modified during the
+   *  simulation)
+   */
+  void resetInteractionBlocks()
+  {
+    _upToDateBlocks.clear();
+  }
+
+  bool parallelAssembly() const
+  {
+    return _parallelAssembly;
+  }
+
+  /** compute the interaction blocks and the free output of the
+   *  interactions on the OpenMP threads. The osi of the dynamical
+   *  systems must compute the free output of an interaction without
+   *  modifying data shared with other interactions (this is the case of
+   *  MoreauJeanOSI and EulerMoreauOSI). The free output of the
+   *  LagrangianRheonomousR and LagrangianCompliantLinearTIR relations,
+   *  which write in the relation or in the ds, is computed serially.
+   *  Without OpenMP, or for problems whose block computation is not
+   *  thread-safe (see hasThreadSafeInteractionBlocks), the computation
+   *  remains serial.
+   *
+   *  \param newval true to enable the parallel assembly
+   */
+  void setParallelAssembly(bool newval)
+  {
+    _parallelAssembly = newval;
+  }
+
+  /** \return true if computeDiagonalInteractionBlock and
+   *  computeInteractionBlock can be called concurrently for different
+   *  blocks
+   */
+  virtual bool hasThreadSafeInteractionBlocks() const
+  {
+    return false;
+  }
+
   /**
      initialize the problem (topology and so on)
      
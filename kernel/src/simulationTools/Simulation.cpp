@@ -43,6 +43,7 @@
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES
 #include <fstream>
+#include <numeric>
 
 #include "siconos_debug.h"
 
@@ -444,6 +445,9 @@ void Simulation::initialize() {
   // 7 - First initialization of the simulation
   firstInitialize();
 
+  // 8 - put the ds at rest to sleep, or wake them up
+  updateSleepingDS();
+
   DEBUG_END("Simulation::initialize()\n");
 }
 
@@ -491,6 +495,8 @@ void Simulation::initializeInteraction(double time, SP::Interaction inter) {
   i_prop.osi1 = DSG.properties(DSG.descriptor(ds1)).osi;
   i_prop.osi2 = DSG.properties(DSG.descriptor(ds2)).osi;
 
+  // UpdateAndSwapAllOutput saves lambda in memory: a value given to the
+  // new interaction is the initial guess of its one step nonsmooth problem
   if (&osi1 == &osi2) {
     osi1.initializeWorkVectorsForInteraction(*inter, i_prop, DSG);
     osi1.UpdateAndSwapAllOutput(*inter, time);
@@ -615,6 +621,76 @@ void Simulation::processEvents() {
   DEBUG_END("void Simulation::processEvents()\n");
 }
 
+void Simulation::updateSleepingDS() {
+  if (!_sleeping && !_numberOfSleepingDS) return;
+  DEBUG_BEGIN("void Simulation::updateSleepingDS()\n");
+
+  const DynamicalSystemsGraph::FlatGraph& dsg = _nsds->dynamicalSystems()->flat();
+  size_t n = dsg.size();
+  double time = nextTime();
+
+  // a ds is active if it moves, or if it sleeps and its forces have
+  // changed. Only MoreauJeanOSI skips the sleeping ds: the ds integrated
+  // by another osi, and the ones which are not second order, are always
+  // active.
+  std::vector<SecondOrderDS*> ds(n);
+  std::vector<char> active(n, 1);
+  for (size_t k = 0; k < n; ++k) {
+    SP::OneStepIntegrator osi = dsg.properties[k]->osi;
+    if (!osi || osi->getType() != OSI::MOREAUJEANOSI) continue;
+    ds[k] = dynamic_cast<SecondOrderDS*>(&*dsg.bundles[k]);
+    if (!ds[k] || !_sleeping) continue;
+    if (ds[k]->isSleeping())
+      active[k] = ds[k]->forcesChangedSinceSleep(time);
+    else {
+      if (ds[k]->velocity()->normInf() <= _sleepingVelocityThreshold)
+        ds[k]->setRestingSteps(ds[k]->restingSteps() + 1);
+      else
+        ds[k]->setRestingSteps(0);
+      active[k] = ds[k]->restingSteps() < _sleepingSteps;
+    }
+  }
+
+  // islands: connected components of the ds graph (union-find on the
+  // positions of the ds in the flat graph)
+  std::vector<size_t> root(n);
+  std::iota(root.begin(), root.end(), 0);
+  auto find = [&root](size_t k) {
+    while (root[k] != k) k = root[k] = root[root[k]];
+    return k;
+  };
+  for (size_t k = 0; k < n; ++k) {
+    for (size_t a = dsg.adjacency_start[k]; a < dsg.adjacency_start[k + 1]; ++a) {
+      size_t r1 = find(k);
+      size_t r2 = find(dsg.adjacency[a]);
+      if (r1 < r2)
+        root[r2] = r1;
+      else if (r2 < r1)
+        root[r1] = r2;
+    }
+  }
+
+  // an island sleeps if none of its ds is active
+  std::vector<char> activeIsland(n, 0);
+  for (size_t k = 0; k < n; ++k)
+    if (active[k]) activeIsland[find(k)] = 1;
+
+  _numberOfSleepingDS = 0;
+  for (size_t k = 0; k < n; ++k) {
+    if (!ds[k]) continue;
+    bool sleep = !activeIsland[find(k)];
+    if (sleep && !ds[k]->isSleeping()) {
+      DEBUG_PRINTF("ds %i goes to sleep\n", ds[k]->number());
+      ds[k]->sleep(time);
+    } else if (!sleep && ds[k]->isSleeping()) {
+      DEBUG_PRINTF("ds %i wakes up\n", ds[k]->number());
+      ds[k]->wakeUp();
+    }
+    if (sleep) ++_numberOfSleepingDS;
+  }
+  DEBUG_END("void Simulation::updateSleepingDS()\n");
+}
+
 void Simulation::clearNSDSChangeLog() { _nsds->clearChangeLogTo(_nsdsChangeLogPosition); }
 
 void Simulation::updateT(double T) {
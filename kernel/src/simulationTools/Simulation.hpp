@@ -125,6 +125,18 @@ class Simulation : public std::enable_shared_from_this<Simulation> {
   /** map of not-yet-initialized DS variables for each OSI */
   std::map<SP::OneStepIntegrator, std::list<SP::DynamicalSystem> > _OSIDSmap;
 
+  /** if true, the islands of ds at rest are put to sleep, see setSleeping() */
+  bool _sleeping = false;
+
+  /** velocity (infinity norm) under which a ds is at rest */
+  double _sleepingVelocityThreshold = 1e-3;
+
+  /** number of steps at rest before a ds may be put to sleep */
+  unsigned int _sleepingSteps = 50;
+
+  /** number of sleeping ds after the last updateSleepingDS() */
+  unsigned int _numberOfSleepingDS = 0;
+
  private:
   /** copy constructor. Private => no copy nor pass-by value.
    */
@@ -484,6 +496,53 @@ class Simulation : public std::enable_shared_from_this<Simulation> {
    */
   void processEvents();
 
+  /** put to sleep the second order ds at rest, to skip them in long
+   *  simulations where most bodies have settled.
+   *
+   *  A ds is at rest if the infinity norm of its velocity stays under
+   *  the velocity threshold. The ds linked by interactions form islands,
+   *  and an island is put to sleep once all its ds have been at rest for
+   *  a given number of steps. A sleeping ds keeps a zero velocity: it is
+   *  not integrated by MoreauJeanOSI and the interactions between
+   *  sleeping ds are kept out of the index sets (their lambda is then
+   *  zero).
+   *
+   *  The whole island is woken up as soon as one of its ds moves, i.e. if
+   *  an interaction links it to an awake ds, or if the forces applied to
+   *  a sleeping ds change. A ds may also be woken up with
+   *  SecondOrderDS::wakeUp(). Disabled by default.
+   *
+   *  Only the ds integrated by a MoreauJeanOSI, and not by one of its
+   *  derived integrators, are put to sleep: the islands with a ds
+   *  integrated by another osi are never put to sleep.
+   *
+   *  \param b true to enable sleeping
+   */
+  inline void setSleeping(bool b) { _sleeping = b; };
+
+  /** \return true if sleeping is enabled, see setSleeping() */
+  inline bool sleeping() const { return _sleeping; };
+
+  /** \param v velocity (infinity norm) under which a ds is at rest, 1e-3 by default */
+  inline void setSleepingVelocityThreshold(double v) { _sleepingVelocityThreshold = v; };
+
+  /** \return the velocity under which a ds is at rest */
+  inline double sleepingVelocityThreshold() const { return _sleepingVelocityThreshold; };
+
+  /** \param n number of steps at rest before a ds may be put to sleep, 50 by default */
+  inline void setSleepingSteps(unsigned int n) { _sleepingSteps = n; };
+
+  /** \return the number of steps at rest before a ds may be put to sleep */
+  inline unsigned int sleepingSteps() const { return _sleepingSteps; };
+
+  /** \return the number of sleeping ds */
+  inline unsigned int numberOfSleepingDS() const { return _numberOfSleepingDS; };
+
+  /** update the rest counters of the ds and put to sleep, or wake up,
+   *  their islands, see setSleeping(). Called at the beginning of each step.
+   */
+  void updateSleepingDS();
+
   /** set staticLevels
    *
    *  \param b decides whether levels should be computed at each iteration
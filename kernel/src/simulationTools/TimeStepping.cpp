@@ -27,6 +27,7 @@
 #include <SiconosConfig.h>
 
 #include <functional>
+#include <set>
 
 #include "BlockVector.hpp"
 #include "EulerMoreauOSI.hpp"
@@ -39,6 +40,7 @@
 #include "NonSmoothLaw.hpp"
 #include "OneStepIntegrator.hpp"
 #include "Relation.hpp"
+#include "SecondOrderDS.hpp"
 #include "TypeName.hpp"
 
 # include "SolverOptions.h"
@@ -148,6 +150,13 @@ void TimeStepping::insertIntegrator(SP::OneStepIntegrator osi) {
 //   return (y<=0);
 // }
 
+/* true if all the ds of an interaction sleep, see Simulation::setSleeping() */
+static bool sleepingInteraction(const InteractionProperties& properties) {
+  SecondOrderDS* ds1 = dynamic_cast<SecondOrderDS*>(&*properties.source);
+  SecondOrderDS* ds2 = dynamic_cast<SecondOrderDS*>(&*properties.target);
+  return ds1 && ds1->isSleeping() && ds2 && ds2->isSleeping();
+}
+
 void TimeStepping::updateIndexSet(unsigned int i) {
   // To update IndexSet i: add or remove Interactions from
   // this set, depending on y values.
@@ -199,14 +208,17 @@ void TimeStepping::updateIndexSet(unsigned int i) {
       assert((indexSet0->color(inter1_descr0) == boost::white_color));
 
       indexSet0->color(inter1_descr0) = boost::gray_color;
-      if (Type::value(*(inter1->nonSmoothLaw())) != Type::EqualityConditionNSL) {
+      // the interactions of sleeping ds are removed, whatever their law
+      bool sleeping = _numberOfSleepingDS && sleepingInteraction(indexSet1->properties(*ui1));
+      if (sleeping ||
+          Type::value(*(inter1->nonSmoothLaw())) != Type::EqualityConditionNSL) {
         // We assume that the integrator of the ds1 drive the update of the index set
         // SP::OneStepIntegrator Osi = indexSet1->properties(*ui1).osi;
         SP::DynamicalSystem ds1 = indexSet1->properties(*ui1).source;
         OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
 
         // if(predictorDeactivate(inter1,i))
-        if (osi.removeInteractionFromIndexSet(inter1, i)) {
+        if (sleeping || osi.removeInteractionFromIndexSet(inter1, i)) {
           // Interaction is not active
           // ui1 becomes invalid
           indexSet0->color(inter1_descr0) = boost::black_color;
@@ -255,33 +267,36 @@ void TimeStepping::updateIndexSet(unsigned int i) {
   }
 
   // indexSet0\indexSet1 scan
-  InteractionsGraph::VIterator ui0, ui0end;
-  // Add interaction in indexSet1
-  for (std::tie(ui0, ui0end) = indexSet0->vertices(); ui0 != ui0end; ++ui0) {
-    if (indexSet0->color(*ui0) == boost::black_color) {
+  // Add interaction in indexSet1 (only indexSet1 is modified in the loop)
+  const InteractionsGraph::FlatGraph& interactions0 = indexSet0->flat();
+  for (size_t k = 0; k < interactions0.size(); ++k) {
+    InteractionsGraph::VDescriptor ui0 = interactions0.vertices[k];
+    if (indexSet0->color(ui0) == boost::black_color) {
       // reset
-      indexSet0->color(*ui0) = boost::white_color;
+      indexSet0->color(ui0) = boost::white_color;
     } else {
-      if (indexSet0->color(*ui0) == boost::gray_color) {
+      if (indexSet0->color(ui0) == boost::gray_color) {
         // reset
-        indexSet0->color(*ui0) = boost::white_color;
+        indexSet0->color(ui0) = boost::white_color;
 
-        assert(indexSet1->is_vertex(indexSet0->bundle(*ui0)));
+        assert(indexSet1->is_vertex(interactions0.bundles[k]));
         /*assert( { !predictorDeactivate(indexSet0->bundle(*ui0),i) ||
           Type::value(*(indexSet0->bundle(*ui0)->nonSmoothLaw())) == Type::EqualityConditionNSL
           ;
           });*/
       } else {
-        assert(indexSet0->color(*ui0) == boost::white_color);
+        assert(indexSet0->color(ui0) == boost::white_color);
 
-        SP::Interaction inter0 = indexSet0->bundle(*ui0);
+        SP::Interaction inter0 = interactions0.bundles[k];
         assert(!indexSet1->is_vertex(inter0));
-        bool activate = true;
-        if (Type::value(*(inter0->nonSmoothLaw())) != Type::EqualityConditionNSL &&
+        bool activate =
+            !(_numberOfSleepingDS && sleepingInteraction(*interactions0.properties[k]));
+        if (activate &&
+            Type::value(*(inter0->nonSmoothLaw())) != Type::EqualityConditionNSL &&
             Type::value(*(inter0->nonSmoothLaw())) != Type::RelayNSL) {
           // SP::OneStepIntegrator Osi = indexSet0->properties(*ui0).osi;
           //  We assume that the integrator of the ds1 drive the update of the index set
-          SP::DynamicalSystem ds1 = indexSet1->properties(*ui0).source;
+          SP::DynamicalSystem ds1 = interactions0.properties[k]->source;
           OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
 
           activate = osi.addInteractionInIndexSet(inter0, i);
@@ -294,6 +309,14 @@ void TimeStepping::updateIndexSet(unsigned int i) {
           topo->setHasChanged(true);
           assert(indexSet1->is_vertex(inter0));
         }
+        else
+        {
+          // the input of all the interactions of indexSet0 is
+          // computed from lambda: an interaction that is not active
+          // must not keep a multiplier it has been given as initial
+          // guess (see setResetAllLambda), it would act on the ds
+          if (inter0->lambda(1)) inter0->lambda(1)->zero();
+        }
       }
     }
   }
@@ -399,21 +422,33 @@ void TimeStepping::run() {
 
 void TimeStepping::resetLambdas() {
   if (_resetAllLambda) {
+    // the interactions linked since the last step are not initialized
+    // yet: the multipliers they have been given are kept
+    std::set<SP::Interaction> newInteractions;
+    NonSmoothDynamicalSystem::ChangeLog::const_iterator itc = _nsdsChangeLogPosition.it;
+    for (++itc; itc != _nsds->changeLog().end(); ++itc)
+      if (itc->typeOfChange == NonSmoothDynamicalSystem::addInteraction)
+        newInteractions.insert(itc->i);
+
     // Initialize lambdas of all interactions.
     SP::InteractionsGraph indexSet0 = _nsds->topology()->indexSet(0);
     InteractionsGraph::VIterator ui, uiend, vnext;
     std::tie(ui, uiend) = indexSet0->vertices();
     for (vnext = ui; ui != uiend; ui = vnext) {
       ++vnext;
-      indexSet0->bundle(*ui)->resetAllLambda();
+      SP::Interaction inter = indexSet0->bundle(*ui);
+      if (!newInteractions.count(inter)) inter->resetAllLambda();
     }
   }
 }
 
 void TimeStepping::advanceToEvent() {
   DEBUG_PRINTF("TimeStepping::advanceToEvent(). Time =%f\n", getTkp1());
-  initialize();
+  // the multipliers are reset before the new interactions are
+  // initialized: a value they have been given is kept as the initial
+  // guess of the one step nonsmooth problem
   if (!_skip_resetLambdas) resetLambdas();
+  initialize();
   newtonSolve(_newtonTolerance, _newtonMaxIteration);
 }
 
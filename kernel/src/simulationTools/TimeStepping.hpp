@@ -199,7 +199,7 @@ public:
    */
   void computeFreeState();
 
-  /** Reset all lambdas of all interactions */
+  /** Reset all lambdas of all interactions but the ones not yet initialized */
   void resetLambdas();
 
   /** step from current event to next event of EventsManager
@@ -278,6 +278,11 @@ public:
   void displayNewtonConvergenceAtTheEnd(int info, unsigned int maxStep);
   void displayNewtonConvergenceInTheLoop();
 
+  /** if false, the multipliers of the active interactions are kept
+   *  between the steps and are the initial guess of the one step
+   *  nonsmooth problem. The multipliers given to new interactions are
+   *  their initial guess in both cases.
+   */
   void setResetAllLambda(bool newval) { _resetAllLambda = newval; };
 
   void setSkipLastUpdateOutput(bool newval)
@@ -0,0 +1,407 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2024 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "LinearOSNSTest.hpp"
+#include "LinearOSNS.hpp"
+#include "BoundaryCondition.hpp"
+#include "FremondImpactFrictionNSL.hpp"
+#include "FrictionContact.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "NewtonEuler1DR.hpp"
+#include "NewtonEuler3DR.hpp"
+#include "NewtonEulerDS.hpp"
+#include "NewtonImpactFrictionNSL.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "NumericsMatrix.h"
+#include "OSNSMatrix.hpp"
+#include "SimulationGraphs.hpp"
+#include "SolverOptions.h"
+#include "SparseBlockMatrix.h"
+#include "TimeDiscretisation.hpp"
+#include "TimeStepping.hpp"
+#include "lcp_cst.h"
+#include <atomic>
+#include <map>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(LinearOSNSTest);
+
+
+void LinearOSNSTest::setUp()
+{}
+
+void LinearOSNSTest::tearDown()
+{}
+
+/* LinearOSNS which only keeps the diagonal blocks of its interactions,
+ * in the order of their numbers */
+class DiagonalBlocksOSNS : public LinearOSNS
+{
+public:
+  std::map<size_t, SimpleMatrix> blocks;
+
+  DiagonalBlocksOSNS():
+    LinearOSNS(SP::SolverOptions(solver_options_create(SICONOS_LCP_LEMKE),
+                                 solver_options_delete))
+  {}
+
+  bool checkCompatibleNSLaw(NonSmoothLaw& nslaw) override
+  {
+    return true;
+  }
+
+  int compute(double time) override
+  {
+    preCompute(time);
+    InteractionsGraph& indexSet = *simulation()->indexSet(indexSetLevel());
+    InteractionsGraph::VIterator vi, viend;
+    for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+      blocks.emplace(indexSet.bundle(*vi)->number(), SimpleMatrix(*indexSet.properties(*vi).block));
+    return 0;
+  }
+};
+
+/* the diagonal blocks of the interactions of nsds after one step (the
+ * interactions are given a negative gap, so that they are active). With
+ * boundary conditions (without any prescribed velocity) on the ds, the
+ * blocks are computed by the generic path of
+ * LinearOSNS::computeDiagonalInteractionBlock, otherwise by the fixed-size
+ * kernels for the common contact shapes */
+static std::vector<SimpleMatrix> diagonalBlocks(SP::NonSmoothDynamicalSystem nsds, bool generic)
+{
+  if(generic)
+  {
+    DynamicalSystemsGraph& dsg = *nsds->dynamicalSystems();
+    DynamicalSystemsGraph::VIterator vi, viend;
+    for(std::tie(vi, viend) = dsg.vertices(); vi != viend; ++vi)
+      std::static_pointer_cast<SecondOrderDS>(dsg.bundle(*vi))->setBoundaryConditions(
+        std::make_shared<BoundaryCondition>(std::make_shared<std::vector<unsigned int>>()));
+  }
+  SP::TimeDiscretisation td(new TimeDiscretisation(0., 0.01));
+  std::shared_ptr<DiagonalBlocksOSNS> osnspb(new DiagonalBlocksOSNS());
+  SP::TimeStepping s(new TimeStepping(nsds, td, std::make_shared<MoreauJeanOSI>(0.5), osnspb));
+  s->computeOneStep();
+
+  std::vector<SimpleMatrix> blocks;
+  for(auto& b : osnspb->blocks)
+    blocks.push_back(b.second);
+  return blocks;
+}
+
+static void checkBlocks(const std::vector<SimpleMatrix>& fixedSize,
+                        const std::vector<SimpleMatrix>& generic,
+                        unsigned int numberOfBlocks)
+{
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("number of blocks", (size_t)numberOfBlocks, fixedSize.size());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("number of blocks", (size_t)numberOfBlocks, generic.size());
+  for(unsigned int k = 0; k < numberOfBlocks; ++k)
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("size of the block", generic[k].size(0), fixedSize[k].size(0));
+    CPPUNIT_ASSERT_MESSAGE("non zero block", generic[k].normInf() > 0.);
+    SimpleMatrix diff(generic[k]);
+    diff -= fixedSize[k];
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("block of the fixed-size kernels",
+                                         0., diff.normInf() / generic[k].normInf(), 1e-13);
+  }
+}
+
+/* two Lagrangian ds of dimension 3 with full mass matrices, a contact of
+ * size 1 with the ground, of size 2 and of size 3 between them */
+static SP::NonSmoothDynamicalSystem lagrangianSystem()
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  std::vector<SP::LagrangianLinearTIDS> ds;
+  for(unsigned int d = 0; d < 2; ++d)
+  {
+    SP::SiconosMatrix mass(new SimpleMatrix(3, 3));
+    for(unsigned int i = 0; i < 3; ++i)
+      for(unsigned int j = 0; j < 3; ++j)
+        (*mass)(i, j) = (i == j) ? 2. + d : 0.3 / (1. + i + j);
+    SP::SiconosVector q(new SiconosVector(3, 1. + d)), v(new SiconosVector(3));
+    ds.push_back(std::make_shared<LagrangianLinearTIDS>(q, v, mass));
+    ds.back()->setFExtPtr(std::make_shared<SiconosVector>(3, -9.81));
+    nsds->insertDynamicalSystem(ds.back());
+  }
+  auto relation = [](unsigned int rows, unsigned int cols)
+  {
+    SP::SimpleMatrix H(new SimpleMatrix(rows, cols));
+    for(unsigned int i = 0; i < rows; ++i)
+      for(unsigned int j = 0; j < cols; ++j)
+        (*H)(i, j) = 1. / (1. + i + 2 * j) - 0.2 * (i == j);
+    return std::make_shared<LagrangianLinearTIR>(H, std::make_shared<SiconosVector>(rows, -10.));
+  };
+  nsds->link(std::make_shared<Interaction>(std::make_shared<NewtonImpactNSL>(0.), relation(1, 3)), ds[0]);
+  nsds->link(std::make_shared<Interaction>(std::make_shared<NewtonImpactFrictionNSL>(0., 0., 0.3, 2),
+                                           relation(2, 6)), ds[0], ds[1]);
+  nsds->link(std::make_shared<Interaction>(std::make_shared<NewtonImpactFrictionNSL>(0., 0., 0.3, 3),
+                                           relation(3, 6)), ds[0], ds[1]);
+  return nsds;
+}
+
+/* two rotated NewtonEuler ds with full inertia matrices, a contact of
+ * size 1 with the ground and a contact of size 3 between them */
+static SP::NonSmoothDynamicalSystem newtonEulerSystem()
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  std::vector<SP::NewtonEulerDS> ds;
+  for(unsigned int d = 0; d < 2; ++d)
+  {
+    SP::SiconosMatrix inertia(new SimpleMatrix(3, 3));
+    for(unsigned int i = 0; i < 3; ++i)
+      for(unsigned int j = 0; j < 3; ++j)
+        (*inertia)(i, j) = (i == j) ? 0.5 + d : 0.1 / (1. + i + j);
+    SP::SiconosVector q(new SiconosVector(7)), v(new SiconosVector(6));
+    (*q)(2) = 2. * d;
+    // rotation of angle 2 pi / 3 around (1, 1, 1)
+    (*q)(3) = 0.5;
+    (*q)(4) = (*q)(5) = (*q)(6) = 0.5;
+    ds.push_back(std::make_shared<NewtonEulerDS>(q, v, 1. + d, inertia));
+    nsds->insertDynamicalSystem(ds.back());
+  }
+  auto set = [](SiconosVector& u, double x, double y, double z)
+  {
+    u(0) = x;
+    u(1) = y;
+    u(2) = z;
+  };
+  SP::NewtonEuler1DR ground(new NewtonEuler1DR());
+  set(*ground->pc1(), 0.3, -0.2, -0.5);
+  set(*ground->pc2(), 0.3, -0.2, -0.5);
+  set(*ground->nc(), 0., 0., 1.);
+  ground->setE(std::make_shared<SiconosVector>(1, -10.));
+  nsds->link(std::make_shared<Interaction>(std::make_shared<NewtonImpactNSL>(0.), ground), ds[0]);
+  SP::NewtonEuler3DR contact(new NewtonEuler3DR());
+  set(*contact->pc1(), 0.1, 0.2, 1.);
+  set(*contact->pc2(), 0.1, 0.2, 1.);
+  set(*contact->nc(), 0.6, 0., 0.8);
+  contact->setE(std::make_shared<SiconosVector>(3, -10.));
+  nsds->link(std::make_shared<Interaction>(std::make_shared<NewtonImpactFrictionNSL>(0., 0., 0.3, 3),
+                                           contact), ds[0], ds[1]);
+  return nsds;
+}
+
+void LinearOSNSTest::testDiagonalBlocksLagrangian()
+{
+  checkBlocks(diagonalBlocks(lagrangianSystem(), false),
+              diagonalBlocks(lagrangianSystem(), true), 3);
+}
+
+void LinearOSNSTest::testDiagonalBlocksNewtonEuler()
+{
+  checkBlocks(diagonalBlocks(newtonEulerSystem(), false),
+              diagonalBlocks(newtonEulerSystem(), true), 2);
+}
+
+/* three Lagrangian ds of dimension 3 on a column, with contacts of size 3
+ * with the ground and between them */
+/* chains of three bodies: the first one is in contact with the ground, the
+ * others with the previous one. The chains are independent. */
+static SP::NonSmoothDynamicalSystem frictionSystem(unsigned int chains = 1,
+                                                   bool fremond = false)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  auto relation = [](unsigned int cols)
+  {
+    SP::SimpleMatrix H(new SimpleMatrix(3, cols));
+    for(unsigned int i = 0; i < 3; ++i)
+      for(unsigned int j = 0; j < cols; ++j)
+        (*H)(i, j) = 1. / (1. + i + 2 * j) - 0.2 * (i == j);
+    return std::make_shared<LagrangianLinearTIR>(H, std::make_shared<SiconosVector>(3, -10.));
+  };
+  SP::NonSmoothLaw law;
+  if(fremond)
+    law = std::make_shared<FremondImpactFrictionNSL>(0., 0., 0.3, 3);
+  else
+    law = std::make_shared<NewtonImpactFrictionNSL>(0., 0., 0.3, 3);
+  for(unsigned int c = 0; c < chains; ++c)
+  {
+    std::vector<SP::LagrangianLinearTIDS> ds;
+    for(unsigned int d = 0; d < 3; ++d)
+    {
+      SP::SiconosMatrix mass(new SimpleMatrix(3, 3));
+      for(unsigned int i = 0; i < 3; ++i)
+        for(unsigned int j = 0; j < 3; ++j)
+          (*mass)(i, j) = (i == j) ? 2. + d + c : 0.3 / (1. + i + j);
+      SP::SiconosVector q(new SiconosVector(3, 1. + d)), v(new SiconosVector(3));
+      ds.push_back(std::make_shared<LagrangianLinearTIDS>(q, v, mass));
+      ds.back()->setFExtPtr(std::make_shared<SiconosVector>(3, -9.81));
+      nsds->insertDynamicalSystem(ds.back());
+    }
+    nsds->link(std::make_shared<Interaction>(law, relation(3)), ds[0]);
+    nsds->link(std::make_shared<Interaction>(law, relation(6)), ds[0], ds[1]);
+    nsds->link(std::make_shared<Interaction>(law, relation(6)), ds[1], ds[2]);
+  }
+  return nsds;
+}
+
+/* block (row, col) of the sparse block matrix M, NULL if it is zero */
+static double* sparseBlock(const SparseBlockStructuredMatrix& M, unsigned int row, unsigned int col)
+{
+  for(size_t k = M.index1_data[row]; k < M.index1_data[row + 1]; ++k)
+    if(M.index2_data[k] == col)
+      return M.block[k];
+  return nullptr;
+}
+
+static void checkSameBlock(double* block, const SiconosMatrix& interactionBlock)
+{
+  CPPUNIT_ASSERT_MESSAGE("non zero block", block);
+  for(unsigned int i = 0; i < 3; ++i)
+    for(unsigned int j = 0; j < 3; ++j)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("packed block", interactionBlock(i, j), block[i + 3 * j]);
+}
+
+void LinearOSNSTest::testPackedBlocks()
+{
+  SP::NonSmoothDynamicalSystem nsds = frictionSystem();
+  SP::TimeDiscretisation td(new TimeDiscretisation(0., 0.01));
+  SP::FrictionContact osnspb(new FrictionContact(3));
+  osnspb->setMStorageType(NM_SPARSE_BLOCK);
+  SP::TimeStepping s(new TimeStepping(nsds, td, std::make_shared<MoreauJeanOSI>(0.5), osnspb));
+
+  // the blocks of the numerics matrix are copied in a contiguous array,
+  // at each step
+  for(unsigned int step = 0; step < 3; ++step)
+  {
+    s->computeOneStep();
+    const SparseBlockStructuredMatrix& M = *osnspb->M()->numericsMatrix()->matrix1;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("number of blocks", 7u, M.nbblocks);
+    CPPUNIT_ASSERT_MESSAGE("packed blocks", M.block_data);
+    for(unsigned int k = 0; k < M.nbblocks; ++k)
+      CPPUNIT_ASSERT_MESSAGE("contiguous blocks", M.block[k] == M.block_data + 9 * k);
+
+    InteractionsGraph& indexSet = *s->indexSet(osnspb->indexSetLevel());
+    InteractionsGraph::VIterator vi, viend;
+    for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+    {
+      unsigned int i = indexSet.index(*vi);
+      checkSameBlock(sparseBlock(M, i, i), *indexSet.properties(*vi).block);
+    }
+    InteractionsGraph::EIterator ei, eiend;
+    for(std::tie(ei, eiend) = indexSet.edges(); ei != eiend; ++ei)
+    {
+      unsigned int i = indexSet.index(indexSet.source(*ei));
+      unsigned int j = indexSet.index(indexSet.target(*ei));
+      checkSameBlock(sparseBlock(M, std::min(i, j), std::max(i, j)), *indexSet.properties(*ei).upper_block);
+      checkSameBlock(sparseBlock(M, std::max(i, j), std::min(i, j)), *indexSet.properties(*ei).lower_block);
+    }
+    s->nextStep();
+  }
+}
+
+static void countIterations(void *env, int, double*, double*, double, void*)
+{
+  ++*static_cast<std::atomic<int>*>(env);
+}
+
+void LinearOSNSTest::testIslands()
+{
+  // two independent chains, solved as a whole and as two islands
+  SP::FrictionContact osnspb[2];
+  SP::TimeStepping s[2];
+  for(unsigned int k = 0; k < 2; ++k)
+  {
+    osnspb[k].reset(new FrictionContact(3));
+    osnspb[k]->numericsSolverOptions()->dparam[SICONOS_DPARAM_TOL] = 1e-14;
+    s[k].reset(new TimeStepping(frictionSystem(2), std::make_shared<TimeDiscretisation>(0., 0.01),
+                                std::make_shared<MoreauJeanOSI>(0.5), osnspb[k]));
+  }
+  osnspb[1]->setIslandDecomposition(true);
+
+  // the callback of the options is shared by the islands, but owned by
+  // the options of the problem only
+  std::atomic<int> iterations(0);
+  SolverOptions& options = *osnspb[1]->numericsSolverOptions();
+  options.callback = (Callback *)malloc(sizeof(Callback));
+  options.callback->env = &iterations;
+  options.callback->collectStatsIteration = &countIterations;
+
+  for(unsigned int step = 0; step < 3; ++step)
+  {
+    for(unsigned int k = 0; k < 2; ++k)
+      s[k]->computeOneStep();
+    const SiconosVector& z0 = *osnspb[0]->z();
+    const SiconosVector& z1 = *osnspb[1]->z();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("size of z", z0.size(), z1.size());
+    CPPUNIT_ASSERT_MESSAGE("contacts", z0.norm2() > 0.);
+    for(unsigned int i = 0; i < z0.size(); ++i)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("islands solution", z0(i), z1(i), 1e-8 * z0.norm2());
+    for(unsigned int k = 0; k < 2; ++k)
+      s[k]->nextStep();
+  }
+  CPPUNIT_ASSERT_MESSAGE("callback", iterations > 0);
+}
+
+void LinearOSNSTest::testConstantBlocks()
+{
+  for(bool fremond : {false, true})
+  {
+    SP::NonSmoothDynamicalSystem nsds = frictionSystem(1, fremond);
+    SP::TimeDiscretisation td(new TimeDiscretisation(0., 0.01));
+    SP::FrictionContact osnspb(new FrictionContact(3));
+    osnspb->setMStorageType(NM_SPARSE_BLOCK);
+    SP::TimeStepping s(new TimeStepping(nsds, td, std::make_shared<MoreauJeanOSI>(0.5), osnspb));
+    s->computeOneStep();
+    InteractionsGraph& indexSet = *s->indexSet(osnspb->indexSetLevel());
+
+    // the blocks are altered: the blocks of the linear time-invariant
+    // interactions are not computed again at the next step, the others
+    // (scaled in M for the Fremond law) are
+    NumericsMatrix* M0 = NM_create(NM_DENSE, 9, 9);
+    NM_to_dense(&*osnspb->M()->numericsMatrix(), M0);
+    std::map<SP::SiconosMatrix, SimpleMatrix> blocks;
+    InteractionsGraph::VIterator vi, viend;
+    for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+    {
+      SP::SiconosMatrix block = indexSet.properties(*vi).block;
+      blocks.emplace(block, SimpleMatrix(*block));
+      (*block)(0, 0) += 1000.;
+    }
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("number of interactions", (size_t)3, blocks.size());
+    s->nextStep();
+    s->computeOneStep();
+    for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+    {
+      SP::SiconosMatrix block = indexSet.properties(*vi).block;
+      CPPUNIT_ASSERT_MESSAGE("same block", blocks.count(block));
+      double expected = blocks.at(block)(0, 0) + (fremond ? 0. : 1000.);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("reused block", expected, (*block)(0, 0), 1e-12);
+    }
+    if(fremond)
+    {
+      // M is scaled once at each step
+      NumericsMatrix* M1 = NM_create(NM_DENSE, 9, 9);
+      NM_to_dense(&*osnspb->M()->numericsMatrix(), M1);
+      CPPUNIT_ASSERT_MESSAGE("scaled M", NM_compare(M0, M1, 1e-12));
+      NM_free(M1);
+    }
+    NM_free(M0);
+    s->nextStep();
+
+    // all the blocks are computed again after a reset
+    osnspb->resetInteractionBlocks();
+    s->computeOneStep();
+    for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+    {
+      SP::SiconosMatrix block = indexSet.properties(*vi).block;
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("computed block", blocks.at(block)(0, 0), (*block)(0, 0), 1e-12);
+    }
+  }
+}
@@ -18,6 +18,14 @@
 #include "OSNSPTest.hpp"
 #include "SolverOptions.h"
 #include "FrictionContact.hpp"
+#include "LCP.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "TimeDiscretisation.hpp"
+#include "TimeStepping.hpp"
 
 // test suite registration
 CPPUNIT_TEST_SUITE_REGISTRATION(OSNSPTest);
@@ -58,3 +66,85 @@ void OSNSPTest::testOSNSBuild_options()
   auto options_link = problem->numericsSolverOptions();
   CPPUNIT_ASSERT_EQUAL_MESSAGE("test solver options : ",  options_link->solverId == SICONOS_FRICTION_3D_ADMM, true);
 }
+
+/* LCP which keeps the initial guess given to the solver */
+class LCPInitialGuess : public LCP
+{
+public:
+  SP::SiconosVector z0;
+  bool preCompute(double time) override
+  {
+    bool not_empty = LCP::preCompute(time);
+    z0.reset(new SiconosVector(*_z));
+    return not_empty;
+  }
+};
+
+/* a new interaction starts from the reaction it is given, whether the
+ * multipliers are reset at each step or not */
+static void checkWarmStartNewInteraction(bool resetAllLambda)
+{
+  // a ball at rest on the ground and a ball in free fall
+  double h = 0.005, g = 9.81, R = 0.1;
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  SP::SiconosMatrix mass(new SimpleMatrix(1, 1));
+  (*mass)(0, 0) = 1.;
+  SP::SiconosVector gravity(new SiconosVector(1, -g));
+  SP::LagrangianLinearTIDS atRest(new LagrangianLinearTIDS(
+      SP::SiconosVector(new SiconosVector(1, R)), SP::SiconosVector(new SiconosVector(1)), mass));
+  SP::LagrangianLinearTIDS falling(new LagrangianLinearTIDS(
+      SP::SiconosVector(new SiconosVector(1, 10.)), SP::SiconosVector(new SiconosVector(1)), mass));
+  atRest->setFExtPtr(gravity);
+  falling->setFExtPtr(gravity);
+  nsds->insertDynamicalSystem(atRest);
+  nsds->insertDynamicalSystem(falling);
+
+  SP::SimpleMatrix H(new SimpleMatrix(1, 1));
+  (*H)(0, 0) = 1.;
+  SP::SiconosVector b(new SiconosVector(1, -R));
+  SP::NonSmoothLaw nslaw(new NewtonImpactNSL(0.));
+  auto ground = [&]() { return std::make_shared<Interaction>(nslaw, std::make_shared<LagrangianLinearTIR>(H, b)); };
+  SP::Interaction first = ground();
+  nsds->link(first, atRest);
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(0., h));
+  std::shared_ptr<LCPInitialGuess> osnspb(new LCPInitialGuess());
+  SP::TimeStepping s(new TimeStepping(nsds, td, std::make_shared<MoreauJeanOSI>(0.5), osnspb));
+  s->setResetAllLambda(resetAllLambda);
+  s->computeOneStep();
+  s->nextStep();
+  double lambda = (*first->lambda(1))(0);
+  CPPUNIT_ASSERT_MESSAGE("the ball is held by the ground", lambda > 0.);
+
+  // the contact is replaced by a new interaction, which is given the
+  // reaction of the previous one: it is the initial guess of the solver
+  SP::Interaction second = ground();
+  *second->lambda(1) = *first->lambda(1);
+  s->unlink(first);
+  s->link(second, atRest);
+
+  // a new interaction which is not active does not keep its reaction
+  SP::Interaction inactive = ground();
+  (*inactive->lambda(1))(0) = 1.;
+  s->link(inactive, falling);
+
+  s->computeOneStep();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("initial guess of the new interaction", (unsigned int)1, osnspb->z0->size());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("initial guess of the new interaction", lambda, (*osnspb->z0)(0), 1e-14);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("reaction of the inactive interaction", 0., (*inactive->lambda(1))(0), 1e-14);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("free fall", -2 * h * g, (*falling->velocity())(0), 1e-12);
+  s->nextStep();
+
+  // the other interactions start from their reaction at the previous step
+  // only if the multipliers are kept
+  lambda = (*second->lambda(1))(0);
+  s->computeOneStep();
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("initial guess of the interaction", resetAllLambda ? 0. : lambda,
+                                       (*osnspb->z0)(0), 1e-14);
+}
+
+void OSNSPTest::testOSNSWarmStartNewInteraction()
+{
+  checkWarmStartNewInteraction(true);
+  checkWarmStartNewInteraction(false);
+}
@@ -31,11 +31,13 @@ private:
   CPPUNIT_TEST(testOSNSBuild_default);
   CPPUNIT_TEST(testOSNSBuild_solverid);
   CPPUNIT_TEST(testOSNSBuild_options);
+  CPPUNIT_TEST(testOSNSWarmStartNewInteraction);
   CPPUNIT_TEST_SUITE_END();
 
   void testOSNSBuild_default();
   void testOSNSBuild_solverid();
   void testOSNSBuild_options();
+  void testOSNSWarmStartNewInteraction();
 
 
 public:
@@ -41,6 +41,7 @@
 #endif
 
 #include <limits>
+#include <vector>
 #include <boost/graph/graph_utility.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_concepts.hpp>
@@ -175,6 +176,31 @@ public:
   int _stamp;
   VMap vertex_descriptor;
 
+  /** Contiguous snapshot of the graph, see flat().
+   *
+   *  The vertices are stored in the order of vertices(), with their
+   *  bundles and a pointer to their properties, and the adjacency in CSR
+   *  form: the out edges of the vertex at position i are at positions
+   *  [adjacency_start[i], adjacency_start[i+1]) of adjacency (position of
+   *  the target vertex) and out_edges.
+   */
+  struct FlatGraph
+  {
+    std::vector<VDescriptor> vertices;
+    std::vector<V> bundles;
+    std::vector<VProperties*> properties;
+    std::vector<size_t> adjacency_start;
+    std::vector<size_t> adjacency;
+    std::vector<EDescriptor> out_edges;
+    /** value of the modification counter of the graph at the build */
+    size_t modifications;
+
+    size_t size() const
+    {
+      return vertices.size();
+    }
+  };
+
 protected:
   
   typedef void serializable;
@@ -190,12 +216,23 @@ private:
 
   SiconosGraph(const SiconosGraph&);
 
+  /** incremented by each change of the structure of the graph */
+  size_t _modifications;
+
+  FlatGraph _flat;
+
+  void modified()
+  {
+    ++_modifications;
+  }
+
 public:
 
   /** default constructor
    */
-  SiconosGraph() : _stamp(0)
+  SiconosGraph() : _stamp(0), _modifications(0)
   {
+    _flat.modifications = std::numeric_limits<size_t>::max();
   };
 
   ~SiconosGraph()
@@ -446,6 +483,65 @@ public:
     return boost::vertices(g);
   };
 
+  /** Contiguous snapshot of the vertices, their properties and the
+   *  adjacency, for the loops done at each step over a graph that does
+   *  not change. It is rebuilt only if the structure of the graph has
+   *  changed since the last call, and is invalidated by the next change
+   *  of the structure (the properties may be modified). Not thread-safe:
+   *  call it before entering a parallel loop over the snapshot.
+   */
+  const FlatGraph& flat()
+  {
+    if (_flat.modifications != _modifications
+        || _flat.vertices.size() != size())
+    {
+      size_t n = size();
+      _flat.vertices.clear();
+      _flat.bundles.clear();
+      _flat.properties.clear();
+      _flat.adjacency_start.clear();
+      _flat.adjacency.clear();
+      _flat.out_edges.clear();
+      _flat.vertices.reserve(n);
+      _flat.bundles.reserve(n);
+      _flat.properties.reserve(n);
+      _flat.adjacency_start.reserve(n + 1);
+
+      VIterator vi, viend;
+      for (std::tie(vi, viend) = vertices(); vi != viend; ++vi)
+      {
+        _flat.vertices.push_back(*vi);
+        _flat.bundles.push_back(bundle(*vi));
+        _flat.properties.push_back(&properties(*vi));
+      }
+
+#if !defined(SICONOS_USE_MAP_FOR_HASH)
+      std::unordered_map<VDescriptor, size_t> position;
+#else
+      std::map<VDescriptor, size_t> position;
+#endif
+      for (size_t i = 0; i < n; ++i)
+        position[_flat.vertices[i]] = i;
+
+      _flat.adjacency.reserve(2 * edges_number());
+      _flat.out_edges.reserve(2 * edges_number());
+      _flat.adjacency_start.push_back(0);
+      for (size_t i = 0; i < n; ++i)
+      {
+        OEIterator oei, oeiend;
+        for (std::tie(oei, oeiend) = out_edges(_flat.vertices[i]);
+             oei != oeiend; ++oei)
+        {
+          _flat.adjacency.push_back(position[target(*oei)]);
+          _flat.out_edges.push_back(*oei);
+        }
+        _flat.adjacency_start.push_back(_flat.adjacency.size());
+      }
+      _flat.modifications = _modifications;
+    }
+    return _flat;
+  }
+
   inline VIterator begin() const
   {
     VIterator vi, viend;
@@ -497,6 +593,7 @@ public:
     if (current_vertex_iterator == vertex_descriptor.end())
     {
       new_vertex_descriptor = boost::add_vertex(g);
+      modified();
 
       assert(vertex(size() - 1, g) == new_vertex_descriptor);
       assert(size() == vertex_descriptor.size() + 1);
@@ -587,6 +684,7 @@ public:
     assert(!adjacent_vertex_exists(vd));
 #endif
     boost::remove_vertex(vd, g);
+    modified();
 
     assert(vertex_descriptor.size() == (size() + 1));
 
@@ -619,6 +717,7 @@ public:
     assert(!is_edge(vd1, vd2, e_bundle));
 
     std::tie(new_edge, inserted) = boost::add_edge(vd1, vd2, g);
+    modified();
 
     // During a gdb session, I saw that inserted is always going to be true ...
     // This check is therefore unnecessary.
@@ -729,6 +828,7 @@ public:
     assert(adjacent_vertex_exists(source(ed)));
 
     boost::remove_edge(ed, g);
+    modified();
     /* debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -774,6 +874,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_out_edge_if(vd, pred, g);
+    modified();
     /* workaround on multisetS (tested on Disks : ok)
        multiset allows for member removal without invalidating iterators
 
@@ -807,6 +908,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_in_edge_if(vd, pred, g);
+    modified();
     /*  debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -827,6 +929,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_edge_if(pred, g);
+    modified();
     /*  debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -867,6 +970,7 @@ public:
   {
     g.clear();
     vertex_descriptor.clear();
+    modified();
   };
 
   VMap vertex_descriptor_map() const
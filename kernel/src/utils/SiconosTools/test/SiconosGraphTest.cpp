@@ -370,3 +370,59 @@ void SiconosGraphTest::t8()
   CPPUNIT_ASSERT(g.bundle(vd6) == "three");
 
 }
+
+// flat snapshot
+void SiconosGraphTest::t9()
+{
+  typedef SiconosGraph < std::string, int,
+          int, boost::no_property, boost::no_property > G;
+  G g;
+
+  G::VDescriptor vd1, vd2, vd3;
+
+  vd1 = g.add_vertex("hello");
+  vd2 = g.add_vertex("goodbye");
+  vd3 = g.add_vertex("bye");
+  g.properties(vd1) = 1;
+  g.properties(vd2) = 2;
+  g.properties(vd3) = 3;
+  g.add_edge(vd1, vd2, 12);
+  g.add_edge(vd1, vd3, 13);
+
+  const G::FlatGraph& flat = g.flat();
+  CPPUNIT_ASSERT(flat.size() == 3);
+  CPPUNIT_ASSERT(flat.adjacency_start.size() == 4);
+  CPPUNIT_ASSERT(flat.adjacency.size() == 4);
+  size_t k = 0;
+  G::VIterator vi, viend;
+  for(std::tie(vi, viend) = g.vertices(); vi != viend; ++vi, ++k)
+  {
+    CPPUNIT_ASSERT(flat.vertices[k] == *vi);
+    CPPUNIT_ASSERT(flat.bundles[k] == g.bundle(*vi));
+    CPPUNIT_ASSERT(flat.properties[k] == &g.properties(*vi));
+    size_t degree = 0;
+    G::AVIterator avi, aviend;
+    for(std::tie(avi, aviend) = g.adjacent_vertices(*vi); avi != aviend; ++avi)
+      ++degree;
+    CPPUNIT_ASSERT(flat.adjacency_start[k + 1] - flat.adjacency_start[k] == degree);
+    for(size_t e = flat.adjacency_start[k]; e < flat.adjacency_start[k + 1]; ++e)
+    {
+      CPPUNIT_ASSERT(flat.vertices[flat.adjacency[e]] == g.target(flat.out_edges[e]));
+      CPPUNIT_ASSERT(g.source(flat.out_edges[e]) == *vi);
+    }
+  }
+
+  // the properties are shared, the snapshot is kept while the graph is unchanged
+  *flat.properties[1] = 20;
+  CPPUNIT_ASSERT(g.properties(flat.vertices[1]) == 20);
+  size_t modifications = flat.modifications;
+  CPPUNIT_ASSERT(g.flat().modifications == modifications);
+
+  // it is rebuilt after a change of the structure
+  g.remove_vertex("hello");
+  const G::FlatGraph& flat2 = g.flat();
+  CPPUNIT_ASSERT(flat2.modifications != modifications);
+  CPPUNIT_ASSERT(flat2.size() == 2);
+  CPPUNIT_ASSERT(flat2.adjacency.empty());
+  CPPUNIT_ASSERT(flat2.adjacency_start.back() == 0);
+}
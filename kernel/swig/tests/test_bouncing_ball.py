@@ -425,9 +425,94 @@ def test_bouncing_ball4():
     run_simulation_with_two_ds(ball, ball_d, t0)
 
 
+def sleeping_ball(osi):
+    """A bouncing ball on the floor, with sleeping enabled, integrated
+    with osi.
+    """
+
+    t0 = 0.0  # start time
+    tend = 8.0  # end time
+    h = 0.005  # time step
+    r = 0.1  # ball radius
+    g = 9.81  # gravity
+    m = 1  # ball mass
+    e = 0.5  # restitution coeficient
+
+    x = np.zeros(3, dtype=np.float64)
+    x[0] = 1.0
+    v = np.zeros_like(x)
+    mass = np.eye(3, dtype=np.float64)
+    mass[2, 2] = 2.0 / 5 * r * r
+    ball = sk.LagrangianLinearTIDS(x, v, mass)
+    weight = np.zeros_like(x)
+    weight[0] = -m * g
+    ball.setFExtPtr(weight)
+
+    H = np.zeros((1, 3), dtype=np.float64)
+    H[0, 0] = 1.0
+    inter = sk.Interaction(sk.NewtonImpactNSL(e), sk.LagrangianLinearTIR(H))
+
+    bouncing_ball = sk.NonSmoothDynamicalSystem(t0, tend)
+    bouncing_ball.insertDynamicalSystem(ball)
+    bouncing_ball.link(inter, ball)
+
+    s = sk.TimeStepping(bouncing_ball, sk.TimeDiscretisation(t0, h), osi, sk.LCP())
+    s.setSleeping(True)
+    return ball, s
+
+
+def test_bouncing_ball_sleeping():
+    """The ball is put to sleep once at rest on the floor, and woken
+    up by a change of its external forces.
+    """
+
+    m = 1  # ball mass
+    g = 9.81  # gravity
+    theta = 0.5  # theta scheme
+    ball, s = sleeping_ball(sk.MoreauJeanOSI(theta))
+
+    q = ball.q()
+    fext = ball.fExt()
+    q_sleep = None
+    while s.hasNextEvent():
+        if s.nextTime() > 6.0 and fext[0] < 0:
+            # the ball has settled: pull it up
+            assert ball.isSleeping()
+            assert s.numberOfSleepingDS() == 1
+            fext[0] = m * g
+        s.computeOneStep()
+        if ball.isSleeping():
+            if q_sleep is None:
+                q_sleep = q[0]
+            assert q[0] == q_sleep
+        s.nextStep()
+
+    assert q_sleep is not None
+    assert not ball.isSleeping()
+    assert q[0] > q_sleep + 0.1
+
+
+def test_bouncing_ball_sleeping_other_osi():
+    """Only the ds integrated by a MoreauJeanOSI are put to sleep, not the
+    ones of its derived integrators.
+    """
+
+    theta = 0.5  # theta scheme
+    ball, s = sleeping_ball(sk.MoreauJeanDirectProjectionOSI(theta))
+
+    while s.hasNextEvent():
+        s.computeOneStep()
+        assert not ball.isSleeping()
+        s.nextStep()
+
+    assert s.numberOfSleepingDS() == 0
+
+
 if __name__ == "__main__":
     # execute only if run as a script
     test_bouncing_ball1()
     test_bouncing_ball2()
     test_bouncing_ball3()
     test_bouncing_ball4()
+    test_bouncing_ball_sleeping()
+    test_bouncing_ball_sleeping_other_osi()
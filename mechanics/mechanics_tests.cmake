@@ -5,11 +5,13 @@ if(WITH_TESTING)
   # ---- Collision/native tests ----
   begin_tests(src/collision/native/test DEPS "numerics;kernel;CPPUNIT::CPPUNIT")
   new_test(SOURCES MultiBodyTest.cpp ${SIMPLE_TEST_MAIN})
+  new_test(SOURCES UniformGridTest.cpp ${SIMPLE_TEST_MAIN})
 
   if(SICONOS_HAS_BULLET)
     begin_tests(src/collision/bullet/test DEPS "numerics;kernel;CPPUNIT::CPPUNIT")
     new_test(SOURCES  ContactTest.cpp ${SIMPLE_TEST_MAIN})
     new_test(SOURCES  Contact2dTest.cpp ${SIMPLE_TEST_MAIN})
+    new_test(SOURCES  CollisionManagerTest.cpp ${SIMPLE_TEST_MAIN})
   endif()
   
   if(WITH_OpenCASCADE)
@@ -69,8 +69,12 @@ DEFINE_SPTR(UpdateShapeVisitor)
 
 #include "BulletUtils.hpp"
 
+#include <atomic>
+#include <exception>
 #include <map>
 #include <limits>
+#include <mutex>
+#include <tuple>
 #include <boost/format.hpp>
 
 #include <Relation.hpp>
@@ -99,6 +103,7 @@ DEFINE_SPTR(UpdateShapeVisitor)
 #endif
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 #include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
@@ -132,6 +137,7 @@ DEFINE_SPTR(UpdateShapeVisitor)
 
 #include <LinearMath/btQuaternion.h>
 #include <LinearMath/btVector3.h>
+#include <LinearMath/btThreads.h>
 
 
 //#define BULLET_TIMER 1
@@ -239,6 +245,9 @@ SiconosBulletOptions::SiconosBulletOptions()
   , enablePolyhedralContactClipping(false)
   , Depth2D(0.04)
   , extrapolationCoefficient(0.0)
+  , parallelCollisionDetection(false)
+  , numberOfThreads(0)
+  , contactMatchingThreshold(0.02)
 {
 }
 
@@ -326,6 +335,175 @@ SHAPE_RECORD(BodyCH2dRecord, SP::RigidBody2dDS, SP::SiconosConvexHull2d,  SP::bt
 typedef std::map<const SecondOrderDS*, std::vector<std::shared_ptr<BodyBulletShapeRecord> > >
 BodyShapeMap;
 
+/* The id of the body of a shape record in the contact keys: dynamical
+ * systems are numbered from 0, static bodies from -1 downwards. */
+static long contactBodyId(const BodyBulletShapeRecord& record)
+{
+  if(record.ds) return record.ds->number();
+  if(record.staticBody) return -1 - record.staticBody->number;
+  return std::numeric_limits<long>::min();
+}
+
+/* The key of a contact in the contact cache: the pair of bodies, the
+ * feature ids of the contact point (part and index of the triangle for a
+ * mesh, -1 for a convex shape) and a serial number, since all the points
+ * of a manifold between convex shapes have the same feature ids. */
+struct ContactKey
+{
+  long bodyA, bodyB;
+  int partId0, index0, partId1, index1;
+  unsigned long serial;
+
+  bool operator<(const ContactKey& k) const
+  {
+    return std::tie(bodyA, bodyB, partId0, index0, partId1, index1, serial)
+      < std::tie(k.bodyA, k.bodyB, k.partId0, k.index0, k.partId1, k.index1, k.serial);
+  }
+};
+
+/* The btManifoldPoint of a contact keeps a pointer to its entry in
+ * m_userPersistentData. */
+struct ContactCacheEntry
+{
+  SP::Interaction interaction;
+  /* the contact point in the frames of the two bodies, at its creation */
+  btVector3 localPointA, localPointB;
+  bool destroyed = false;
+};
+
+/* The contacts added and removed by a collision detection, applied to the
+ * topology at once. */
+struct ContactDiff
+{
+  std::vector<SP::Interaction> removed;
+  std::vector<std::tuple<SP::Interaction, SP::SecondOrderDS, SP::SecondOrderDS> > added;
+};
+
+/* The interactions of the contact points of a manager. The entries are
+ * only marked by the Bullet callback when their contact point is
+ * destroyed, possibly on any thread of the narrowphase, and removed at
+ * the end of the collision detection. */
+class ContactCache
+{
+  std::map<ContactKey, ContactCacheEntry> _entries;
+  unsigned long _serial = 0;
+
+  /* the contacts destroyed by the last collision detection, by pair of
+   * bodies */
+  std::multimap<std::pair<long, long>, ContactCacheEntry> _destroyed;
+
+public:
+
+  ContactCacheEntry* add(SP::Interaction inter,
+                         const BodyBulletShapeRecord& recordA,
+                         const BodyBulletShapeRecord& recordB,
+                         const btManifoldPoint& point)
+  {
+    ContactKey key = { contactBodyId(recordA), contactBodyId(recordB),
+                       point.m_partId0, point.m_index0,
+                       point.m_partId1, point.m_index1, _serial++
+                     };
+    ContactCacheEntry& entry = _entries[key];
+    entry.interaction = inter;
+    entry.localPointA = point.m_localPointA;
+    entry.localPointB = point.m_localPointB;
+    return &entry;
+  }
+
+  /* remove the destroyed entries, in the order of the keys, and append
+   * their interactions to removed. The entries are kept by pair of bodies
+   * until clearDestroyed(), to warm start the new contacts. */
+  void removeDestroyed(std::vector<SP::Interaction>& removed)
+  {
+    for(auto it = _entries.begin(); it != _entries.end();)
+    {
+      if(it->second.destroyed)
+      {
+        removed.push_back(it->second.interaction);
+        _destroyed.insert(std::make_pair(std::make_pair(it->first.bodyA, it->first.bodyB),
+                                         it->second));
+        it = _entries.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+
+  /* find the destroyed contact of the same bodies closest to point, with
+   * both local points at a distance less than threshold, and copy its
+   * reaction into inter. Simulation::initializeInteraction then saves it
+   * in the lambda memory of inter, that LinearOSNS::preCompute copies
+   * into the initial guess of the solver (the multipliers of the new
+   * interactions are not reset, see TimeStepping::advanceToEvent).
+   * Each destroyed contact is used once.
+   * \return true if a contact has been found */
+  bool transferReaction(Interaction& inter,
+                        const BodyBulletShapeRecord& recordA,
+                        const BodyBulletShapeRecord& recordB,
+                        const btManifoldPoint& point, double threshold)
+  {
+    auto range = _destroyed.equal_range(std::make_pair(contactBodyId(recordA), contactBodyId(recordB)));
+    auto closest = _destroyed.end();
+    double dmin = threshold * threshold;
+    for(auto it = range.first; it != range.second; ++it)
+    {
+      double dA = it->second.localPointA.distance2(point.m_localPointA);
+      double dB = it->second.localPointB.distance2(point.m_localPointB);
+      if(dA < dmin && dB < dmin && it->second.interaction->nonSmoothLaw() == inter.nonSmoothLaw())
+      {
+        dmin = std::max(dA, dB);
+        closest = it;
+      }
+    }
+    if(closest == _destroyed.end())
+      return false;
+
+    Interaction& previous = *closest->second.interaction;
+    unsigned int lower = std::max(previous.lowerLevelForInput(), inter.lowerLevelForInput());
+    unsigned int upper = std::min(previous.upperLevelForInput(), inter.upperLevelForInput());
+    for(unsigned int level = lower; level <= upper; ++level)
+    {
+      if(previous.lambda(level) && inter.lambda(level))
+        *inter.lambda(level) = *previous.lambda(level);
+    }
+    DEBUG_PRINTF("reaction of interaction %zu transferred to interaction %zu\n",
+                 previous.number(), inter.number());
+    _destroyed.erase(closest);
+    return true;
+  }
+
+  /* forget the destroyed contacts that have not been matched */
+  void clearDestroyed()
+  {
+    _destroyed.clear();
+  }
+
+  size_t size() const
+  {
+    return _entries.size();
+  }
+};
+
+/* Apply the changes of the contacts to the topology of the simulation. */
+static void applyContactDiff(Simulation& simulation, const ContactDiff& diff,
+                             SiconosBulletStatistics& stats)
+{
+  InteractionsGraph& indexSet0 =
+    *simulation.nonSmoothDynamicalSystem()->topology()->indexSet0();
+  for(const SP::Interaction& inter : diff.removed)
+  {
+    // the interactions of a removed body have been removed with it
+    if(indexSet0.is_vertex(inter))
+    {
+      DEBUG_PRINTF("unlinking interaction %p, number %zu \n", &*inter, inter->number());
+      simulation.unlink(inter);
+      stats.interaction_destroyed ++;
+    }
+  }
+  for(const auto& link : diff.added)
+    simulation.link(std::get<0>(link), std::get<1>(link), std::get<2>(link));
+}
+
 class CollisionUpdater;
 
 class SiconosBulletCollisionManager_impl
@@ -440,6 +618,7 @@ protected:
   void updateShape(BodyCH2dRecord &record);
 
   void updateAllShapesForDS(const SecondOrderDS &bds);
+  void updateActivationForDS(const SecondOrderDS &bds);
   void updateShapePosition(const BodyBulletShapeRecord &record);
 
   /* Helper to apply an offset transform to a position and return as a
@@ -461,6 +640,8 @@ protected:
 
   std::vector<std::pair<SP::btCollisionObject,int>> _queuedCollisionObjects;
 
+  ContactCache _contactCache;
+
 public:
   SiconosBulletCollisionManager_impl(SiconosBulletOptions &op) : _options(op) {}
   ~SiconosBulletCollisionManager_impl() {}
@@ -534,6 +715,24 @@ struct SiconosBulletFilterCallback : public btOverlapFilterCallback
   }
 };
 
+/* The task scheduler of the parallel narrowphase: the OpenMP one if
+ * Bullet has been built with it, else its default one. Both are null if
+ * Bullet has not been built with BT_THREADSAFE, the pairs are then
+ * dispatched sequentially. */
+static btITaskScheduler* bulletTaskScheduler(unsigned int numberOfThreads)
+{
+  static btITaskScheduler* scheduler = nullptr;
+  if(!scheduler)
+    scheduler = btGetOpenMPTaskScheduler();
+  if(!scheduler)
+    scheduler = btCreateDefaultTaskScheduler();
+  if(!scheduler)
+    scheduler = btGetSequentialTaskScheduler();
+  if(numberOfThreads)
+    scheduler->setNumThreads(numberOfThreads);
+  return scheduler;
+}
+
 void SiconosBulletCollisionManager::initialize_impl()
 {
   _impl.reset(new SiconosBulletCollisionManager_impl(_options));
@@ -553,9 +752,16 @@ void SiconosBulletCollisionManager::initialize_impl()
       _options.minimumPointsPerturbationThreshold);
   }
 
-  //use the default collision dispatcher. For parallel processing you can use a diffent dispatcher (see Extras/BulletMultiThreaded)
-  _impl->_dispatcher.reset(
-    new btCollisionDispatcher(&*_impl->_collisionConfiguration));
+  //use the default collision dispatcher, or the task-parallel one
+  if(_options.parallelCollisionDetection)
+  {
+    btSetTaskScheduler(bulletTaskScheduler(_options.numberOfThreads));
+    _impl->_dispatcher.reset(
+      new btCollisionDispatcherMt(&*_impl->_collisionConfiguration));
+  }
+  else
+    _impl->_dispatcher.reset(
+      new btCollisionDispatcher(&*_impl->_collisionConfiguration));
 
 
   if(_options.useAxisSweep3)
@@ -611,10 +817,9 @@ SiconosBulletCollisionManager::SiconosBulletCollisionManager(const SiconosBullet
 
 SiconosBulletCollisionManager::~SiconosBulletCollisionManager()
 {
-  // unlink() will be called on all remaining
-  // contact points when world is destroyed
-
-  // must be the first de-allocated, otherwise segfault
+  // the remaining contact points only mark their entries of the contact
+  // cache when the world is destroyed, their interactions are left in the
+  // topology: the world must be de-allocated before the contact cache
   _impl->_collisionWorld.reset();
 }
 
@@ -686,6 +891,18 @@ void SiconosBulletCollisionManager_impl::updateAllShapesForDS(const SecondOrderD
     (*it)->acceptSP(updateShapeVisitor);
 }
 
+/* The collision objects of a sleeping body are deactivated: Bullet does
+ * not compute the contacts between two deactivated objects, and their
+ * contact manifolds are kept as they are. */
+void SiconosBulletCollisionManager_impl::updateActivationForDS(const SecondOrderDS &bds)
+{
+  int state = bds.isSleeping() ? ISLAND_SLEEPING : ACTIVE_TAG;
+  std::vector<std::shared_ptr<BodyBulletShapeRecord> >::iterator it;
+  for(it = bodyShapeMap[&bds].begin(); it != bodyShapeMap[&bds].end(); it++)
+    if((*it)->btobject->getActivationState() != state)
+      (*it)->btobject->setActivationState(state);
+}
+
 // helper for enabling polyhedral contact clipping for shape types
 // derived from btPolyhedralConvexShape
 static void initPolyhedralFeatures(btPolyhedralConvexShape& btshape)
@@ -2319,30 +2536,15 @@ public:
 };
 
 // called once for each contact point as it is destroyed
-Simulation* SiconosBulletCollisionManager::gSimulation;
 bool SiconosBulletCollisionManager::bulletContactClear(void* userPersistentData)
 {
-  /* note: stored pointer to shared_ptr! */
-  SP::Interaction *p_inter = (SP::Interaction*)userPersistentData;
-  assert(p_inter!=NULL && "Contact point's stored (SP::Interaction*) is null!");
-  DEBUG_PRINTF("unlinking interaction %p, number %zu \n", &**p_inter, (*p_inter)->number());
-
-  // SP::BulletR rel_bulletR(std::dynamic_pointer_cast<BulletR>((*p_inter)->relation()));
-  // SP::Bullet5DR rel_bullet5DR(std::dynamic_pointer_cast<Bullet5DR>((*p_inter)->relation()));
-  // SP::Bullet2dR rel_bullet2dR(std::dynamic_pointer_cast<Bullet2dR>((*p_inter)->relation()));
-  // SP::Bullet2d3DR rel_bullet2d3DR(std::dynamic_pointer_cast<Bullet2d3DR>((*p_inter)->relation()));
-  // if (rel_bulletR)
-  //   rel_bulletR->preDelete();
-  // else if (rel_bullet5DR)
-  //   rel_bullet5DR->preDelete();
-  // else if (rel_bullet2dR)
-  //   rel_bullet2dR->preDelete();
-  // else if (rel_bullet2d3DR)
-  //   rel_bullet2d3DR->preDelete();
-  // std::static_pointer_cast<BulletR>((*p_inter)->relation())->preDelete();
-  //_stats.interaction_destroyed++;
-  gSimulation->unlink(*p_inter);
-  delete p_inter;
+  ContactCacheEntry* entry = static_cast<ContactCacheEntry*>(userPersistentData);
+  assert(entry && "Contact point's stored cache entry is null!");
+  DEBUG_PRINTF("contact point of interaction %p destroyed\n", &*entry->interaction);
+
+  // the interaction is unlinked at the end of the next collision
+  // detection, with the other changes of the contact cache
+  entry->destroyed = true;
   return false;
 }
 
@@ -2553,7 +2755,10 @@ public:
       {
         impl.createCollisionObjectsForBodyContactorSet(bds);
       }
-      impl.updateAllShapesForDS(*bds);
+      // a sleeping body does not move
+      impl.updateActivationForDS(*bds);
+      if(!bds->isSleeping())
+        impl.updateAllShapesForDS(*bds);
     }
   }
   void visit(SP::RigidBody2dDS bds)
@@ -2564,12 +2769,225 @@ public:
       {
         impl.createCollisionObjectsForBodyContactorSet(bds);
       }
-      impl.updateAllShapesForDS(*bds);
+      // a sleeping body does not move
+      impl.updateActivationForDS(*bds);
+      if(!bds->isSleeping())
+        impl.updateAllShapesForDS(*bds);
     }
   }
 
 };
 
+/* Get the records of the collision objects of a contact point. The first
+ * record is always the one of the non-static object: if there is a static
+ * body, it is always associated with the second record. Returns false if
+ * both collision objects belong to the same body (or no body), no
+ * interaction is created then. */
+static bool contactPointRecords(const IterateContactPoints::ContactPointTuple& cp,
+                                const BodyBulletShapeRecord*& pairA,
+                                const BodyBulletShapeRecord*& pairB,
+                                bool& flip)
+{
+  pairA = reinterpret_cast<const BodyBulletShapeRecord*>(cp.objectA->getUserPointer());
+  pairB = reinterpret_cast<const BodyBulletShapeRecord*>(cp.objectB->getUserPointer());
+  assert(pairA && pairB && "btCollisionObject had a null user pointer!");
+
+  flip = false;
+  if(pairB->ds && !pairA->ds)
+  {
+    std::swap(pairA, pairB);
+    flip = true;
+  }
+  DEBUG_PRINTF("SiconosBulletCollisionManager :: flip = %i \n", flip);
+  return pairA->ds != pairB->ds;
+}
+
+/* True if the two bodies are already connected by another type of
+ * relation (e.g. EqualityCondition == they have a joint between them):
+ * no contact constraint is created then, because it leads to an
+ * ill-conditioned problem. Only the interactions of the first body are
+ * visited, through its edges in the graph of the dynamical systems. */
+static bool connectedByOtherRelation(DynamicalSystemsGraph& DSG0,
+                                     const BodyBulletShapeRecord* pairA,
+                                     const BodyBulletShapeRecord* pairB)
+{
+  if(!DSG0.is_vertex(pairA->ds))
+    return false;
+  DynamicalSystemsGraph::VDescriptor dsv = DSG0.descriptor(pairA->ds);
+  DynamicalSystemsGraph::OEIterator oei, oeiend;
+  for(std::tie(oei, oeiend) = DSG0.out_edges(dsv); oei != oeiend; ++oei)
+  {
+    // on an undirected graph, the target of an out edge is the other ds
+    if(&*DSG0.bundle(DSG0.target(*oei)) != &*pairB->ds)
+      continue;
+    SP::Interaction inter(DSG0.bundle(*oei));
+    SP::BulletR br(std::dynamic_pointer_cast<BulletR>(inter->relation()));
+    DEBUG_EXPR(std::cout << "br" << br << std::endl;);
+    if(!br)
+    {
+      DEBUG_PRINT("Only match on non-BulletR interactions, i.e. non-contact relations\n");
+      SP::NewtonEulerJointR jr(
+        std::dynamic_pointer_cast<NewtonEulerJointR>(inter->relation()));
+
+      /* If it is a joint, check the joint self-collide property */
+      if(jr && !jr->allowSelfCollide())
+        return true;
+
+      /* If any non-contact relation is found, both bodies must
+       * allow self-collide */
+      // We need to check for other type of dynamical systems.
+      SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
+      SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
+      if(!rbdsA->allowSelfCollide() || !rbdsB->allowSelfCollide())
+        return true;
+    }
+  }
+  return false;
+}
+
+/* Update the relation of a contact point which already has an interaction. */
+static void updateContactPointRelation(const IterateContactPoints::ContactPointTuple& cp,
+                                       const BodyBulletShapeRecord* pairA,
+                                       const BodyBulletShapeRecord* pairB,
+                                       bool flip, double worldScale)
+{
+  /* interaction already exists */
+  DEBUG_PRINT("SiconosBulletCollisionManager :: interaction already exists \n");
+  SP::Interaction inter =
+    static_cast<ContactCacheEntry*>(cp.point->m_userPersistentData)->interaction;
+
+
+  SP::BulletR rel_bulletR(std::dynamic_pointer_cast<BulletR>(inter->relation()));
+  SP::Bullet5DR rel_bullet5DR(std::dynamic_pointer_cast<Bullet5DR>(inter->relation()));
+  SP::Bullet2dR rel_bullet2dR(std::dynamic_pointer_cast<Bullet2dR>(inter->relation()));
+  SP::Bullet2d3DR rel_bullet2d3DR(std::dynamic_pointer_cast<Bullet2d3DR>(inter->relation()));
+
+  if(rel_bulletR || rel_bullet5DR)
+  {
+    DEBUG_PRINT("SiconosBulletCollisionManager :: BulletR case || rel_bullet5DR\n");
+    // We need to check for other type of dynamical systems.
+    SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
+    SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
+
+    /* update the relation */
+    SP::BulletR rel(std::static_pointer_cast<BulletR>(inter->relation()));
+    rel->updateContactPointsFromManifoldPoint(*cp.manifold, *cp.point,
+        flip, worldScale,
+        rbdsA,
+        rbdsB ? rbdsB
+        : SP::NewtonEulerDS());
+  }
+  else if(rel_bullet2dR)
+  {
+    DEBUG_PRINT("SiconosBulletCollisionManager :: Bullet2dR case");
+    // We need to check for other type of dynamical systems.
+    SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
+    SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
+
+    /* update the relation */
+    rel_bullet2dR->updateContactPointsFromManifoldPoint(*cp.manifold, *cp.point,
+        flip, worldScale,
+        rbdsA,
+        rbdsB ? rbdsB
+        : SP::RigidBody2dDS());
+  }
+  else if(rel_bullet2d3DR)
+  {
+    DEBUG_PRINT("SiconosBulletCollisionManager :: Bullet2d3DR case");
+    // We need to check for other type of dynamical systems.
+    SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
+    SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
+
+    /* update the relation */
+    rel_bullet2d3DR->updateContactPointsFromManifoldPoint(*cp.manifold, *cp.point,
+        flip, worldScale,
+        rbdsA,
+        rbdsB ? rbdsB
+        : SP::RigidBody2dDS());
+  }
+
+  else
+  {
+    THROW_EXCEPTION("Unknown relation type");
+  }
+}
+
+/* A contact point without interaction, with the ids of its bodies and
+ * its indices in the manifolds of the dispatcher. */
+struct NewContactPoint
+{
+  long bodyA, bodyB;
+  int manifold, index;
+  IterateContactPoints::ContactPointTuple cp;
+
+  bool operator<(const NewContactPoint& p) const
+  {
+    return std::tie(bodyA, bodyB, manifold, index)
+      < std::tie(p.bodyA, p.bodyB, p.manifold, p.index);
+  }
+};
+
+/* Loop over the manifolds, possibly in parallel: the relations of the
+ * existing interactions are updated, the contact points which need a new
+ * interaction are collected by manifold. */
+class UpdateContactPointsLoop : public btIParallelForBody
+{
+public:
+  btDispatcher* dispatcher;
+  DynamicalSystemsGraph* DSG0; // null if the equality constraints are not checked
+  double worldScale;
+  std::vector<std::vector<NewContactPoint> >* newPoints;
+
+  mutable std::atomic<int> processed;
+  mutable std::mutex mutex;
+  mutable std::exception_ptr error;
+
+  UpdateContactPointsLoop() : processed(0) {}
+
+  void forLoop(int iBegin, int iEnd) const
+  {
+    try
+    {
+      for(int i = iBegin; i < iEnd; ++i)
+      {
+        IterateContactPoints::ContactPointTuple cp;
+        cp.manifold = dispatcher->getManifoldByIndexInternal(i);
+        cp.objectA = cp.manifold->getBody0();
+        cp.objectB = cp.manifold->getBody1();
+        // the points of a manifold share their bodies: they are checked
+        // once for another relation, at the first point
+        int connected = -1;
+        for(int j = 0; j < cp.manifold->getNumContacts(); ++j)
+        {
+          cp.point = &cp.manifold->getContactPoint(j);
+          const BodyBulletShapeRecord *pairA, *pairB;
+          bool flip;
+          if(!contactPointRecords(cp, pairA, pairB, flip))
+            continue;
+          if(connected < 0)
+            connected = DSG0 && pairA->ds && pairB->ds
+                        && connectedByOtherRelation(*DSG0, pairA, pairB);
+          if(connected)
+            continue;
+          if(cp.point->m_userPersistentData)
+          {
+            updateContactPointRelation(cp, pairA, pairB, flip, worldScale);
+            processed++;
+          }
+          else
+            (*newPoints)[i].push_back({ contactBodyId(*pairA), contactBodyId(*pairB),
+                                        i, j, cp });
+        }
+      }
+    }
+    catch(...)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(!error) error = std::current_exception();
+    }
+  }
+};
+
 void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation)
 {
   DEBUG_BEGIN("SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation)\n");
@@ -2623,7 +3041,6 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
   std::cout << "[mechanics] -1 : addCollisionObject " << elapsed << " ms" << std::endl;
 #endif
   // 0. set up bullet callbacks
-  gSimulation = &*simulation;
   gContactDestroyedCallback = this->bulletContactClear;
   gContactAddedCallback = this->bulletContactAddedCallback;
 
@@ -2648,47 +3065,59 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
 
   DEBUG_PRINT("SiconosBulletCollisionManager :: iterating contact points:\n");
   //getchar();
-  // 2. deleted contact points have been removed from the graph during the
-  //    bullet collision detection callbacks
+  // 2. the contact points destroyed during the collision detection (or
+  //    since the last one) have been marked in the contact cache by the
+  //    bullet callbacks, their interactions are removed
+  ContactDiff diff;
+  _impl->_contactCache.removeDestroyed(diff.removed);
 
   // 3. for each contact point, if there is no interaction, create one
-  IterateContactPoints t(_impl->_collisionWorld);
-  IterateContactPoints::iterator it, itend=t.end();
   DEBUG_EXPR_WE(
+    IterateContactPoints t(_impl->_collisionWorld);
     int num_contact_points =0;
-    for(it=t.begin(); it!=itend; ++it)  num_contact_points++;
+    for(IterateContactPoints::iterator it=t.begin(); it!=t.end(); ++it)  num_contact_points++;
     std::cout << "Number of contacts points detected by bullet: " << num_contact_points << std::endl; );
 
-  for(it=t.begin(); it!=itend; ++it)
+  // The relations of the existing interactions are updated first, on the
+  // threads of the Bullet task scheduler in the parallel mode. The contact
+  // points without interaction are left to the loop below, since the
+  // creation of a relation may be overridden (e.g. from Python), and are
+  // sorted by bodies, then by manifold, so that the interactions are
+  // created in the same order whatever the order of the manifolds, which
+  // depends on the threads of the narrowphase.
+  btDispatcher* dispatcher = _impl->_collisionWorld->getDispatcher();
+  int numManifolds = dispatcher->getNumManifolds();
+  std::vector<std::vector<NewContactPoint> > newPoints(numManifolds);
+  UpdateContactPointsLoop loop;
+  loop.dispatcher = dispatcher;
+  loop.DSG0 = _with_equality_constraints ?
+    &*simulation->nonSmoothDynamicalSystem()->topology()->dSG(0) : nullptr;
+  loop.worldScale = _options.worldScale;
+  loop.newPoints = &newPoints;
+  if(_options.parallelCollisionDetection)
+    btParallelFor(0, numManifolds, 16, loop);
+  else
+    loop.forLoop(0, numManifolds);
+  if(loop.error)
+    std::rethrow_exception(loop.error);
+  _stats.existing_interactions_processed += loop.processed;
+
+  std::vector<NewContactPoint> points;
+  for(const auto& manifoldPoints : newPoints)
+    points.insert(points.end(), manifoldPoints.begin(), manifoldPoints.end());
+  std::sort(points.begin(), points.end());
+
+  for(const NewContactPoint& newPoint : points)
   {
-    DEBUG_PRINTF("\n\n\nSiconosBulletCollisionManager ::   -- %p, %p, %p\n", it->objectA, it->objectB, it->point);
+    const IterateContactPoints::ContactPointTuple& cp = newPoint.cp;
+    DEBUG_PRINTF("\n\n\nSiconosBulletCollisionManager ::   -- %p, %p, %p\n", cp.objectA, cp.objectB, cp.point);
 
     // Get the RigidBodyDS and SiconosShape pointers
-
     const BodyBulletShapeRecord *pairA, *pairB;
-    pairA = reinterpret_cast<const BodyBulletShapeRecord*>(it->objectA->getUserPointer());
-    pairB = reinterpret_cast<const BodyBulletShapeRecord*>(it->objectB->getUserPointer());
-    assert(pairA && pairB && "btCollisionObject had a null user pointer!");
-
-    // The first pair will always be the non-static object
-    // As a consequence, if there is a static body, it is always associated with second pair pairB
-    bool flip = false;
-    if(pairB->ds && !pairA->ds)
-    {
-      pairA = reinterpret_cast<const BodyBulletShapeRecord*>(it->objectB->getUserPointer());
-      pairB = reinterpret_cast<const BodyBulletShapeRecord*>(it->objectA->getUserPointer());
-      flip = true;
-    }
-    DEBUG_PRINTF("SiconosBulletCollisionManager :: flip = %i \n", flip);
-    // If both collision objects belong to the same body (or no body),
-    // no interaction is created.
-    if(pairA->ds == pairB->ds)
+    bool flip;
+    if(!contactPointRecords(cp, pairA, pairB, flip))
       continue;
 
-    // If the two bodies are already connected by another type of
-    // relation (e.g. EqualityCondition == they have a joint between
-    // them), then don't create contact constraints, because it leads
-    // to an ill-conditioned problem.
 
     DEBUG_EXPR_WE(
       if (pairA->ds && pairB->ds)
@@ -2705,331 +3134,230 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
       }
       );
 
-    DEBUG_PRINTF("SiconosBulletCollisionManager :: _with_equality_constraints  -- %i\n", _with_equality_constraints);
+    /* new interaction */
+    DEBUG_PRINT("SiconosBulletCollisionManager :: New interaction\n");
+    SP::Interaction inter;
 
+    int g1 = pairA->contactor->collision_group;
+    int g2 = pairB->contactor->collision_group;
+    SP::NonSmoothLaw nslaw = nonSmoothLaw(g1,g2);
 
-    if(_with_equality_constraints && pairA->ds && pairB->ds)
-    {
-      InteractionsGraph::VIterator ui, uiend;
-      SP::InteractionsGraph indexSet0 = simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
-      bool match = false;
-      for(std::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
-      {
-        SP::Interaction inter(indexSet0->bundle(*ui));
-        SP::SecondOrderDS ds1(std::dynamic_pointer_cast<SecondOrderDS>(
-                                indexSet0->properties(*ui).source));
-        SP::SecondOrderDS ds2(std::dynamic_pointer_cast<SecondOrderDS>(
-                                indexSet0->properties(*ui).target));
-        if(ds1 && ds2 && (((&*ds1==&*pairA->ds) && (&*ds2==&*pairB->ds))
-                          || ((&*ds1==&*pairB->ds) && (&*ds2==&*pairA->ds))))
-        {
-          SP::BulletR br(std::dynamic_pointer_cast<BulletR>(inter->relation()));
-          DEBUG_EXPR(std::cout << "br" << br << std::endl;);
-          if(!br)
-          {
-            DEBUG_PRINT("Only match on non-BulletR interactions, i.e. non-contact relations\n");
-            SP::NewtonEulerJointR jr(
-              std::dynamic_pointer_cast<NewtonEulerJointR>(inter->relation()));
-
-            /* If it is a joint, check the joint self-collide property */
-            if(jr && !jr->allowSelfCollide())
-              match = true;
-
-            /* If any non-contact relation is found, both bodies must
-             * allow self-collide */
-            // We need to check for other type of dynamical systems.
-            SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
-            SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
-            if(!rbdsA->allowSelfCollide() || !rbdsB->allowSelfCollide())
-              match = true;
-          }
-          if(match) break;
-        }
-      }
-      if(match)
-        continue;
-    }
-    DEBUG_PRINTF("SiconosBulletCollisionManager :: it->point->m_userPersistentData  %p \n", it->point->m_userPersistentData);
-    if(it->point->m_userPersistentData)
-    {
-      /* interaction already exists */
-      DEBUG_PRINT("SiconosBulletCollisionManager :: interaction already exists \n");
-      SP::Interaction *p_inter =
-        (SP::Interaction*)it->point->m_userPersistentData;
-
+    /* test nslaw type and then deduce the type of relation to be created */
+    SP::NewtonImpactFrictionNSL nslaw_NewtonImpactFrictionNSL(std::dynamic_pointer_cast<NewtonImpactFrictionNSL>(nslaw));
+    SP::FremondImpactFrictionNSL nslaw_FremondImpactFrictionNSL(std::dynamic_pointer_cast<FremondImpactFrictionNSL>(nslaw));
+    SP::NewtonImpactRollingFrictionNSL nslaw_NewtonImpactRollingFrictionNSL(std::dynamic_pointer_cast<NewtonImpactRollingFrictionNSL>(nslaw));
 
-      SP::BulletR rel_bulletR(std::dynamic_pointer_cast<BulletR>((*p_inter)->relation()));
-      SP::Bullet5DR rel_bullet5DR(std::dynamic_pointer_cast<Bullet5DR>((*p_inter)->relation()));
-      SP::Bullet2dR rel_bullet2dR(std::dynamic_pointer_cast<Bullet2dR>((*p_inter)->relation()));
-      SP::Bullet2d3DR rel_bullet2d3DR(std::dynamic_pointer_cast<Bullet2d3DR>((*p_inter)->relation()));
+    // DEBUG_EXPR(std::cout << nslaw_NewtonImpactFrictionNSL << std::endl;);
+    // DEBUG_EXPR(std::cout << nslaw_NewtonImpactRollingFrictionNSL << std::endl;);
 
-      if(rel_bulletR || rel_bullet5DR)
+    // we assume that this test checks if  we deal with 3D problem with RigidBodies
+    // Clearly, it will not be sufficient with meshed FE bodies.
+    if(nslaw && (nslaw_NewtonImpactFrictionNSL || nslaw_FremondImpactFrictionNSL))
+    {
+      if(nslaw->size() == 3)
       {
-        DEBUG_PRINT("SiconosBulletCollisionManager :: BulletR case || rel_bullet5DR\n");
-        // We need to check for other type of dynamical systems.
+        DEBUG_PRINT("Creation of a relation for 3D frictional contact\n");
         SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
         SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
 
-        /* update the relation */
-        SP::BulletR rel(std::static_pointer_cast<BulletR>((*p_inter)->relation()));
-        rel->updateContactPointsFromManifoldPoint(*it->manifold, *it->point,
-            flip, _options.worldScale,
-            rbdsA,
-            rbdsB ? rbdsB
-            : SP::NewtonEulerDS());
-      }
-      else if(rel_bullet2dR)
-      {
-        DEBUG_PRINT("SiconosBulletCollisionManager :: Bullet2dR case");
-        // We need to check for other type of dynamical systems.
-        SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
-        SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
+        SP::BulletR rel(makeBulletR(rbdsA, pairA->sshape,
+                                    rbdsB, pairB->sshape,
+                                    *cp.point));
+
+        if(!rel) continue;
 
-        /* update the relation */
-        rel_bullet2dR->updateContactPointsFromManifoldPoint(*it->manifold, *it->point,
+        // Fill in extra contact information
+        rel->bodyShapeRecordA = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairA));
+        rel->bodyShapeRecordB = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairB));
+        rel->btObject[0] = pairA->btobject;
+        rel->btObject[1] = pairB->btobject;
+
+        // TODO cast down btshape from BodyShapeRecord-derived classes
+        // rel->btShape[0] = pairA->btshape;
+        // rel->btShape[1] = pairB->btshape;
+
+        rel->updateContactPointsFromManifoldPoint(*cp.manifold, *cp.point,
             flip, _options.worldScale,
-            rbdsA,
-            rbdsB ? rbdsB
-            : SP::RigidBody2dDS());
+            rbdsA ? rbdsA : SP::NewtonEulerDS(),
+            rbdsB ? rbdsB : SP::NewtonEulerDS());
+
+        // We wish to be sure that no Interactions are created without
+        // sufficient warning before contact.  TODO: Replace with exception or
+        // flag.
+        if(rel->distance() < - WARNING_TOLERANCE_AT_CREATION_INTERACTION)
+        {
+          DEBUG_PRINTF("SiconosBulletCollisionManager :: Interactions must be created with positive "
+                       "distance (%f).\n", rel->distance());
+          _stats.interaction_warnings ++;
+        }
+
+        inter = std::make_shared<Interaction>(nslaw, rel);
+        _stats.new_interactions_created ++;
       }
-      else if(rel_bullet2d3DR)
+      else if(nslaw && nslaw->size() == 2)
       {
-        DEBUG_PRINT("SiconosBulletCollisionManager :: Bullet2d3DR case");
-        // We need to check for other type of dynamical systems.
+        DEBUG_PRINT("Creation of a relation for 2D frictional contact\n");
         SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
         SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
 
-        /* update the relation */
-        rel_bullet2d3DR->updateContactPointsFromManifoldPoint(*it->manifold, *it->point,
+        SP::Bullet2dR rel(makeBullet2dR(rbdsA, pairA->sshape,
+                                        rbdsB, pairB->sshape,
+                                        *cp.point));
+
+        if(!rel) continue;
+
+         // Fill in extra contact information
+        rel->bodyShapeRecordA = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairA));
+        rel->bodyShapeRecordB = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairB));
+        rel->btObject[0] = pairA->btobject;
+        rel->btObject[1] = pairB->btobject;
+
+        // TODO cast down btshape from BodyShapeRecord-derived classes
+        // rel->btShape[0] = pairA->btshape;
+        // rel->btShape[1] = pairB->btshape;
+
+        rel->updateContactPointsFromManifoldPoint(*cp.manifold, *cp.point,
             flip, _options.worldScale,
-            rbdsA,
-            rbdsB ? rbdsB
-            : SP::RigidBody2dDS());
-      }
+            rbdsA ? rbdsA : SP::RigidBody2dDS(),
+            rbdsB ? rbdsB : SP::RigidBody2dDS());
 
-      else
-      {
-        THROW_EXCEPTION("Unknown relation type");
+        // We wish to be sure that no Interactions are created without
+        // sufficient warning before contact.  TODO: Replace with exception or
+        // flag.
+        if(rel->distance() <  - WARNING_TOLERANCE_AT_CREATION_INTERACTION)
+        {
+          DEBUG_PRINTF("SiconosBulletCollisionManager :: Interactions must be created with positive "
+                       "distance (%f).\n", rel->distance());
+          _stats.interaction_warnings ++;
+        }
+        DEBUG_PRINT("SiconosBulletCollisionManager :: create 2d interaction\n");
+        inter = std::make_shared<Interaction>(nslaw, rel);
+        _stats.new_interactions_created ++;
       }
 
-
-      _stats.existing_interactions_processed ++;
     }
-    else
+    else if(nslaw && nslaw_NewtonImpactRollingFrictionNSL)
     {
-      /* new interaction */
-      DEBUG_PRINT("SiconosBulletCollisionManager :: New interaction\n");
-      SP::Interaction inter;
+      if(nslaw && nslaw->size() == 5)
+      {
+        DEBUG_PRINT("Creation of a relation for 3D Rolling frictional contact\n");
+        SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
+        SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
 
-      int g1 = pairA->contactor->collision_group;
-      int g2 = pairB->contactor->collision_group;
-      SP::NonSmoothLaw nslaw = nonSmoothLaw(g1,g2);
+        SP::Bullet5DR rel(makeBullet5DR(rbdsA, pairA->sshape,
+                                        rbdsB, pairB->sshape,
+                                        *cp.point));
 
-      /* test nslaw type and then deduce the type of relation to be created */
-      SP::NewtonImpactFrictionNSL nslaw_NewtonImpactFrictionNSL(std::dynamic_pointer_cast<NewtonImpactFrictionNSL>(nslaw));
-      SP::FremondImpactFrictionNSL nslaw_FremondImpactFrictionNSL(std::dynamic_pointer_cast<FremondImpactFrictionNSL>(nslaw));
-      SP::NewtonImpactRollingFrictionNSL nslaw_NewtonImpactRollingFrictionNSL(std::dynamic_pointer_cast<NewtonImpactRollingFrictionNSL>(nslaw));
+        if(!rel) continue;
 
-      // DEBUG_EXPR(std::cout << nslaw_NewtonImpactFrictionNSL << std::endl;);
-      // DEBUG_EXPR(std::cout << nslaw_NewtonImpactRollingFrictionNSL << std::endl;);
+        // Fill in extra contact information
+        rel->bodyShapeRecordA = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairA));
+        rel->bodyShapeRecordB = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairB));
+        rel->btObject[0] = pairA->btobject;
+        rel->btObject[1] = pairB->btobject;
 
-      // we assume that this test checks if  we deal with 3D problem with RigidBodies
-      // Clearly, it will not be sufficient with meshed FE bodies.
-      if(nslaw && (nslaw_NewtonImpactFrictionNSL || nslaw_FremondImpactFrictionNSL))
-      {
-        if(nslaw->size() == 3)
-        {
-          DEBUG_PRINT("Creation of a relation for 3D frictional contact\n");
-          SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
-          SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
-
-          SP::BulletR rel(makeBulletR(rbdsA, pairA->sshape,
-                                      rbdsB, pairB->sshape,
-                                      *it->point));
-
-          if(!rel) continue;
-
-          // Fill in extra contact information
-          rel->bodyShapeRecordA = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairA));
-          rel->bodyShapeRecordB = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairB));
-          rel->btObject[0] = pairA->btobject;
-          rel->btObject[1] = pairB->btobject;
-
-          // TODO cast down btshape from BodyShapeRecord-derived classes
-          // rel->btShape[0] = pairA->btshape;
-          // rel->btShape[1] = pairB->btshape;
-
-          rel->updateContactPointsFromManifoldPoint(*it->manifold, *it->point,
-              flip, _options.worldScale,
-              rbdsA ? rbdsA : SP::NewtonEulerDS(),
-              rbdsB ? rbdsB : SP::NewtonEulerDS());
-
-          // We wish to be sure that no Interactions are created without
-          // sufficient warning before contact.  TODO: Replace with exception or
-          // flag.
-          if(rel->distance() < - WARNING_TOLERANCE_AT_CREATION_INTERACTION)
-          {
-            DEBUG_PRINTF("SiconosBulletCollisionManager :: Interactions must be created with positive "
-                         "distance (%f).\n", rel->distance());
-            _stats.interaction_warnings ++;
-          }
+        // TODO cast down btshape from BodyShapeRecord-derived classes
+        // rel->btShape[0] = pairA->btshape;
+        // rel->btShape[1] = pairB->btshape;
 
-          inter = std::make_shared<Interaction>(nslaw, rel);
-          _stats.new_interactions_created ++;
-        }
-        else if(nslaw && nslaw->size() == 2)
+        rel->updateContactPointsFromManifoldPoint(*cp.manifold, *cp.point,
+            flip, _options.worldScale,
+            rbdsA ? rbdsA : SP::NewtonEulerDS(),
+            rbdsB ? rbdsB : SP::NewtonEulerDS());
+
+        // We wish to be sure that no Interactions are created without
+        // sufficient warning before contact.  TODO: Replace with exception or
+        // flag.
+        if(rel->distance() <  - WARNING_TOLERANCE_AT_CREATION_INTERACTION)
         {
-          DEBUG_PRINT("Creation of a relation for 2D frictional contact\n");
-          SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
-          SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
-
-          SP::Bullet2dR rel(makeBullet2dR(rbdsA, pairA->sshape,
-                                          rbdsB, pairB->sshape,
-                                          *it->point));
-
-          if(!rel) continue;
-
-           // Fill in extra contact information
-          rel->bodyShapeRecordA = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairA));
-          rel->bodyShapeRecordB = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairB));
-          rel->btObject[0] = pairA->btobject;
-          rel->btObject[1] = pairB->btobject;
-
-          // TODO cast down btshape from BodyShapeRecord-derived classes
-          // rel->btShape[0] = pairA->btshape;
-          // rel->btShape[1] = pairB->btshape;
-
-          rel->updateContactPointsFromManifoldPoint(*it->manifold, *it->point,
-              flip, _options.worldScale,
-              rbdsA ? rbdsA : SP::RigidBody2dDS(),
-              rbdsB ? rbdsB : SP::RigidBody2dDS());
-
-          // We wish to be sure that no Interactions are created without
-          // sufficient warning before contact.  TODO: Replace with exception or
-          // flag.
-          if(rel->distance() <  - WARNING_TOLERANCE_AT_CREATION_INTERACTION)
-          {
-            DEBUG_PRINTF("SiconosBulletCollisionManager :: Interactions must be created with positive "
-                         "distance (%f).\n", rel->distance());
-            _stats.interaction_warnings ++;
-          }
-          DEBUG_PRINT("SiconosBulletCollisionManager :: create 2d interaction\n");
-          inter = std::make_shared<Interaction>(nslaw, rel);
-          _stats.new_interactions_created ++;
+          DEBUG_PRINTF("Interactions must be created with positive "
+                       "distance (%f).\n", rel->distance());
+          _stats.interaction_warnings ++;
         }
 
+        inter = std::make_shared<Interaction>(nslaw, rel);
+        _stats.new_interactions_created ++;
       }
-      else if(nslaw && nslaw_NewtonImpactRollingFrictionNSL)
+      else if(nslaw && nslaw->size() == 3)
       {
-        if(nslaw && nslaw->size() == 5)
-        {
-          DEBUG_PRINT("Creation of a relation for 3D Rolling frictional contact\n");
-          SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
-          SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
-
-          SP::Bullet5DR rel(makeBullet5DR(rbdsA, pairA->sshape,
-                                          rbdsB, pairB->sshape,
-                                          *it->point));
-
-          if(!rel) continue;
-
-          // Fill in extra contact information
-          rel->bodyShapeRecordA = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairA));
-          rel->bodyShapeRecordB = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairB));
-          rel->btObject[0] = pairA->btobject;
-          rel->btObject[1] = pairB->btobject;
-
-          // TODO cast down btshape from BodyShapeRecord-derived classes
-          // rel->btShape[0] = pairA->btshape;
-          // rel->btShape[1] = pairB->btshape;
-
-          rel->updateContactPointsFromManifoldPoint(*it->manifold, *it->point,
-              flip, _options.worldScale,
-              rbdsA ? rbdsA : SP::NewtonEulerDS(),
-              rbdsB ? rbdsB : SP::NewtonEulerDS());
-
-          // We wish to be sure that no Interactions are created without
-          // sufficient warning before contact.  TODO: Replace with exception or
-          // flag.
-          if(rel->distance() <  - WARNING_TOLERANCE_AT_CREATION_INTERACTION)
-          {
-            DEBUG_PRINTF("Interactions must be created with positive "
-                         "distance (%f).\n", rel->distance());
-            _stats.interaction_warnings ++;
-          }
+        DEBUG_PRINT("Creation of a relation for 2D rolling frictional contact\n");
+        SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
+        SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
 
-          inter = std::make_shared<Interaction>(nslaw, rel);
-          _stats.new_interactions_created ++;
-        }
-        else if(nslaw && nslaw->size() == 3)
+        SP::Bullet2d3DR rel(makeBullet2d3DR(rbdsA, pairA->sshape,
+                                            rbdsB, pairB->sshape,
+                                            *cp.point));
+
+        if(!rel) continue;
+
+        // Fill in extra contact information
+        rel->bodyShapeRecordA = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairA));
+        rel->bodyShapeRecordB = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairB));
+        rel->btObject[0] = pairA->btobject;
+        rel->btObject[1] = pairB->btobject;
+
+        // TODO cast down btshape from BodyShapeRecord-derived classes
+        // rel->btShape[0] = pairA->btshape;
+        // rel->btShape[1] = pairB->btshape;
+
+        // TODO cast down btshape from BodyShapeRecord-derived classes
+        // rel->btShape[0] = pairA->btshape;
+        // rel->btShape[1] = pairB->btshape;
+
+        rel->updateContactPointsFromManifoldPoint(*cp.manifold, *cp.point,
+            flip, _options.worldScale,
+            rbdsA ? rbdsA : SP::RigidBody2dDS(),
+            rbdsB ? rbdsB : SP::RigidBody2dDS());
+
+        // We wish to be sure that no Interactions are created without
+        // sufficient warning before contact.  TODO: Replace with exception or
+        // flag.
+        if(rel->distance() <  - WARNING_TOLERANCE_AT_CREATION_INTERACTION)
         {
-          DEBUG_PRINT("Creation of a relation for 2D rolling frictional contact\n");
-          SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
-          SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
-
-          SP::Bullet2d3DR rel(makeBullet2d3DR(rbdsA, pairA->sshape,
-                                              rbdsB, pairB->sshape,
-                                              *it->point));
-
-          if(!rel) continue;
-
-          // Fill in extra contact information
-          rel->bodyShapeRecordA = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairA));
-          rel->bodyShapeRecordB = createSPtrBodyBulletShapeRecord(*const_cast<BodyBulletShapeRecord*>(pairB));
-          rel->btObject[0] = pairA->btobject;
-          rel->btObject[1] = pairB->btobject;
-
-          // TODO cast down btshape from BodyShapeRecord-derived classes
-          // rel->btShape[0] = pairA->btshape;
-          // rel->btShape[1] = pairB->btshape;
-
-          // TODO cast down btshape from BodyShapeRecord-derived classes
-          // rel->btShape[0] = pairA->btshape;
-          // rel->btShape[1] = pairB->btshape;
-
-          rel->updateContactPointsFromManifoldPoint(*it->manifold, *it->point,
-              flip, _options.worldScale,
-              rbdsA ? rbdsA : SP::RigidBody2dDS(),
-              rbdsB ? rbdsB : SP::RigidBody2dDS());
-
-          // We wish to be sure that no Interactions are created without
-          // sufficient warning before contact.  TODO: Replace with exception or
-          // flag.
-          if(rel->distance() <  - WARNING_TOLERANCE_AT_CREATION_INTERACTION)
-          {
-            DEBUG_PRINTF("SiconosBulletCollisionManager :: Interactions must be created with positive "
-                         "distance (%f).\n", rel->distance());
-            _stats.interaction_warnings ++;
-          }
-          DEBUG_PRINT("SiconosBulletCollisionManager :: create 2d interaction\n");
-          inter = std::make_shared<Interaction>(nslaw, rel);
-          _stats.new_interactions_created ++;
+          DEBUG_PRINTF("SiconosBulletCollisionManager :: Interactions must be created with positive "
+                       "distance (%f).\n", rel->distance());
+          _stats.interaction_warnings ++;
         }
+        DEBUG_PRINT("SiconosBulletCollisionManager :: create 2d interaction\n");
+        inter = std::make_shared<Interaction>(nslaw, rel);
+        _stats.new_interactions_created ++;
       }
-      else
+    }
+    else
+    {
+      if(nslaw && nslaw->size() == 1)
       {
-        if(nslaw && nslaw->size() == 1)
-        {
-          SP::Bullet1DR rel(
-            std::make_shared<Bullet1DR>(
-              createSPtrbtManifoldPoint(*it->point)));
-          inter = std::make_shared<Interaction>(nslaw, rel);
-        }
+        SP::Bullet1DR rel(
+          std::make_shared<Bullet1DR>(
+            createSPtrbtManifoldPoint(*cp.point)));
+        inter = std::make_shared<Interaction>(nslaw, rel);
       }
+    }
 
-      if(inter)
-      {
-        /* store interaction in the contact point data, it will be freed by the
-         * Bullet callback gContactDestroyedCallback */
-        /* note: storing pointer to shared_ptr! */
-        it->point->m_userPersistentData = (void*)(new SP::Interaction(inter));
-        DEBUG_PRINT("SiconosBulletCollisionManager :: link the interaction\n");
-        /* link bodies by the new interaction */
-        simulation->link(inter, pairA->ds, pairB->ds);
-      }
+    if(inter)
+    {
+      /* a contact point replaced by the collision detection (e.g. when
+       * its manifold is refreshed) gives its reaction to the new one */
+      if(_options.contactMatchingThreshold > 0.
+          && _impl->_contactCache.transferReaction(*inter, *pairA, *pairB, *cp.point,
+                                                   _options.contactMatchingThreshold))
+        _stats.interactions_warm_started ++;
+
+      /* store the interaction in the contact cache, the contact point
+       * keeps its entry, marked by the Bullet callback
+       * gContactDestroyedCallback when the point is destroyed */
+      cp.point->m_userPersistentData =
+        _impl->_contactCache.add(inter, *pairA, *pairB, *cp.point);
+      DEBUG_PRINT("SiconosBulletCollisionManager :: new interaction to link\n");
+      /* the bodies are linked by the new interaction with the other changes */
+      diff.added.push_back(std::make_tuple(inter, pairA->ds, pairB->ds));
     }
-    //getchar();
   }
+
+  _impl->_contactCache.clearDestroyed();
+
+  // 4. apply the changes to the topology at once
+  applyContactDiff(*simulation, diff, _stats);
   //getchar();
 #ifdef BULLET_TIMER
   end_old =end;
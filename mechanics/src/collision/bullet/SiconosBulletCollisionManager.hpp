@@ -63,6 +63,21 @@ public:
   bool enablePolyhedralContactClipping;
   double Depth2D;
   double extrapolationCoefficient;
+
+  /** dispatch the overlapping pairs of the narrowphase on the threads of
+   * the Bullet task scheduler (Bullet must be built with BT_THREADSAFE),
+   * and update the relations of the existing contact points in parallel */
+  bool parallelCollisionDetection;
+
+  /** number of threads of the Bullet task scheduler, 0 for its default */
+  unsigned int numberOfThreads;
+
+  /** a new contact point takes the reaction of a contact point of the
+   * same bodies destroyed by the same collision detection, if their
+   * local positions on both bodies differ by less than this distance
+   * (in Bullet units, as contactBreakingThreshold). 0 to disable.
+   * The reaction is the initial guess of the solver. */
+  double contactMatchingThreshold;
 };
 
 struct SiconosBulletStatistics
@@ -77,11 +92,14 @@ public:
     , existing_interactions_processed(0)
     , interaction_warnings(0)
     , interaction_destroyed(0)
+    , interactions_warm_started(0)
     {}
   int new_interactions_created;
   int existing_interactions_processed;
   int interaction_warnings;
   int interaction_destroyed;
+  /** new interactions which took the reaction of a destroyed one */
+  int interactions_warm_started;
 };
 
 class SiconosBulletCollisionManager : public SiconosCollisionManager
@@ -95,13 +113,13 @@ protected:
 
   void initialize_impl();
 
-  // callback for contact point removal, and a global for context
+  // callback for contact point removal: marks the entry of the contact
+  // in the contact cache of its manager
   static bool bulletContactClear(void* userPersistentData);
 
   // callback to modify the contact point when it has just been added in the manifold.
   static bool bulletContactAddedCallback(btManifoldPoint& cp, const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0,
                                          const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1);
-  static Simulation *gSimulation;
 
 public:
   SiconosBulletCollisionManager();
@@ -148,10 +166,13 @@ public:
    */
   void removeStaticBody(const SP::StaticBody& body);
 
-  /** Remove a body from the collision detector. This must be done
-   *  after removing a body from the NonSmoothDynamicalSystem
-   *  otherwise contact will occur with a non-graph body which results
-   *  in failure. */
+  /** Remove a body from the collision detector. A body removed from
+   *  the NonSmoothDynamicalSystem must be removed from the collision
+   *  detector before the next updateInteractions(), otherwise contact
+   *  will occur with a non-graph body which results in failure. The
+   *  interactions of the contact points of the body are unlinked by
+   *  the next updateInteractions(), unless they have been removed with
+   *  the body from the NonSmoothDynamicalSystem. */
   void removeBody(const SP::SecondOrderDS& body);
 
   void updateInteractions(SP::Simulation simulation);
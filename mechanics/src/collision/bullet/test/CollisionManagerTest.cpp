@@ -0,0 +1,218 @@
+#include "CollisionManagerTest.hpp"
+
+#include "SiconosContactor.hpp"
+#include "SiconosShape.hpp"
+#include "SiconosBulletCollisionManager.hpp"
+#include "RigidBodyDS.hpp"
+#include "SolverOptions.h"
+#include "SiconosKernel.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(CollisionManagerTest);
+
+void CollisionManagerTest::setUp() {}
+void CollisionManagerTest::tearDown() {}
+
+/* A pile of boxes and spheres falling on a static box, simulated with a
+ * Bullet collision manager. */
+struct Pile
+{
+  std::vector<SP::RigidBodyDS> bodies;
+  SP::NonSmoothDynamicalSystem nsds;
+  SP::TimeStepping simulation;
+  SP::SiconosBulletCollisionManager collisionMan;
+
+  Pile(const SiconosBulletOptions& options)
+  {
+    nsds.reset(new NonSmoothDynamicalSystem(0., 10.));
+
+    // 3 layers of 3x3 bodies, boxes and spheres alternately, slightly
+    // shifted so that the contacts are not symmetric
+    for(unsigned int k = 0; k < 27; ++k)
+    {
+      SP::SiconosVector q(new SiconosVector(7));
+      SP::SiconosVector v(new SiconosVector(6));
+      (*q)(0) = 1.1 * (k % 3) + 0.05 * (k / 9);
+      (*q)(1) = 1.1 * ((k / 3) % 3) - 0.03 * (k / 9);
+      (*q)(2) = 0.5 + 1.05 * (k / 9);
+      (*q)(3) = 1.;
+      SP::RigidBodyDS body(new RigidBodyDS(q, v, 1.));
+      SP::SiconosContactorSet contactors(new SiconosContactorSet());
+      if(k % 2)
+        contactors->push_back(std::make_shared<SiconosContactor>(
+                                std::make_shared<SiconosSphere>(0.5)));
+      else
+        contactors->push_back(std::make_shared<SiconosContactor>(
+                                std::make_shared<SiconosBox>(1., 1., 1.)));
+      body->setContactors(contactors);
+      SP::SiconosVector weight(new SiconosVector(3));
+      (*weight)(2) = -9.81;
+      body->setFExtPtr(weight);
+      nsds->insertDynamicalSystem(body);
+      bodies.push_back(body);
+    }
+
+    SP::TimeDiscretisation timedisc(new TimeDiscretisation(0., 0.005));
+    SP::FrictionContact osnspb(new FrictionContact(3));
+    osnspb->numericsSolverOptions()->iparam[SICONOS_IPARAM_MAX_ITER] = 1000;
+    osnspb->numericsSolverOptions()->dparam[SICONOS_DPARAM_TOL] = 1e-8;
+    osnspb->setMStorageType(NM_SPARSE_BLOCK);
+    simulation.reset(new TimeStepping(nsds, timedisc));
+    simulation->insertIntegrator(std::make_shared<MoreauJeanOSI>(0.5));
+    simulation->insertNonSmoothProblem(osnspb);
+
+    collisionMan.reset(new SiconosBulletCollisionManager(options));
+    simulation->insertInteractionManager(collisionMan);
+
+    SP::SiconosContactorSet ground(new SiconosContactorSet());
+    SP::SiconosVector position(new SiconosVector(7));
+    (*position)(2) = -5.;
+    (*position)(3) = 1.;
+    ground->push_back(std::make_shared<SiconosContactor>(
+                        std::make_shared<SiconosBox>(20., 20., 10.), position));
+    collisionMan->addStaticBody(ground);
+
+    collisionMan->insertNonSmoothLaw(
+      std::make_shared<NewtonImpactFrictionNSL>(0., 0., 0.5, 3), 0, 0);
+  }
+
+  /* the bodies and contact points of the interactions, in the order of
+   * the graph, with the bodies given by their index in the pile */
+  std::vector<double> interactions() const
+  {
+    std::map<size_t, double> index;
+    for(unsigned int k = 0; k < bodies.size(); ++k)
+      index[bodies[k]->number()] = k;
+
+    std::vector<double> result;
+    InteractionsGraph& indexSet0 = *nsds->topology()->indexSet0();
+    InteractionsGraph::VIterator vi, viend;
+    for(std::tie(vi, viend) = indexSet0.vertices(); vi != viend; ++vi)
+    {
+      result.push_back(index[indexSet0.properties(*vi).source->number()]);
+      result.push_back(index[indexSet0.properties(*vi).target->number()]);
+      NewtonEuler1DR& rel =
+        static_cast<NewtonEuler1DR&>(*indexSet0.bundle(*vi)->relation());
+      for(const SP::SiconosVector& v : { rel.pc1(), rel.pc2(), rel.nc() })
+        result.insert(result.end(), v->getArray(), v->getArray() + 3);
+    }
+    return result;
+  }
+
+  /* the number of interactions of a body */
+  unsigned int interactions(const DynamicalSystem& body) const
+  {
+    unsigned int count = 0;
+    InteractionsGraph& indexSet0 = *nsds->topology()->indexSet0();
+    InteractionsGraph::VIterator vi, viend;
+    for(std::tie(vi, viend) = indexSet0.vertices(); vi != viend; ++vi)
+      if(&*indexSet0.properties(*vi).source == &body
+         || &*indexSet0.properties(*vi).target == &body)
+        count++;
+    return count;
+  }
+
+  void step()
+  {
+    simulation->computeOneStep();
+    simulation->nextStep();
+  }
+};
+
+void CollisionManagerTest::t1()
+{
+  try
+  {
+    printf("\n==== t1\n");
+
+    SiconosBulletOptions options;
+    Pile serial(options);
+    options.parallelCollisionDetection = true;
+    options.numberOfThreads = 4;
+    Pile parallel(options);
+
+    unsigned int interactions = 0;
+    for(unsigned int k = 0; k < 200; ++k)
+    {
+      serial.simulation->computeOneStep();
+      parallel.simulation->computeOneStep();
+
+      std::vector<double> expected = serial.interactions();
+      CPPUNIT_ASSERT_MESSAGE("same interactions",
+                             parallel.interactions() == expected);
+      interactions = std::max(interactions, (unsigned int)expected.size() / 11);
+      for(unsigned int i = 0; i < serial.bodies.size(); ++i)
+        CPPUNIT_ASSERT_MESSAGE("same positions",
+                               *parallel.bodies[i]->q() == *serial.bodies[i]->q());
+
+      serial.simulation->nextStep();
+      parallel.simulation->nextStep();
+    }
+    printf("at most %u interactions\n", interactions);
+    CPPUNIT_ASSERT_MESSAGE("the bodies are in contact", interactions > 27);
+  }
+  catch(...)
+  {
+    Siconos::exception::process();
+    CPPUNIT_ASSERT(0);
+  }
+}
+
+void CollisionManagerTest::t2()
+{
+  try
+  {
+    printf("\n==== t2\n");
+
+    SiconosBulletOptions options;
+    Pile pile(options);
+    for(unsigned int k = 0; k < 100; ++k)
+      pile.step();
+
+    // a body of the bottom layer, in contact with the ground and the
+    // bodies above, stays in the system but no longer collides
+    RigidBodyDS& body = *pile.bodies[4];
+    unsigned int contacts = pile.interactions(body);
+    CPPUNIT_ASSERT_MESSAGE("the body is in contact", contacts > 1);
+    pile.collisionMan->removeBody(pile.bodies[4]);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("unlinked by the next collision detection",
+                                 contacts, pile.interactions(body));
+    pile.step();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("no interaction with the removed body",
+                                 0u, pile.interactions(body));
+    CPPUNIT_ASSERT_MESSAGE("interactions destroyed",
+                           pile.collisionMan->statistics().interaction_destroyed
+                           >= (int)contacts);
+    for(unsigned int k = 0; k < 20; ++k)
+    {
+      pile.step();
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("no new interaction with the removed body",
+                                   0u, pile.interactions(body));
+    }
+
+    // a body removed from the collision manager and the system, in this
+    // order as in siconos.io.mechanics_run: its interactions are removed
+    // with it, the next collision detection must skip them
+    SP::RigidBodyDS other = pile.bodies[13];
+    CPPUNIT_ASSERT_MESSAGE("the other body is in contact", pile.interactions(*other) > 0);
+    size_t interactions = pile.nsds->getNumberOfInteractions() - pile.interactions(*other);
+    pile.collisionMan->removeBody(other);
+    pile.nsds->removeDynamicalSystem(other);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("removed with the body",
+                                 interactions, pile.nsds->getNumberOfInteractions());
+    pile.step();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("no interaction with the removed body",
+                                 0u, pile.interactions(*other));
+    CPPUNIT_ASSERT_MESSAGE("not in the system",
+                           !pile.nsds->dynamicalSystems()->is_vertex(other));
+  }
+  catch(...)
+  {
+    Siconos::exception::process();
+    CPPUNIT_ASSERT(0);
+  }
+}
@@ -0,0 +1,51 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2024 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef CollisionManagerTest_h
+#define CollisionManagerTest_h
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class CollisionManagerTest : public CppUnit::TestFixture
+{
+private:
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(CollisionManagerTest);
+
+  // tests to be done ...
+  CPPUNIT_TEST(t1);
+  CPPUNIT_TEST(t2);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  // Members
+
+  // the parallel collision detection gives the interactions of the
+  // serial one, in the same order
+  void t1();
+
+  // the interactions of a body removed from the collision manager are
+  // unlinked by the next collision detection
+  void t2();
+
+public:
+  void setUp();
+  void tearDown();
+};
+
+#endif
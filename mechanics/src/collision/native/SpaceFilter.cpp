@@ -16,6 +16,7 @@
 #include "SphereNEDS.hpp"
 #include "SphereNEDSPlanR.hpp"
 #include "ExternalBody.hpp"
+#include "UniformGrid.hpp"
 #include <Simulation.hpp>
 #include <NonSmoothDynamicalSystem.hpp>
 #include <SimulationTypeDef.hpp>
@@ -62,6 +63,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
   _plans(plans),
   _moving_plans(moving_plans),
   _hash_table(new space_hash()),
+  _grid(new UniformGrid(_cellsize)),
   diskdisk_relations(new DiskDiskRDeclaredPool()),
   diskplan_relations(new DiskPlanRDeclaredPool()),
   circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -74,6 +76,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
   _cellsize(cellsize),
   _plans(plans),
   _hash_table(new space_hash()),
+  _grid(new UniformGrid(_cellsize)),
   diskdisk_relations(new DiskDiskRDeclaredPool()),
   diskplan_relations(new DiskPlanRDeclaredPool()),
   circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -81,6 +84,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
 
 SpaceFilter::SpaceFilter() :
   _hash_table(new space_hash()),
+  _grid(new UniformGrid()),
   diskdisk_relations(new DiskDiskRDeclaredPool()),
   diskplan_relations(new DiskPlanRDeclaredPool()),
   circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -99,103 +103,30 @@ public:
 
   void visit(SP::Disk pds)
   {
-    int i, j, imin, imax, jmin, jmax;
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for(i = imin; i <= imax; ++i)
-    {
-      for(j = jmin; j <= jmax; ++j)
-      {
-        parent.insert(pds, i, j, 0);
-      }
-    }
+    parent._grid->insert(pds->getQ(0), pds->getQ(1),
+                         parent.bboxfactor() * pds->getRadius());
+    parent._gridBodies.push_back(pds);
   };
 
   void visit(SP::Circle pds)
   {
-    int i, j, imin, imax, jmin, jmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for(i = imin; i <= imax; ++i)
-    {
-      for(j = jmin; j <= jmax; ++j)
-      {
-        parent.insert(pds, i, j, 0);
-      }
-    }
+    parent._grid->insert(pds->getQ(0), pds->getQ(1),
+                         parent.bboxfactor() * pds->getRadius());
+    parent._gridBodies.push_back(pds);
   }
 
   void visit(SP::SphereLDS pds)
   {
-    int i, j, k, imin, imax, jmin, jmax, kmin, kmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    kmin = (int) floor((pds->getQ(2) - _bboxfactor * pds->getRadius()) / _cellsize);
-    kmax = (int) floor((pds->getQ(2) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for(i = imin; i <= imax; ++i)
-    {
-      for(j = jmin; j <= jmax; ++j)
-      {
-        for(k = kmin; k <= kmax; ++k)
-        {
-          parent.insert(pds, i, j, k);
-        }
-      }
-    }
-
+    parent._grid->insert(pds->getQ(0), pds->getQ(1), pds->getQ(2),
+                         parent.bboxfactor() * pds->getRadius());
+    parent._gridBodies.push_back(pds);
   }
 
   void visit(SP::SphereNEDS pds)
   {
-    int i, j, k, imin, imax, jmin, jmax, kmin, kmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    kmin = (int) floor((pds->getQ(2) - _bboxfactor * pds->getRadius()) / _cellsize);
-    kmax = (int) floor((pds->getQ(2) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for(i = imin; i <= imax; ++i)
-    {
-      for(j = jmin; j <= jmax; ++j)
-      {
-        for(k = kmin; k <= kmax; ++k)
-        {
-          parent.insert(pds, i, j, k);
-        }
-      }
-    }
-
+    parent._grid->insert(pds->getQ(0), pds->getQ(1), pds->getQ(2),
+                         parent.bboxfactor() * pds->getRadius());
+    parent._gridBodies.push_back(pds);
   }
 
   void visit(SP::ExternalBody d)
@@ -993,13 +924,6 @@ void SpaceFilter::insert(SP::Hashed hashed)
 
 
 /* dynamical systems proximity detection */
-typedef std::pair<int, int> interPair;
-bool operator ==(interPair const& a, interPair const& b);
-bool operator ==(interPair const& a, interPair const& b)
-{
-  return ((a.first == b.first) && (a.second == b.second));
-}
-
 bool operator ==(std::pair<double, double> const& a,
                  std::pair<double, double> const& b);
 bool operator ==(std::pair<double, double> const& a,
@@ -1024,14 +948,32 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
 
   using SiconosVisitor::visit;
 
-  typedef boost::unordered_multiset < interPair,
-          boost::hash<interPair> > interPairs;
-
   SP::Simulation sim;
   SP::SpaceFilter parent;
   double time;
+
+  /* index of the visited body in the grid (the bodies are visited in
+   * the order of the hashing), and position of its first candidate
+   * pair */
+  unsigned int body;
+  size_t pair;
+
   _FindInteractions(SP::Simulation s, SP::SpaceFilter p, double time)
-    : sim(s), parent(p), time(time) {};
+    : sim(s), parent(p), time(time), body(0), pair(0) {};
+
+  /* check the proximity of the visited body with all the other
+   * systems that are in the same cells */
+  template<typename Filter>
+  void visit_neighbours(std::shared_ptr<Filter> filter)
+  {
+    const std::vector<UniformGrid::Pair>& pairs = parent->_grid->pairs();
+    assert(parent->_gridBodies[body] == filter->ds1);
+    for(; pair < pairs.size() && pairs[pair].first == body; ++pair)
+    {
+      parent->_gridBodies[pairs[pair].second]->acceptSP(filter);
+    }
+    ++body;
+  }
 
   void visit_circular(SP::CircularDS  ds1)
   {
@@ -1062,46 +1004,10 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
       }
     }
 
-    SP::SiconosVector Q1 = ds1->q();
-
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    SP::Hashed hds1(new Hashed(std::static_pointer_cast<DynamicalSystem>(ds1),
-                               (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize)));
-
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
-
-    unsigned int j;
-    interPairs declaredInteractions;
     std::shared_ptr<_CircularFilter>
     circularFilter(new _CircularFilter(sim, parent, ds1));
 
-    for(j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
-    {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if(ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if(declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(circularFilter);
-        }
-
-      }
-    }
+    visit_neighbours(circularFilter);
   };
 
   void visit(SP::Circle circle)
@@ -1127,48 +1033,10 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
                                    (*parent->_plans)(i, 3), ds1);
     }
 
-    SP::SiconosVector Q1 = ds1->q();
-
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    double z1 = Q1->getValue(2);
-    SP::Hashed hds1(new Hashed(ds1, (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize),
-                               (int) floor(z1 / parent->_cellsize)));
-
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
-
-    unsigned int j;
-    interPairs declaredInteractions;
-
     std::shared_ptr<_SphereLDSFilter> sphereFilter(
       new _SphereLDSFilter(sim, parent, ds1));
 
-    for(j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
-    {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if(ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if(declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(sphereFilter);
-        }
-
-      }
-    }
+    visit_neighbours(sphereFilter);
   }
 
 
@@ -1184,48 +1052,10 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
                                     (*parent->_plans)(i, 3), ds1);
     }
 
-    SP::SiconosVector Q1 = ds1->q();
-
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    double z1 = Q1->getValue(2);
-    SP::Hashed hds1(new Hashed(ds1, (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize),
-                               (int) floor(z1 / parent->_cellsize)));
-
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
-
-    unsigned int j;
-    interPairs declaredInteractions;
-
     std::shared_ptr<_SphereNEDSFilter> sphereFilter(
       new _SphereNEDSFilter(sim, parent, ds1));
 
-    for(j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
-    {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if(ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if(declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(sphereFilter);
-        }
-
-      }
-    }
+    visit_neighbours(sphereFilter);
   }
 
   void visit(SP::ExternalBody d)
@@ -1251,6 +1081,8 @@ void SpaceFilter::updateInteractions(SP::Simulation sim)
   findInteractions(new _FindInteractions(sim, shared_from_this(), time));
 
   _hash_table->clear();
+  _grid->clear();
+  _gridBodies.clear();
 
   // 1: rehash DS
   DynamicalSystemsGraph::VIterator vi, viend;
@@ -1260,6 +1092,8 @@ void SpaceFilter::updateInteractions(SP::Simulation sim)
     // to avoid cast see dual dispatch, visitor pattern
     DSG0->bundle(*vi)->acceptSP(hasher);
   }
+  _grid->setCellSize(_cellsize);
+  _grid->update();
 
   // 2: prox detection
   for(std::tie(vi, viend) = DSG0->vertices();
@@ -1277,6 +1111,14 @@ void SpaceFilter::updateInteractions(SP::Simulation sim)
 
 bool SpaceFilter::haveNeighbours(SP::Hashed h)
 {
+  bool found = false;
+  _grid->forEachInCell(h->i, h->j, h->k, [&found](unsigned int)
+  {
+    found = true;
+  });
+  if(found)
+    return true;
+
   std::pair<space_hash::iterator, space_hash::iterator> neighbours
     = _hash_table->equal_range(h);
   return (neighbours.first != neighbours.second);
@@ -1324,6 +1166,13 @@ double SpaceFilter::minDistance(SP::Hashed h)
 
     std::shared_ptr<_DiskDistance> distance(new _DiskDistance((*q)(0), (*q)(1), disk->getRadius()));
 
+    _grid->forEachInCell(h->i, h->j, h->k, [&](unsigned int b)
+    {
+      _gridBodies[b]->acceptSP(distance);
+
+      dmin = (std::min)(dmin, distance->result);
+    });
+
     for(; neighbours.first != neighbours.second; ++neighbours.first)
     {
       (*neighbours.first)->body->acceptSP(distance);
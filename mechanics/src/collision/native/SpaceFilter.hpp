@@ -41,12 +41,17 @@
 #include <SiconosSerialization.hpp>
 #include <SiconosVisitor.hpp>
 
+#include "UniformGrid.hpp"
+
+#include <vector>
+
 /* local forwards (see SpaceFilter_impl.hpp) */
 DEFINE_SPTR(space_hash);
 DEFINE_SPTR(DiskDiskRDeclaredPool);
 DEFINE_SPTR(DiskPlanRDeclaredPool);
 DEFINE_SPTR(CircleCircleRDeclaredPool);
 DEFINE_SPTR(Hashed);
+DEFINE_SPTR(UniformGrid);
 
 class SpaceFilter : public InteractionManager,
                     public std::enable_shared_from_this<SpaceFilter> {
@@ -68,9 +73,14 @@ protected:
   /** moving plans */
   SP::FMatrix _moving_plans;
 
-  /* the hash table */
+  /* the hash table, for the external bodies */
   SP::space_hash _hash_table;
 
+  /* the grid of the disks, circles and spheres, rebuilt at each
+   * update, and the bodies in the order of the grid */
+  SP::UniformGrid _grid;
+  std::vector<SP::DynamicalSystem> _gridBodies;
+
   /* relations pool */
   SP::DiskDiskRDeclaredPool diskdisk_relations;
   SP::DiskPlanRDeclaredPool diskplan_relations;
@@ -155,6 +165,12 @@ public:
 
   void setCellsize(unsigned int value) { _cellsize = value; }
 
+  /** \param parallel if true, the candidate pairs of the disks, circles
+   * and spheres are computed on the OpenMP threads (if siconos is built
+   * with OpenMP)
+   */
+  void setParallel(bool parallel) { _grid->setParallel(parallel); }
+
   /** get the neighbours
    * */
   //  std::pair<space_hash::iterator, space_hash::iterator>
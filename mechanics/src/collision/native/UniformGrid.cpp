@@ -0,0 +1,235 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2024 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UniformGrid.hpp"
+#include "SiconosConfig.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+//#define DEBUG_MESSAGES 1
+#include "siconos_debug.h"
+
+UniformGrid::Cell UniformGrid::_cell(double x, double y, double z, bool planar) const
+{
+  Cell c;
+  c.i = (int) floor(x / _cellsize);
+  c.j = (int) floor(y / _cellsize);
+  c.k = planar ? 0 : (int) floor(z / _cellsize);
+  return c;
+}
+
+size_t UniformGrid::_bucket(const Cell& c) const
+{
+  if(_dense)
+  {
+    size_t i = (size_t)((long int) c.i - _origin.i);
+    size_t j = (size_t)((long int) c.j - _origin.j);
+    size_t k = (size_t)((long int) c.k - _origin.k);
+    if(c.i < _origin.i || c.j < _origin.j || c.k < _origin.k
+        || j >= _nj || k >= _nk)
+      return _buckets;
+    size_t b = (i * _nj + j) * _nk + k;
+    return b < _buckets ? b : _buckets;
+  }
+  else
+  {
+    // Teschner et al. hash function, the number of buckets is a power of 2
+    size_t h = ((size_t)(unsigned int) c.i * 73856093u)
+               ^ ((size_t)(unsigned int) c.j * 19349663u)
+               ^ ((size_t)(unsigned int) c.k * 83492791u);
+    return h & (_buckets - 1);
+  }
+}
+
+void UniformGrid::clear()
+{
+  _x.clear();
+  _y.clear();
+  _z.clear();
+  _radius.clear();
+  _planar.clear();
+  _pairs.clear();
+  _buckets = 0;
+}
+
+unsigned int UniformGrid::insert(double x, double y, double z, double radius)
+{
+  _x.push_back(x);
+  _y.push_back(y);
+  _z.push_back(z);
+  _radius.push_back(radius);
+  _planar.push_back(false);
+  return _x.size() - 1;
+}
+
+unsigned int UniformGrid::insert(double x, double y, double radius)
+{
+  _x.push_back(x);
+  _y.push_back(y);
+  _z.push_back(0.);
+  _radius.push_back(radius);
+  _planar.push_back(true);
+  return _x.size() - 1;
+}
+
+void UniformGrid::update()
+{
+  size_t n = _x.size();
+  _pairs.clear();
+  _buckets = 0;
+  if(!n) return;
+
+  // 1: cells of the bodies
+  _home.resize(n);
+  _min.resize(n);
+  _max.resize(n);
+  size_t entries = 0;
+  for(size_t a = 0; a < n; ++a)
+  {
+    double r = _radius[a];
+    _home[a] = _cell(_x[a], _y[a], _z[a], _planar[a]);
+    _min[a] = _cell(_x[a] - r, _y[a] - r, _z[a] - r, _planar[a]);
+    _max[a] = _cell(_x[a] + r, _y[a] + r, _z[a] + r, _planar[a]);
+    entries += (size_t)(_max[a].i - _min[a].i + 1) * (_max[a].j - _min[a].j + 1)
+               * (_max[a].k - _min[a].k + 1);
+  }
+
+  // 2: numbering of the cells, dense if the box of the bodies has not
+  // many more cells than there are entries
+  Cell last = _max[0];
+  _origin = _min[0];
+  for(size_t a = 1; a < n; ++a)
+  {
+    _origin.i = std::min(_origin.i, _min[a].i);
+    _origin.j = std::min(_origin.j, _min[a].j);
+    _origin.k = std::min(_origin.k, _min[a].k);
+    last.i = std::max(last.i, _max[a].i);
+    last.j = std::max(last.j, _max[a].j);
+    last.k = std::max(last.k, _max[a].k);
+  }
+  double ni = (double) last.i - _origin.i + 1;
+  double nj = (double) last.j - _origin.j + 1;
+  double nk = (double) last.k - _origin.k + 1;
+  _dense = ni * nj * nk <= 4. * entries + 64.;
+  if(_dense)
+  {
+    _nj = (size_t) nj;
+    _nk = (size_t) nk;
+    _buckets = (size_t)(ni * nj * nk);
+  }
+  else
+  {
+    _buckets = 64;
+    while(_buckets < 2 * entries)
+      _buckets *= 2;
+  }
+  DEBUG_PRINTF("UniformGrid: %zu bodies, %zu entries, %zu buckets (%s)\n",
+               n, entries, _buckets, _dense ? "dense" : "hashed");
+
+  // 3: counting sort of the (cell, body) entries
+  _start.assign(_buckets + 1, 0);
+  for(size_t a = 0; a < n; ++a)
+  {
+    Cell c;
+    for(c.i = _min[a].i; c.i <= _max[a].i; ++c.i)
+      for(c.j = _min[a].j; c.j <= _max[a].j; ++c.j)
+        for(c.k = _min[a].k; c.k <= _max[a].k; ++c.k)
+          ++_start[_bucket(c) + 1];
+  }
+  for(size_t b = 0; b < _buckets; ++b)
+    _start[b + 1] += _start[b];
+
+  _bodies.resize(entries);
+  _cells.resize(entries);
+  for(size_t a = 0; a < n; ++a)
+  {
+    Cell c;
+    for(c.i = _min[a].i; c.i <= _max[a].i; ++c.i)
+      for(c.j = _min[a].j; c.j <= _max[a].j; ++c.j)
+        for(c.k = _min[a].k; c.k <= _max[a].k; ++c.k)
+        {
+          size_t e = _start[_bucket(c)]++;
+          _bodies[e] = a;
+          _cells[e] = c;
+        }
+  }
+  // _start[b] is now the end of bucket b
+  for(size_t b = _buckets; b > 0; --b)
+    _start[b] = _start[b - 1];
+  _start[0] = 0;
+
+  // 4: candidate pairs, in increasing order of the first body
+#ifdef WITH_OPENMP
+  if(_parallel && n > 1 && omp_get_max_threads() > 1)
+  {
+    int nthreads = omp_get_max_threads();
+    _threadPairs.resize(nthreads);
+    for(std::vector<Pair>& pairs : _threadPairs)
+      pairs.clear();
+
+    // with a static schedule, thread t gets the t-th range of bodies
+    #pragma omp parallel num_threads(nthreads)
+    {
+      std::vector<Pair>& pairs = _threadPairs[omp_get_thread_num()];
+      #pragma omp for schedule(static)
+      for(long int a = 0; a < (long int) n; ++a)
+        _findPairs(a, pairs);
+    }
+
+    size_t size = 0;
+    for(const std::vector<Pair>& pairs : _threadPairs)
+      size += pairs.size();
+    _pairs.reserve(size);
+    for(const std::vector<Pair>& pairs : _threadPairs)
+      _pairs.insert(_pairs.end(), pairs.begin(), pairs.end());
+    return;
+  }
+#endif
+
+  for(size_t a = 0; a < n; ++a)
+    _findPairs(a, _pairs);
+}
+
+void UniformGrid::_findPairs(unsigned int a, std::vector<Pair>& pairs) const
+{
+  const Cell& h = _home[a];
+  size_t b = _bucket(h);
+  for(size_t e = _start[b]; e < _start[b + 1]; ++e)
+  {
+    unsigned int other = _bodies[e];
+    if(other == a || !(_cells[e] == h))
+      continue;
+
+    // the pair has already been found from the other body if the
+    // bounding box of a overlaps its cell
+    if(other < a)
+    {
+      const Cell& ho = _home[other];
+      if(_min[a].i <= ho.i && ho.i <= _max[a].i
+          && _min[a].j <= ho.j && ho.j <= _max[a].j
+          && _min[a].k <= ho.k && ho.k <= _max[a].k)
+        continue;
+    }
+    pairs.push_back(Pair(a, other));
+  }
+}
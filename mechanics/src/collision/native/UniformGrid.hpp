@@ -0,0 +1,182 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2024 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*! \file UniformGrid.hpp
+ *  \brief Uniform grid broad phase for the native collision detection
+ */
+
+#ifndef UniformGrid_hpp
+#define UniformGrid_hpp
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/** Broad phase contact detection on a uniform grid, used by SpaceFilter.
+ *
+ *  The bodies are given by their center and the radius of their bounding
+ *  box, stored in arrays (one per coordinate). Each body is put in all
+ *  the cells of size cellsize overlapped by its bounding box, and these
+ *  (cell, body) entries are sorted by cell with a counting sort: the
+ *  cells are numbered densely if the bounding box of the bodies has few
+ *  cells, else they are hashed.
+ *
+ *  A pair of bodies (a, b) is a candidate if the bounding box of b
+ *  overlaps the cell of the center of a (the neighbours of SpaceFilter).
+ *  Each candidate pair is found once, from the first body a (in the
+ *  order of insertion) whose cell is overlapped by the other one. The
+ *  pairs are stored in one array, sorted by this first body. They are
+ *  computed on the OpenMP threads if parallel is set.
+ */
+class UniformGrid
+{
+public:
+
+  /** a candidate pair: the body whose cell is searched, and the other one */
+  typedef std::pair<unsigned int, unsigned int> Pair;
+
+private:
+
+  /** a cell of the grid */
+  struct Cell
+  {
+    int i, j, k;
+    bool operator==(const Cell& c) const
+    {
+      return i == c.i && j == c.j && k == c.k;
+    }
+  };
+
+  double _cellsize;
+
+  bool _parallel = false;
+
+  /* bodies */
+  std::vector<double> _x;
+  std::vector<double> _y;
+  std::vector<double> _z;
+  std::vector<double> _radius;
+  /** true for a 2D body, which only overlaps the cells k = 0 */
+  std::vector<unsigned char> _planar;
+
+  /* cell of the center of each body, and cells overlapped by its
+   * bounding box */
+  std::vector<Cell> _home;
+  std::vector<Cell> _min;
+  std::vector<Cell> _max;
+
+  /* numbering of the cells: dense in the bounding box of the bodies
+   * starting at _origin, or hashed */
+  Cell _origin;
+  size_t _nj, _nk;
+  bool _dense;
+  size_t _buckets = 0;
+
+  /* entries sorted by bucket: the entries of bucket b are at
+   * positions [_start[b], _start[b+1]) */
+  std::vector<size_t> _start;
+  std::vector<unsigned int> _bodies;
+  std::vector<Cell> _cells;
+
+  std::vector<Pair> _pairs;
+
+  /* pairs found by each thread */
+  std::vector<std::vector<Pair>> _threadPairs;
+
+  Cell _cell(double x, double y, double z, bool planar) const;
+
+  size_t _bucket(const Cell& c) const;
+
+  void _findPairs(unsigned int a, std::vector<Pair>& pairs) const;
+
+public:
+
+  /** constructor
+   * \param cellsize the size of a cell
+   */
+  UniformGrid(double cellsize = 1.) : _cellsize(cellsize) {};
+
+  /** \param cellsize the size of a cell */
+  void setCellSize(double cellsize)
+  {
+    _cellsize = cellsize;
+  };
+
+  /** \return the size of a cell */
+  double cellSize() const
+  {
+    return _cellsize;
+  };
+
+  /** \param parallel if true, the pairs are found on the OpenMP threads */
+  void setParallel(bool parallel)
+  {
+    _parallel = parallel;
+  };
+
+  /** remove all the bodies (the memory is kept for the next update) */
+  void clear();
+
+  /** add a 3D body
+   * \param x, y, z center
+   * \param radius radius of the bounding box
+   * \return the index of the body
+   */
+  unsigned int insert(double x, double y, double z, double radius);
+
+  /** add a 2D body, in the plane z = 0
+   * \param x, y center
+   * \param radius radius of the bounding box
+   * \return the index of the body
+   */
+  unsigned int insert(double x, double y, double radius);
+
+  /** \return the number of bodies */
+  size_t size() const
+  {
+    return _x.size();
+  };
+
+  /** sort the bodies by cell and find the candidate pairs */
+  void update();
+
+  /** \return the candidate pairs found by update() */
+  const std::vector<Pair>& pairs() const
+  {
+    return _pairs;
+  };
+
+  /** apply a function to the index of each body whose bounding box
+   *  overlaps a cell, after update()
+   *  \param i, j, k the cell
+   *  \param f the function
+   */
+  template<typename F>
+  void forEachInCell(int i, int j, int k, F f) const
+  {
+    if(!_buckets) return;
+    Cell c = {i, j, k};
+    size_t b = _bucket(c);
+    if(b == _buckets) return;
+    for(size_t e = _start[b]; e < _start[b + 1]; ++e)
+      if(_cells[e] == c)
+        f(_bodies[e]);
+  };
+};
+
+#endif
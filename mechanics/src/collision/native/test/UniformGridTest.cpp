@@ -0,0 +1,127 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2024 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "UniformGridTest.hpp"
+#include "UniformGrid.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <set>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(UniformGridTest);
+
+
+void UniformGridTest::setUp()
+{
+}
+
+void UniformGridTest::tearDown()
+{
+}
+
+/* compare the candidate pairs of the grid with all the pairs (a, b)
+ * such that the bounding box of b overlaps the cell of a. The bodies are
+ * in two clusters of size spread, at a distance separation: far apart
+ * clusters make the grid hash the cells while keeping many pairs. */
+static void check_pairs(double spread, double separation, double cellsize,
+                        bool planar, bool parallel)
+{
+  UniformGrid grid(cellsize);
+  grid.setParallel(parallel);
+
+  srand(1);
+  unsigned int n = 300;
+  std::vector<double> x(n), y(n), z(n), r(n);
+  for(unsigned int a = 0; a < n; ++a)
+  {
+    double center = (a % 2) ? separation / 2. : -separation / 2.;
+    x[a] = center + spread * (rand() / (double)RAND_MAX - .5);
+    y[a] = center + spread * (rand() / (double)RAND_MAX - .5);
+    z[a] = planar ? 0. : center + spread * (rand() / (double)RAND_MAX - .5);
+    r[a] = 3. * rand() / (double)RAND_MAX;
+    if(planar)
+      grid.insert(x[a], y[a], r[a]);
+    else
+      grid.insert(x[a], y[a], z[a], r[a]);
+  }
+  grid.update();
+
+  auto overlaps = [&](unsigned int b, unsigned int a)
+  {
+    bool result = true;
+    const std::vector<double>* coordinates[3] = { &x, &y, &z };
+    for(unsigned int d = 0; d < (planar ? 2 : 3); ++d)
+    {
+      const std::vector<double>& c = *coordinates[d];
+      result = result && floor((c[b] - r[b]) / cellsize) <= floor(c[a] / cellsize)
+               && floor(c[a] / cellsize) <= floor((c[b] + r[b]) / cellsize);
+    }
+    return result;
+  };
+
+  std::set<std::pair<unsigned int, unsigned int>> expected, found;
+  for(unsigned int a = 0; a < n; ++a)
+    for(unsigned int b = 0; b < n; ++b)
+      if(a != b && overlaps(b, a))
+        expected.insert(std::make_pair(std::min(a, b), std::max(a, b)));
+  CPPUNIT_ASSERT_MESSAGE("many candidate pairs", expected.size() > n);
+
+  unsigned int previous = 0;
+  for(const UniformGrid::Pair& p : grid.pairs())
+  {
+    CPPUNIT_ASSERT_MESSAGE("pairs sorted", p.first >= previous);
+    CPPUNIT_ASSERT_MESSAGE("candidate pair", overlaps(p.second, p.first));
+    CPPUNIT_ASSERT_MESSAGE("pair found once",
+                           found.insert(std::make_pair(std::min(p.first, p.second),
+                                                       std::max(p.first, p.second))).second);
+    previous = p.first;
+  }
+  CPPUNIT_ASSERT_MESSAGE("all the pairs are found", found == expected);
+
+  unsigned int count = 0, expectedCount = 0;
+  grid.forEachInCell((int) floor(x[0] / cellsize), (int) floor(y[0] / cellsize),
+                     planar ? 0 : (int) floor(z[0] / cellsize),
+                     [&count](unsigned int)
+  {
+    ++count;
+  });
+  for(unsigned int b = 0; b < n; ++b)
+    if(overlaps(b, 0)) ++expectedCount;
+  CPPUNIT_ASSERT_EQUAL(expectedCount, count);
+}
+
+// 3D, dense numbering of the cells
+void UniformGridTest::t1()
+{
+  check_pairs(20., 0., 2., false, false);
+  check_pairs(20., 0., 2., false, true);
+}
+
+// 3D, hashed cells
+void UniformGridTest::t2()
+{
+  check_pairs(20., 1e4, 2., false, false);
+  check_pairs(20., 1e4, 2., false, true);
+}
+
+// 2D
+void UniformGridTest::t3()
+{
+  check_pairs(30., 0., 3., true, false);
+  check_pairs(30., 1e4, 3., true, false);
+}
@@ -28,7 +28,11 @@ if(WITH_TESTING)
   new_test(SOURCES NumericsArrays.c)
 
   #  tests for NumericsMatrix
-  new_test(SOURCES NM_test.c DEPS "${suitesparse}")
+  if(WITH_OPENMP)
+    new_test(SOURCES NM_test.c DEPS "${suitesparse};OpenMP::OpenMP_C")
+  else()
+    new_test(SOURCES NM_test.c DEPS "${suitesparse}")
+  endif()
 
   #  tests for JordanAlgebra
   NEW_TEST(NAME tools_test_JordanAlgebra SOURCES JordanAlgebra_test.c)
@@ -161,6 +165,9 @@ if(WITH_TESTING)
   new_tests_collection(
     DRIVER fc_test_collection.c.in FORMULATION fc3d COLLECTION TEST_NSGS_COLLECTION_FREEZE_2
     EXTRA_SOURCES data_collection_2.c test_nsgs_freeze_1.c)
+  new_tests_collection(
+    DRIVER fc_test_collection.c.in FORMULATION fc3d COLLECTION TEST_NSGS_COLLECTION_COLORING_2
+    EXTRA_SOURCES data_collection_2.c test_nsgs_coloring_1.c)
 
   new_tests_collection(
     DRIVER fc_test_collection.c.in FORMULATION fc3d COLLECTION TEST_NSGS_COLLECTION_3
@@ -216,6 +223,19 @@ if(WITH_TESTING)
   new_test(SOURCES fc3d_LmgcDriver_test4.c)
   new_test(SOURCES fc3d_LmgcDriver_test5.c)
 
+  # --- concurrent calls to fc3d_driver ---
+  if(CMAKE_USE_PTHREADS_INIT)
+    if(WITH_FCLIB)
+      new_test(NAME fc3d_test_threads
+        SOURCES fc3d_test_threads.c data_collection_fclib.c test_nsgs_1.c
+        DEPS "FCLIB::fclib;Threads::Threads" HDF5 ON)
+    else()
+      new_test(NAME fc3d_test_threads
+        SOURCES fc3d_test_threads.c data_collection_1.c test_nsgs_1.c
+        DEPS Threads::Threads)
+    endif()
+  endif()
+
   # ---------------------------------------------------
   # --- Global friction contact problem formulation ---
   # ---------------------------------------------------
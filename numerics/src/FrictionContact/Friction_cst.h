@@ -258,6 +258,8 @@ enum SICONOS_FRICTION_3D_NSGS_IPARAM
   SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT =19,
   /** index in iparam to store the  */
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION =14,
+  /** index in iparam to store the sweep strategy (serial or colored) */
+  SICONOS_FRICTION_3D_NSGS_COLORING =11,
 };
 enum SICONOS_FRICTION_3D_NSGS_DPARAM
 {
@@ -308,6 +310,15 @@ enum SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_ENUM
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_FALSE =0,
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE =1
 };
+enum SICONOS_FRICTION_3D_NSGS_COLORING_ENUM
+{
+  /** contacts are swept one after the other */
+  SICONOS_FRICTION_3D_NSGS_COLORING_FALSE =0,
+  /** contacts are grouped by colors of the block graph of M (contacts
+      sharing a body get different colors) and the contacts of a color
+      are solved concurrently (OpenMP threads) */
+  SICONOS_FRICTION_3D_NSGS_COLORING_TRUE =1
+};
 
 enum SICONOS_FRICTION_3D_NSN_IPARAM
 {
@@ -625,4 +636,11 @@ enum SICONOS_FRICTION_3D_IPM_IPARAM_CHOLESKY_ENUM
   SICONOS_FRICTION_3D_IPM_IPARAM_CHOLESKY_NO = 0,
   SICONOS_FRICTION_3D_IPM_IPARAM_CHOLESKY_YES = 1
 };
+
+enum SICONOS_FRICTION_3D_BATCH_INFO
+{
+  /** info of fc3d_driver_batch for a problem whose solve has been stopped
+      by a fatal error, distinct from the info of the solvers */
+  SICONOS_FRICTION_3D_BATCH_FATAL_ERROR = -100
+};
 #endif
@@ -27,6 +27,7 @@
 #include "SparseBlockMatrix.h"       // for SparseBlockStructuredMatrix, SBM...
 #include "fc2d_Solvers.h"            // for fc2d_cpg, fc2d_enum
 #include "numerics_verbose.h"        // for numerics_error, verbose, numeric...
+#include "tlsdef.h"                  // for tlsvar
 
 const char* const   SICONOS_FRICTION_2D_NSGS_STR  = "FC2D_NSGS";
 const char* const   SICONOS_FRICTION_2D_CPG_STR  = "FC2D_CPG";
@@ -34,11 +35,11 @@ const char* const   SICONOS_FRICTION_2D_LEMKE_STR  = "FC2D_LEMKE";
 const char* const   SICONOS_FRICTION_2D_ENUM_STR  = "FC2D_ENUM";
 //#define DUMP_PROBLEM
 #ifdef DUMP_PROBLEM
-static int fccounter = 0;
+static tlsvar int fccounter = 0;
 #endif
 //#define DUMP_PROBLEM_IF_INFO
 #ifdef DUMP_PROBLEM_IF_INFO
-static int fccounter = 0;
+static tlsvar int fccounter = 0;
 #endif
 
 
@@ -26,7 +26,7 @@
 #include "fc3d_Solvers.h"            // for fc3d_DeSaxceFixedPoint, fc3d_DeS...
 #include "fc3d_compute_error.h"      // for fc3d_compute_error
 #include "numerics_verbose.h"        // for verbose, numerics_error
-#include "projectionOnCone.h"        // for projectionOnCone
+#include "projectionOnCone.h"        // for projectionOnCone_DeSaxce_batch
 #include "SiconosBlas.h"                   // for cblas_dcopy, cblas_dnrm2
 
 void fc3d_DeSaxceFixedPoint(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options)
@@ -51,8 +51,6 @@ void fc3d_DeSaxceFixedPoint(FrictionContactProblem* problem, double *reaction, d
   int iter = 0; /* Current iteration number */
   double error = 1.; /* Current error */
   int hasNotConverged = 1;
-  int contact; /* Number of the current row of blocks in M */
-  int nLocal = 3;
   double * velocitytmp = (double *)calloc(n, sizeof(double));
 
   double rho = 0.0;
@@ -85,15 +83,7 @@ void fc3d_DeSaxceFixedPoint(FrictionContactProblem* problem, double *reaction, d
     NM_gemv(alpha, M, reaction, beta, velocitytmp);
 
     /* projection for each contact */
-    for(contact = 0 ; contact < nc ; ++contact)
-    {
-      int pos = contact * nLocal;
-      double  normUT = sqrt(velocitytmp[pos + 1] * velocitytmp[pos + 1] + velocitytmp[pos + 2] * velocitytmp[pos + 2]);
-      reaction[pos] -= rho * (velocitytmp[pos] + mu[contact] * normUT);
-      reaction[pos + 1] -= rho * velocitytmp[pos + 1];
-      reaction[pos + 2] -= rho * velocitytmp[pos + 2];
-      projectionOnCone(&reaction[pos], mu[contact]);
-    }
+    projectionOnCone_DeSaxce_batch(reaction, velocitytmp, mu, rho, nc);
 
     /* **** Criterium convergence **** */
     fc3d_compute_error(problem, reaction, velocity, tolerance, options, norm_q, &error);
@@ -29,7 +29,7 @@
 #include "fc3d_Solvers.h"            // for fc3d_ExtraGradient, fc3d_ExtraGr...
 #include "fc3d_compute_error.h"      // for fc3d_compute_error
 #include "numerics_verbose.h"        // for verbose
-#include "projectionOnCone.h"        // for projectionOnCone
+#include "projectionOnCone.h"        // for projectionOnCone_DeSaxce_batch
 #include "SiconosBlas.h"                   // for cblas_dcopy, cblas_dnrm2, cblas_...
 
 void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options)
@@ -121,27 +121,11 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
 
       NM_gemv(alpha, M, reactiontmp, beta, velocitytmp);
       // projection for each contact
-      for(contact = 0 ; contact < nc ; ++contact)
-      {
-        int pos = contact * nLocal;
-        double  normUT = sqrt(velocitytmp[pos + 1] * velocitytmp[pos + 1] + velocitytmp[pos + 2] * velocitytmp[pos + 2]);
-        reactiontmp[pos] -= rho * (velocitytmp[pos] + mu[contact] * normUT);
-        reactiontmp[pos + 1] -= rho * velocitytmp[pos + 1];
-        reactiontmp[pos + 2] -= rho * velocitytmp[pos + 2];
-        projectionOnCone(&reactiontmp[pos], mu[contact]);
-      }
+      projectionOnCone_DeSaxce_batch(reactiontmp, velocitytmp, mu, rho, nc);
       cblas_dcopy(n, q, 1, velocitytmp, 1);
       NM_gemv(alpha, M, reactiontmp, beta, velocitytmp);
       // projection for each contact
-      for(contact = 0 ; contact < nc ; ++contact)
-      {
-        int pos = contact * nLocal;
-        double  normUT = sqrt(velocitytmp[pos + 1] * velocitytmp[pos + 1] + velocitytmp[pos + 2] * velocitytmp[pos + 2]);
-        reaction[pos] -= rho * (velocitytmp[pos] + mu[contact] * normUT);
-        reaction[pos + 1] -= rho * velocitytmp[pos + 1];
-        reaction[pos + 2] -= rho * velocitytmp[pos + 2];
-        projectionOnCone(&reaction[pos], mu[contact]);
-      }
+      projectionOnCone_DeSaxce_batch(reaction, velocitytmp, mu, rho, nc);
 
       /* **** Criterium convergence **** */
       fc3d_compute_error(problem, reaction, velocity, tolerance, options, norm_q, &error);
@@ -190,19 +174,7 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
         rho_k = rho * pow(tau,ls_iter);
 
         /* projection for each contact */
-        for(contact = 0 ; contact < nc ; ++contact)
-        {
-          int pos = contact * nLocal;
-          double  normUT = sqrt(velocity_k[pos + 1] * velocity_k[pos + 1] + velocity_k[pos + 2] * velocity_k[pos + 2]);
-          /* reaction[pos] = reaction_k[pos] -  rho_k * (velocity_k[pos] + mu[contact] * normUT); */
-          /* reaction[pos + 1] = reaction_k[pos+1] - rho_k * velocity_k[pos + 1]; */
-          /* reaction[pos + 2] = reaction_k[pos+2] - rho_k * velocity_k[pos + 2]; */
-
-          reaction[pos] -= rho_k * (velocity_k[pos] + mu[contact] * normUT);
-          reaction[pos + 1] -= rho_k * velocity_k[pos + 1];
-          reaction[pos + 2] -= rho_k * velocity_k[pos + 2];
-          projectionOnCone(&reaction[pos], mu[contact]);
-        }
+        projectionOnCone_DeSaxce_batch(reaction, velocity_k, mu, rho_k, nc);
 
 
         /* velocity <- q + M * reaction  */
@@ -266,19 +238,7 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
       NM_gemv(alpha, M, reaction, beta, velocitytmp);
 
       // projection for each contact
-      for(contact = 0 ; contact < nc ; ++contact)
-      {
-        int pos = contact * nLocal;
-        double  normUT = sqrt(velocitytmp[pos + 1] * velocitytmp[pos + 1] +
-                              velocitytmp[pos + 2] * velocitytmp[pos + 2]);
-        reaction[pos] -= rho_k * (velocitytmp[pos] + mu[contact] * normUT);
-        reaction[pos + 1] -= rho_k * velocitytmp[pos + 1];
-        reaction[pos + 2] -= rho_k * velocitytmp[pos + 2];
-        /* reaction[pos] = reaction_k[pos] -  rho_k * (velocitytmp[pos] + mu[contact] * normUT); */
-        /* reaction[pos + 1] = reaction_k[pos+1] - rho_k * velocitytmp[pos + 1]; */
-        /* reaction[pos + 2] = reaction_k[pos+2] - rho_k * velocitytmp[pos + 2]; */
-        projectionOnCone(&reaction[pos], mu[contact]);
-      }
+      projectionOnCone_DeSaxce_batch(reaction, velocitytmp, mu, rho_k, nc);
       DEBUG_EXPR_WE(for(int i =0; i< 5 ; i++)
     {
       printf("reaction[%i]=%12.8e\t",i,reaction[i]);
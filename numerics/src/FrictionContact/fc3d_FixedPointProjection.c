@@ -30,7 +30,7 @@
 #include "fc3d_Solvers.h"            // for fc3d_fixedPointProjection, fc3d_...
 #include "fc3d_compute_error.h"      // for fc3d_compute_error
 #include "numerics_verbose.h"        // for verbose
-#include "projectionOnCone.h"        // for projectionOnCone
+#include "projectionOnCone.h"        // for projectionOnCone_DeSaxce_batch
 #include "SiconosBlas.h"                   // for cblas_dcopy, cblas_dnrm2, cblas_...
 
 void fc3d_fixedPointProjection(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options)
@@ -134,20 +134,7 @@ void fc3d_fixedPointProjection(FrictionContactProblem* problem, double *reaction
 
 
         /* projection for each contact */
-        for(contact = 0 ; contact < nc ; ++contact)
-        {
-          int pos = contact * nLocal;
-          double  normUT = sqrt(velocity_k[pos + 1] * velocity_k[pos + 1] + velocity_k[pos + 2] * velocity_k[pos + 2]);
-          /* reaction[pos] = reaction_k[pos] -  rho_k * (velocity_k[pos] + mu[contact] * normUT); */
-          /* reaction[pos + 1] = reaction_k[pos+1] - rho_k * velocity_k[pos + 1]; */
-          /* reaction[pos + 2] = reaction_k[pos+2] - rho_k * velocity_k[pos + 2]; */
-
-          reaction[pos] -= rho_k * (velocity_k[pos] + mu[contact] * normUT);
-          reaction[pos + 1] -= rho_k * velocity_k[pos + 1];
-          reaction[pos + 2] -= rho_k * velocity_k[pos + 2];
-
-          projectionOnCone(&reaction[pos], mu[contact]);
-        }
+        projectionOnCone_DeSaxce_batch(reaction, velocity_k, mu, rho_k, nc);
 
 
         /* velocity <- q + M * reaction  */
@@ -35,8 +35,9 @@
 #include "string.h"                  // for strcpy, strcat
 #include "fclib_interface.h"         // for frictionContact_fclib_write, fri...
 #endif
+#include "tlsdef.h"                  // for tlsvar
 
-static int fccounter = -1;
+static tlsvar int fccounter = -1;
 
 int fc3d_LmgcDriver(double *reaction,
                     double *velocity,
@@ -26,16 +26,17 @@
 #include "fc3d_NCPGlockerFixedPoint.h"  // for F_GlockerFixedP, fc3d_FixedP_...
 #include "fc3d_Solvers.h"               // for FreeSolverPtr, PostSolverPtr
 #include "SiconosBlas.h"                      // for cblas_dcopy
+#include "tlsdef.h"                           // for tlsvar
 
 /* Pointer to function used to update the solver, to formalize the local problem for example. */
 typedef void (*UpdateSolverPtr)(int, double*);
 
-static UpdateSolverPtr updateSolver = NULL;
-static PostSolverPtr postSolver = NULL;
-static FreeSolverPtr freeSolver = NULL;
+static tlsvar UpdateSolverPtr updateSolver = NULL;
+static tlsvar PostSolverPtr postSolver = NULL;
+static tlsvar FreeSolverPtr freeSolver = NULL;
 
 /* size of a block */
-static int Fsize;
+static tlsvar int Fsize;
 
 /** writes \f$ F(z) \f$ using Glocker formulation
  */
@@ -87,7 +87,9 @@ extern "C" {
     absolute error at the end SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT
     (2) : only light error computation (velocity not computed)
     SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE (3) :  we adapt the
-    frequency of the full erro evaluation.
+    frequency of the full erro evaluation. Between two evaluations, the full
+    error is estimated from the light error, and it is computed as soon as
+    the estimate is below the tolerance.
 
     [in] iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION(14)] : filter
     local solution if the local error is greater than 1.0
@@ -109,6 +111,12 @@ extern "C" {
     [in] iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE_SEED(6)] : seed for the random
     generator in shuffling  contacts
 
+    [in] iparam[SICONOS_FRICTION_3D_NSGS_COLORING(11)] : sweep strategy
+    SICONOS_FRICTION_3D_NSGS_COLORING_FALSE (0) : serial sweep
+    SICONOS_FRICTION_3D_NSGS_COLORING_TRUE (1) : contacts are grouped by colors
+    of the contact graph and each color is swept in parallel (OpenMP).
+    Falls back to the serial sweep if shuffle or freezing is required.
+
     [out] iparam[SICONOS_IPARAM_ITER_DONE(1)] = iter number of performed
     iterations
 
@@ -30,7 +30,7 @@
 /* #define DEBUG_MESSAGES */
 #include "siconos_debug.h"                   // for DEBUG_PRINTF, DEBUG_EXPR, DEBUG_...
 #include "numerics_verbose.h"        // for numerics_error
-#include "projectionOnCone.h"        // for projectionOnCone
+#include "projectionOnCone.h"        // for projectionOnCone, projectionOnCone_DeSaxce_residual_batch
 #include "projectionOnCylinder.h"    // for projectionOnCylinder
 #ifdef DEBUG_MESSAGES
 #include "NumericsVector.h"
@@ -83,14 +83,8 @@ int fc3d_compute_error(
   /* DEBUG_EXPR(NV_display(w,n);); */
   /* DEBUG_EXPR(NV_display(z,n);); */
 
-  *error = 0.;
-  int ic, ic3;
-  double worktmp[3];
-  for(ic = 0, ic3 = 0 ; ic < nc ; ic++, ic3 += 3)
-  {
-    fc3d_unitary_compute_and_add_error(z + ic3, w + ic3, mu[ic], error, worktmp);
-    /*DEBUG_PRINTF("absolute error = %12.8e contact =%i nc= %i\n", *error, ic, nc);*/
-  }
+  /* same as fc3d_unitary_compute_and_add_error for each contact */
+  *error = projectionOnCone_DeSaxce_residual_batch(z, w, mu, nc);
   *error = sqrt(*error);
   DEBUG_PRINTF("absolute error in complementarity = %12.8e\n", *error);
 
@@ -18,7 +18,10 @@
 #include <assert.h>                                    // for assert
 #include <float.h>                                     // for DBL_EPSILON
 #include <stdio.h>                                     // for NULL
+#include <stdlib.h>                                    // for malloc, qsort
 #include <string.h>                                     // for NULL
+#include <time.h>                                      // for clock_gettime
+#include "CSparseMatrix.h"                            // for CSparseMatrix_symbolic_cache_clear
 #include "FrictionContactProblem.h"                    // for FrictionContac...
 #include "Friction_cst.h"                              // for SICONOS_FRICTI...
 #include "NonSmoothDrivers.h"                          // for fc3d_driver
@@ -32,6 +35,11 @@
 #include "fc3d_projection.h"                           // for fc3d_projectio...
 #include "fc3d_unitary_enumerative.h"                  // for fc3d_unitary_e...
 #include "numerics_verbose.h"                          // for numerics_printf
+#include "sn_error_handling.h"                         // for SN_SETJMP_EXT...
+#include "SiconosConfig.h"                             // for WITH_OPENMP // IWYU pragma: keep
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 const char* const   SICONOS_FRICTION_3D_NSGS_STR = "FC3D_NSGS";
 const char* const   SICONOS_FRICTION_3D_NSGSV_STR = "FC3D_NSGSV";
@@ -323,3 +331,103 @@ int fc3d_checkTrivialCase(FrictionContactProblem* problem, double* velocity,
   numerics_printf("fc3d fc3d_checkTrivialCase, take off, trivial solution reaction = 0, velocity = q.\n");
   return 0;
 }
+
+/* problem of a batch and its size, used to schedule the largest problems first */
+typedef struct
+{
+  int index;
+  int size;
+} fc3d_batch_item;
+
+static int fc3d_batch_item_compare(const void* a, const void* b)
+{
+  const fc3d_batch_item* ia = (const fc3d_batch_item*)a;
+  const fc3d_batch_item* ib = (const fc3d_batch_item*)b;
+  if(ia->size != ib->size)
+    return ib->size - ia->size;
+  return ia->index - ib->index;
+}
+
+static double fc3d_batch_wtime(void)
+{
+#ifdef WITH_OPENMP
+  return omp_get_wtime();
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + 1e-9 * (double)t.tv_nsec;
+#endif
+}
+
+/* A fatal error in a solver stops only the solve of the current problem.
+ * The internal jmp buffer cannot be nested, and the solvers may set it
+ * themselves: the error is caught with the external one. It is saved
+ * and restored, since the caller of fc3d_driver_batch may use it (the
+ * master thread solves problems too). */
+static int fc3d_driver_batch_solve(FrictionContactProblem* problem,
+                                   double *reaction, double *velocity,
+                                   SolverOptions* options)
+{
+  int info = -1;
+  jmp_buf saved_jmp_buf;
+  int saved_jmp_buf_used = sn_save_jmp_buf(&saved_jmp_buf);
+  int info_jmp = SN_SETJMP_EXTERNAL_START;
+  if(info_jmp == SN_NO_ERROR)
+  {
+    info = fc3d_driver(problem, reaction, velocity, options);
+    SN_SETJMP_EXTERNAL_STOP
+  }
+  else
+  {
+    numerics_warning("fc3d_driver_batch", "fatal error: %s", sn_fatal_error_msg());
+    info = SICONOS_FRICTION_3D_BATCH_FATAL_ERROR;
+  }
+  sn_restore_jmp_buf(&saved_jmp_buf, saved_jmp_buf_used);
+  return info;
+}
+
+int fc3d_driver_batch(int number_of_problems,
+                      FrictionContactProblem** problems,
+                      double **reactions, double **velocities,
+                      SolverOptions** options,
+                      int* info, double* time)
+{
+  /* Problems are sorted by decreasing number of contacts and distributed
+   * one by one to the threads as they become idle, so that the small
+   * problems balance the load at the end of the batch. */
+  fc3d_batch_item* items = (fc3d_batch_item*)malloc(number_of_problems * sizeof(fc3d_batch_item));
+  for(int i = 0; i < number_of_problems; ++i)
+  {
+    items[i].index = i;
+    items[i].size = problems[i]->numberOfContacts;
+  }
+  qsort(items, number_of_problems, sizeof(fc3d_batch_item), fc3d_batch_item_compare);
+
+  int number_of_failures = 0;
+#ifdef WITH_OPENMP
+#pragma omp parallel reduction(+:number_of_failures)
+#endif
+  {
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for(int k = 0; k < number_of_problems; ++k)
+    {
+      int i = items[k].index;
+      double start = fc3d_batch_wtime();
+      int info_i = fc3d_driver_batch_solve(problems[i], reactions[i], velocities[i], options[i]);
+      if(time)
+        time[i] = fc3d_batch_wtime() - start;
+      if(info)
+        info[i] = info_i;
+      if(info_i)
+        number_of_failures++;
+    }
+    /* the symbolic analyses cached by the worker would otherwise stay
+     * allocated as long as its thread lives */
+    CSparseMatrix_symbolic_cache_clear();
+  }
+
+  free(items);
+  return number_of_failures;
+}
@@ -25,6 +25,9 @@
 #include "Friction_cst.h"                              // for SICONOS_FRICTI...
 #include "NumericsArrays.h"                            // for uint_shuffle
 #include "NumericsFwd.h"                               // for SolverOptions
+#include "NumericsMatrix.h"                            // for NM_block_coloring
+#include "NumericsSparseMatrix.h"                      // for NSM_CSR
+#include "SparseBlockMatrix.h"                         // for SBM_diagonal_b...
 #include "SolverOptions.h"                             // for SolverOptions
 #include "fc3d_2NCP_Glocker.h"                         // for NCPGlocker_update
 #include "fc3d_NCPGlockerFixedPoint.h"                 // for fc3d_FixedP_in...
@@ -37,15 +40,20 @@
 #include "fc3d_unitary_enumerative.h"                  // for fc3d_unitary_e...
 #include "numerics_verbose.h"                          // for numerics_printf
 #include "SiconosBlas.h"                                     // for cblas_dnrm2
+#include "SiconosConfig.h"                             // for WITH_OPENMP // IWYU pragma: keep
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 /* #define DEBUG_STDOUT */
 /* #define DEBUG_MESSAGES */
 #include "siconos_debug.h"                                     // for DEBUG_EXPR
+#include "tlsdef.h"                                            // for tlsvar
 
 
 //#define FCLIB_OUTPUT
 
 #ifdef FCLIB_OUTPUT
-static int fccounter = -1;
+static tlsvar int fccounter = -1;
 #include "fclib_interface.h"
 #endif
 
@@ -417,29 +425,49 @@ double calculateLightError(double light_error_sum, unsigned int nc, double *reac
   return error;
 }
 
+/* With SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE, the full error
+ * is estimated between two evaluations from the light error of the sweep,
+ * scaled by the ratio full/light error observed at the last full
+ * evaluation (*error_ratio, negative if unknown). The full error is then
+ * also computed as soon as this estimate reaches the tolerance, so that
+ * the convergence is not delayed by a large evaluation interval. */
 static
 double calculateFullErrorAdaptiveInterval(FrictionContactProblem *problem,
     ComputeErrorPtr computeError,
     SolverOptions *options, int iter,
     double *reaction, double *velocity,
-    double tolerance, double norm_q)
+    double tolerance, double norm_q,
+    double light_error, double *error_ratio)
 {
   double error=1e+24;
-  if(options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY] >0)
+  int adaptive = (options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION]
+                  == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE);
+  int estimate_available = adaptive && (*error_ratio >= 0.0);
+  double estimated_error = estimate_available ? *error_ratio * light_error : error;
+
+  if(options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY] >0 || estimate_available)
   {
-    if(iter % options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY] == 0)
+    int frequency = options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY];
+    if((frequency > 0 && iter % frequency == 0) || estimated_error < tolerance)
     {
       (*computeError)(problem, reaction, velocity, tolerance, options, norm_q,  &error);
-      if(error > tolerance
-          && options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE)
+      if(adaptive && light_error > 0.0)
+        *error_ratio = error / light_error;
+      if(error > tolerance && adaptive && frequency > 0)
         options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY] *= 2;
     }
+    else
+      error = estimated_error;
     numerics_printf("--------------- FC3D - NSGS - Iteration %i "
                     "options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY] = %i, options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] = % i",
                     iter, options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY], options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION]);
   }
   else
+  {
     (*computeError)(problem, reaction, velocity, tolerance, options, norm_q,  &error);
+    if(adaptive && light_error > 0.0)
+      *error_ratio = error / light_error;
+  }
 
   return error;
 }
@@ -562,6 +590,203 @@ void statsIterationCallback(FrictionContactProblem *problem,
 
 
 
+/* Data of the colored sweep. Contacts are sorted by colors of the block
+ * graph of M: the contacts of a color are uncoupled and are solved
+ * concurrently, each thread working on its own local problem and on its
+ * own copy of the local solver parameters (dWork, which stores per-contact
+ * data, is shared). */
+typedef struct
+{
+  unsigned int number_of_colors;
+  unsigned int *color_start; /* first position of each color in contacts */
+  unsigned int *contacts;    /* contacts sorted by colors */
+  int number_of_threads;
+  FrictionContactProblem **localproblems;
+  SolverOptions **localsolver_options;
+} NSGSColoring;
+
+static
+int isColoringAvailable(FrictionContactProblem *problem, SolverOptions *options)
+{
+  int* iparam = options->iparam;
+  if(iparam[SICONOS_FRICTION_3D_NSGS_COLORING] != SICONOS_FRICTION_3D_NSGS_COLORING_TRUE)
+    return 0;
+
+  if(problem->M->storageType != NM_SPARSE_BLOCK && problem->M->storageType != NM_SPARSE)
+  {
+    numerics_warning("fc3d_nsgs", "the colored sweep needs a sparse matrix M, contacts are swept serially.");
+    return 0;
+  }
+  if(iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] != SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE
+      || iparam[SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT] > 0)
+  {
+    numerics_warning("fc3d_nsgs", "the colored sweep is not compatible with shuffled or frozen contacts, contacts are swept serially.");
+    return 0;
+  }
+  switch(options->internalSolvers[0]->solverId)
+  {
+  /* local solvers that only work on the local problem, on the local
+     solver parameters and on per-contact entries of dWork */
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN:
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN_GP:
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID:
+  case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnCone:
+  case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithDiagonalization:
+  case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithLocalIteration:
+    return 1;
+  default:
+    numerics_warning("fc3d_nsgs", "the colored sweep is not available for the local solver %s, contacts are swept serially.",
+                     solver_options_id_to_name(options->internalSolvers[0]->solverId));
+    return 0;
+  }
+}
+
+static
+NSGSColoring* NSGSColoring_new(FrictionContactProblem *problem,
+                               SolverOptions *localsolver_options)
+{
+  unsigned int nc = problem->numberOfContacts;
+  NSGSColoring* coloring = (NSGSColoring*)malloc(sizeof(NSGSColoring));
+
+  unsigned int *color = (unsigned int *)malloc(nc * sizeof(unsigned int));
+  coloring->number_of_colors = NM_block_coloring(problem->M, 3, color);
+
+  /* Sort contacts by colors */
+  coloring->color_start = (unsigned int *)calloc(coloring->number_of_colors + 1, sizeof(unsigned int));
+  coloring->contacts = (unsigned int *)malloc(nc * sizeof(unsigned int));
+  for(unsigned int i = 0 ; i < nc ; ++i)
+    coloring->color_start[color[i] + 1]++;
+  for(unsigned int c = 0 ; c < coloring->number_of_colors ; ++c)
+    coloring->color_start[c + 1] += coloring->color_start[c];
+  unsigned int *position = (unsigned int *)malloc((coloring->number_of_colors + 1) * sizeof(unsigned int));
+  memcpy(position, coloring->color_start, (coloring->number_of_colors + 1) * sizeof(unsigned int));
+  for(unsigned int i = 0 ; i < nc ; ++i)
+    coloring->contacts[position[color[i]]++] = i;
+  free(position);
+  free(color);
+
+  numerics_printf_verbose(1, "---- FC3D - NSGS - colored sweep: %i contacts, %i colors",
+                          nc, coloring->number_of_colors);
+
+  /* The data of M that are built on demand (diagonal blocks positions,
+     compressed row form) must not be computed concurrently during the
+     sweep: they are computed once here. */
+  if(problem->M->storageType == NM_SPARSE_BLOCK)
+  {
+    SBM_diagonal_block_indices(problem->M->matrix1);
+  }
+  else
+  {
+    NM_csc(problem->M);
+    if(problem->M->matrix2->origin == NSM_CSR)
+      NM_csr(problem->M);
+    else
+      NM_csc_trans(problem->M);
+  }
+
+  coloring->number_of_threads = 1;
+#ifdef WITH_OPENMP
+  coloring->number_of_threads = omp_get_max_threads();
+#endif
+  coloring->localproblems = (FrictionContactProblem **)
+    malloc(coloring->number_of_threads * sizeof(FrictionContactProblem *));
+  coloring->localsolver_options = (SolverOptions **)
+    malloc(coloring->number_of_threads * sizeof(SolverOptions *));
+  for(int t = 0; t < coloring->number_of_threads; ++t)
+  {
+    coloring->localproblems[t] = fc3d_local_problem_allocate(problem);
+    SolverOptions * thread_options = (SolverOptions *)malloc(sizeof(SolverOptions));
+    memcpy(thread_options, localsolver_options, sizeof(SolverOptions));
+    thread_options->iparam = (int *)malloc(localsolver_options->iSize * sizeof(int));
+    thread_options->dparam = (double *)malloc(localsolver_options->dSize * sizeof(double));
+    coloring->localsolver_options[t] = thread_options;
+  }
+  return coloring;
+}
+
+static
+void NSGSColoring_free(NSGSColoring *coloring, FrictionContactProblem *problem)
+{
+  for(int t = 0; t < coloring->number_of_threads; ++t)
+  {
+    fc3d_local_problem_free(coloring->localproblems[t], problem);
+    /* dWork and internal solvers belong to the local solver options */
+    free(coloring->localsolver_options[t]->iparam);
+    free(coloring->localsolver_options[t]->dparam);
+    free(coloring->localsolver_options[t]);
+  }
+  free(coloring->localproblems);
+  free(coloring->localsolver_options);
+  free(coloring->color_start);
+  free(coloring->contacts);
+  free(coloring);
+}
+
+static
+double coloredSweep(NSGSColoring *coloring,
+                    UpdatePtr update_localproblem, SolverPtr local_solver,
+                    FrictionContactProblem *problem, double *reaction,
+                    SolverOptions *options, SolverOptions *localsolver_options,
+                    int iter)
+{
+  int relaxation = options->iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] == SICONOS_FRICTION_3D_NSGS_RELAXATION_TRUE;
+  int filter = options->iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] == SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE;
+  double omega = options->dparam[SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE];
+  double light_error_sum = 0.0;
+
+  /* the local tolerance may have changed since the last sweep */
+  for(int t = 0; t < coloring->number_of_threads; ++t)
+  {
+    memcpy(coloring->localsolver_options[t]->iparam, localsolver_options->iparam,
+           localsolver_options->iSize * sizeof(int));
+    memcpy(coloring->localsolver_options[t]->dparam, localsolver_options->dparam,
+           localsolver_options->dSize * sizeof(double));
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(coloring->number_of_threads) reduction(+:light_error_sum)
+#endif
+  {
+    int thread = 0;
+#ifdef WITH_OPENMP
+    thread = omp_get_thread_num();
+#endif
+    FrictionContactProblem *localproblem = coloring->localproblems[thread];
+    SolverOptions *thread_options = coloring->localsolver_options[thread];
+    double localreaction[3];
+
+    for(unsigned int c = 0 ; c < coloring->number_of_colors ; ++c)
+    {
+      int start = (int)coloring->color_start[c];
+      int end = (int)coloring->color_start[c + 1];
+      /* the implicit barrier at the end of the loop separates the colors */
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(int k = start ; k < end ; ++k)
+      {
+        unsigned int contact = coloring->contacts[k];
+
+        solveLocalReaction(update_localproblem, local_solver, contact,
+                           problem, localproblem, reaction, thread_options,
+                           localreaction);
+
+        if(relaxation)
+          performRelaxation(localreaction, &reaction[contact*3], omega);
+
+        light_error_sum += light_error_squared(localreaction, &reaction[contact*3]);
+
+        if(filter)
+          acceptLocalReactionFiltered(localproblem, thread_options,
+                                      contact, iter, reaction, localreaction);
+        else
+          acceptLocalReactionUnconditionally(contact, reaction, localreaction);
+      }
+    }
+  }
+  return light_error_sum;
+}
+
 void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
                double *velocity, int* info, SolverOptions* options)
 {
@@ -582,6 +807,8 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
   double omega = dparam[SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE];
 
   double  norm_r[] = {1e24};
+  /* ratio full error / light error, for the adaptive error evaluation */
+  double error_ratio = -1.0;
   if(options->numberOfInternalSolvers < 1)
   {
     numerics_error("fc3d_nsgs",
@@ -604,6 +831,7 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
   unsigned int contact; /* Number of the current row of blocks in M */
   unsigned int *scontacts = NULL;
   unsigned int *freeze_contacts = NULL;
+  NSGSColoring *coloring = NULL;
 
   if(*info == 0)
     return;
@@ -617,6 +845,8 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
 
   scontacts = allocShuffledContacts(problem, options);
   freeze_contacts = allocfreezingContacts(problem, options);
+  if(isColoringAvailable(problem, options))
+    coloring = NSGSColoring_new(problem, localsolver_options);
   /*****  Check solver options *****/
   if(!(iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE
        || iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_TRUE
@@ -646,9 +876,53 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
 
   /*****  NSGS Iterations *****/
 
+  /* Colored sweep: the contacts of a color are solved concurrently */
+  if(coloring)
+  {
+    while((iter < itermax) && (hasNotConverged > 0))
+    {
+      ++iter;
+      fc3d_set_internalsolver_tolerance(problem, options, localsolver_options, error);
+
+      double light_error_sum = coloredSweep(coloring, update_localproblem, local_solver,
+                                            problem, reaction, options, localsolver_options,
+                                            iter);
+
+      if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT)
+      {
+        error = calculateLightError(light_error_sum, nc, reaction, norm_r);
+        hasNotConverged = determine_convergence(error, tolerance, iter, options);
+      }
+      else if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL)
+      {
+        error = calculateLightError(light_error_sum, nc, reaction, norm_r);
+        hasNotConverged = determine_convergence_with_full_final(problem,  options, computeError,
+                          reaction, velocity,
+                          &tolerance, norm_q, error,
+                          iter);
+        if(!(tolerance > 0.0))
+        {
+          numerics_warning("fc3d_nsgs", "tolerance has to be positive!!");
+          numerics_warning("fc3d_nsgs", "we stop the iterations");
+          break;
+        }
+      }
+      else
+      {
+        double light_error = calculateLightError(light_error_sum, nc, reaction, norm_r);
+        error = calculateFullErrorAdaptiveInterval(problem, computeError, options,
+                iter, reaction, velocity,
+                tolerance, norm_q, light_error, &error_ratio);
+        hasNotConverged = determine_convergence(error, tolerance, iter, options);
+      }
+
+      statsIterationCallback(problem, options, reaction, velocity, error);
+    }
+  }
+
   /* A special case for the most common options (should correspond
    * with mechanics_run.py **/
-  if(iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE
+  else if(iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE
      && iparam[SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT] == 0
       && iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] == SICONOS_FRICTION_3D_NSGS_RELAXATION_FALSE
       && iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] == SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE
@@ -827,11 +1101,13 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
         }
 
       }
-      else if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL)
+      else if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL
+              || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE)
       {
+        double light_error = calculateLightError(light_error_sum, nc, reaction, norm_r);
         error = calculateFullErrorAdaptiveInterval(problem, computeError, options,
                 iter, reaction, velocity,
-                tolerance, norm_q);
+                tolerance, norm_q, light_error, &error_ratio);
         hasNotConverged = determine_convergence(error, tolerance, iter, options);
       }
 
@@ -877,6 +1153,8 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
   (*freeSolver)(problem,localproblem,localsolver_options);
   fc3d_local_problem_free(localproblem, problem);
   if(scontacts) free(scontacts);
+  if(freeze_contacts) free(freeze_contacts);
+  if(coloring) NSGSColoring_free(coloring, problem);
 }
 
 void fc3d_nsgs_set_default(SolverOptions* options)
@@ -890,6 +1168,7 @@ void fc3d_nsgs_set_default(SolverOptions* options)
   options->iparam[SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT] = 0;
   options->iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] = SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_FALSE;
   options->iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] = SICONOS_FRICTION_3D_NSGS_RELAXATION_FALSE;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_COLORING] = SICONOS_FRICTION_3D_NSGS_COLORING_FALSE;
   options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY] = 0;
   options->dparam[SICONOS_DPARAM_TOL] = 1e-4;
   options->dparam[SICONOS_FRICTION_3D_DPARAM_INTERNAL_ERROR_RATIO] = 10.0;
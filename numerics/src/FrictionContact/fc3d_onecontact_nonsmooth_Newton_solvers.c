@@ -38,6 +38,7 @@
 #include "op3x3.h"                                     // for cpy3, mvp3x3
 #include "SiconosBlas.h"                                     // for cblas_ddot
 #include "NSSTools.h"   // for max
+#include "tlsdef.h"                                    // for tlsvar
 
 /* #define DEBUG_CHECK */
 /* #define DEBUG_NOCOLOR */
@@ -48,78 +49,83 @@
 #ifdef DEBUG_MESSAGES
 #include "NumericsVector.h"
 #endif
-static computeNonsmoothFunction  Function = NULL;
-static NewtonFunctionPtr F = NULL;
-static NewtonFunctionPtr jacobianF = NULL;
-static UpdateSolverPtr updateSolver = NULL;
-static PostSolverPtr postSolver = NULL;
-static FreeSolverNSGSPtr freeSolver = NULL;
+/* The state below is set by fc3d_onecontact_nonsmooth_Newton_solvers_initialize
+ * and is thread-local, so that independent problems may be solved
+ * concurrently. The Alart-Curnier like solvers do not use it when solving
+ * (the nonsmooth function is given by the options), hence they can be
+ * called from other threads than the one that initialized them. */
+static tlsvar NewtonFunctionPtr F = NULL;
+static tlsvar NewtonFunctionPtr jacobianF = NULL;
+static tlsvar UpdateSolverPtr updateSolver = NULL;
+static tlsvar PostSolverPtr postSolver = NULL;
+static tlsvar FreeSolverNSGSPtr freeSolver = NULL;
 
 /* size of a block */
-static int Fsize;
+static tlsvar int Fsize;
+
+/* Layout of dWork for the Alart-Curnier like solvers:
+ *  - NSN and NSN_GP: rho (3*nc),
+ *  - NSN_GP_HYBRID: PLI data (nc) followed by rho (3*nc).
+ */
+static size_t fc3d_AC_dWork_stride(SolverOptions * options)
+{
+  return options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID ? 4 : 3;
+}
+
+static double * fc3d_AC_rho(SolverOptions * options)
+{
+  int contact = options->iparam[SICONOS_FRICTION_3D_CURRENT_CONTACT_NUMBER];
+  if(options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID)
+  {
+    size_t nc = options->dWorkSize / fc3d_AC_dWork_stride(options);
+    return &options->dWork[3*contact+nc];
+  }
+  return &options->dWork[3*contact];
+}
+
+/* nonsmooth function (and its generalized jacobian) of the formulation
+ * chosen in the options */
+static computeNonsmoothFunction fc3d_AC_function(SolverOptions * options)
+{
+  switch(options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION])
+  {
+  case SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_STD:
+    return &computeAlartCurnierSTD;
+  case SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_STD:
+    return &computeAlartCurnierJeanMoreau;
+  case SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_GENERATED:
+    return &fc3d_AlartCurnierFunctionGenerated;
+  case SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_GENERATED:
+    return &fc3d_AlartCurnierJeanMoreauFunctionGenerated;
+  default:
+    return NULL;
+  }
+}
+
 static void fc3d_AC_initialize(FrictionContactProblem* problem,
                                FrictionContactProblem* localproblem,
                                SolverOptions * options)
 {
-  /** In initialize, these operators are "connected" to their corresponding static variables,
-   * that will be used to build local problem for each considered contact.
+  /** The nonsmooth function is given by the formulation in the options (see
+   * fc3d_AC_function). Here, rho is computed for each contact and stored in dWork.
    * Local problem is built during call to update (which depends on the storage type for M).
    */
 
   DEBUG_PRINTF("fc3d_AC_initialize starts with options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] = %i\n",
                options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION]);
 
-  if(options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-      SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_STD)
-  {
-    Function = &(computeAlartCurnierSTD);
-  }
-  else if(options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-          SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_STD)
-  {
-    Function = &(computeAlartCurnierJeanMoreau);
-  }
-  else if(options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-          SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_GENERATED)
-  {
-    Function = &(fc3d_AlartCurnierFunctionGenerated);
-  }
-  else if(options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-          SICONOS_FRICTION_3D_NSN_FORMULATION_JEANMOREAU_GENERATED)
-  {
-    Function = &fc3d_AlartCurnierJeanMoreauFunctionGenerated;;
-  }
-  else if(options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] ==
-          SICONOS_FRICTION_3D_NSN_FORMULATION_NULL)
-  {
-    Function = NULL;
-  }
-
   /* Compute and store default value of rho value */
   size_t nc = problem->numberOfContacts;
 
   double avg_rho[3] = {0.0, 0.0, 0.0};
 
-  if(options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN ||
-      options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP)
+  size_t dWorkSize = fc3d_AC_dWork_stride(options) * nc;
+  if(!options->dWork ||
+      options->dWorkSize != dWorkSize)
   {
-    if(!options->dWork ||
-        options->dWorkSize < 3*nc)
-    {
-      options->dWork = (double *)realloc(options->dWork,
-                                         3*nc * sizeof(double));
-      options->dWorkSize = 3*nc ;
-    }
-  }
-  else if(options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID)
-  {
-    if(!options->dWork ||
-        options->dWorkSize < 4*nc)
-    {
-      options->dWork = (double *)realloc(options->dWork,
-                                         4*nc * sizeof(double));
-      options->dWorkSize = 4*nc ;
-    }
+    options->dWork = (double *)realloc(options->dWork,
+                                       dWorkSize * sizeof(double));
+    options->dWorkSize = dWorkSize ;
   }
 
 
@@ -201,6 +207,7 @@ static void fc3d_AC_free(FrictionContactProblem * problem, FrictionContactProble
 {
   free(localsolver_options->dWork);
   localsolver_options->dWork=NULL;
+  localsolver_options->dWorkSize=0;
 }
 
 
@@ -468,18 +475,10 @@ int fc3d_onecontact_nonsmooth_Newton_solvers_solve_direct(FrictionContactProblem
   /* Value of AW+B */
   double AWplusB[9] = {0., 0., 0., 0., 0., 0., 0., 0., 0.};
 
+  computeNonsmoothFunction Function = fc3d_AC_function(options);
+
   /* retrieve value of rho */
-  double * rho;
-  if(options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN ||
-      options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP)
-  {
-    rho = &options->dWork[3*iparam[SICONOS_FRICTION_3D_CURRENT_CONTACT_NUMBER]];
-  }
-  else
-  {
-    int nc = options->dWorkSize/4;
-    rho = &options->dWork[3*iparam[SICONOS_FRICTION_3D_CURRENT_CONTACT_NUMBER]+nc];
-  }
+  double * rho = fc3d_AC_rho(options);
 
   /* compute the velocity */
   double velocity[3] = {0., 0., 0.};
@@ -761,18 +760,10 @@ int fc3d_onecontact_nonsmooth_Newton_solvers_solve_damped(FrictionContactProblem
   /* Value of AW+B */
   double AWplusB[9] = {0., 0., 0., 0., 0., 0., 0., 0., 0.};
 
+  computeNonsmoothFunction Function = fc3d_AC_function(options);
+
   /* retrieve value of rho */
-  double * rho;
-  if(options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN ||
-      options->solverId == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP)
-  {
-    rho = &options->dWork[3*iparam[SICONOS_FRICTION_3D_CURRENT_CONTACT_NUMBER]];
-  }
-  else
-  {
-    int nc = options->dWorkSize/4;
-    rho = &options->dWork[3*iparam[SICONOS_FRICTION_3D_CURRENT_CONTACT_NUMBER]+nc];
-  }
+  double * rho = fc3d_AC_rho(options);
 
   /* compute the velocity */
   double velocity[3] = {0., 0., 0.};
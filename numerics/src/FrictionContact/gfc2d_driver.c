@@ -33,6 +33,7 @@
 #include "NumericsVector.h"
 #include "NumericsMatrix.h"
 #endif
+#include "tlsdef.h"
 
 //const char* const SICONOS_GLOBAL_FRICTION_3D_NSGS_WR_STR = "GFC3D_NSGS_WR";
 
@@ -79,11 +80,11 @@
 
 //#define DUMP_PROBLEM
 #ifdef DUMP_PROBLEM
-static int fccounter = 0;
+static tlsvar int fccounter = 0;
 #endif
 //#define DUMP_PROBLEM_IF_INFO
 #ifdef DUMP_PROBLEM_IF_INFO
-static int fccounter = 0;
+static tlsvar int fccounter = 0;
 #endif
 
 int gfc2d_driver(GlobalFrictionContactProblem* problem, double *reaction, double *velocity,
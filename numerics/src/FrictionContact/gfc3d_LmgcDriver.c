@@ -35,7 +35,8 @@
 // avoid a conflict with old csparse.h
 #define _CS_H
 #include <sys/stat.h>                      // for stat, mkdir
-static int gfccounter =-1;
+#include "tlsdef.h"                        // for tlsvar
+static tlsvar int gfccounter =-1;
 
 #endif
 
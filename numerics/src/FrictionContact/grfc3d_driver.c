@@ -50,8 +50,9 @@ const char* const SICONOS_GLOBAL_ROLLING_FRICTION_3D_IPM_STR = "GRFC3D_IPM"; //
 #ifdef WITH_FCLIB
 #include "string.h"                  // for strcpy, strcat
 #include "fclib_interface.h"         // for frictionContact_fclib_write, fri...
+#include "tlsdef.h"                  // for tlsvar
 #endif
-static int fccounter = -1;
+static tlsvar int fccounter = -1;
 #endif
 
 int g_rolling_fc3d_driver(GlobalRollingFrictionContactProblem* problem, double *reaction, double *velocity,
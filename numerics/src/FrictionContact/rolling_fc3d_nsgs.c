@@ -32,11 +32,12 @@
 #include "rolling_fc3d_compute_error.h"        // for rolling_fc3d_compute_e...
 #include "rolling_fc3d_local_problem_tools.h"  // for rolling_fc3d_local_pro...
 #include "rolling_fc3d_projection.h"           // for rolling_fc3d_projectio...
+#include "tlsdef.h"                            // for tlsvar
 
 //#define FCLIB_OUTPUT
 
 #ifdef FCLIB_OUTPUT
-static int fccounter = -1;
+static tlsvar int fccounter = -1;
 #include "fclib_interface.h"
 #endif
 
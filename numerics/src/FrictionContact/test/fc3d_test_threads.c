@@ -0,0 +1,200 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2024 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Stress test of the reentrancy of fc3d_driver: the tests of a collection
+ * are solved once serially, then by several threads at the same time (each
+ * thread solving all the tests, starting at a different one). Each call has
+ * its own problem and its own copy of the solver options, the results must
+ * be the same as the serial ones. The whole collection is then solved with
+ * fc3d_driver_batch, with the same expected results. */
+
+#include <pthread.h>                     // for pthread_create, pthread_join
+#include <stdio.h>                       // for printf
+#include <stdlib.h>                      // for calloc, free, malloc
+#include <string.h>                      // for memcmp, strcmp
+#include "FrictionContactProblem.h"      // for FrictionContactProblem
+#include "Friction_cst.h"                // for SICONOS_FRICTION_3D_BATCH_...
+#include "lcp_cst.h"                     // for SICONOS_LCP_LEMKE
+#include "NonSmoothDrivers.h"            // for fc3d_driver
+#include "SolverOptions.h"               // for solver_options_copy, solver_...
+#include "frictionContact_test_utils.h"  // for build_test_collection
+#include "test_utils.h"                  // for TestCase, data_collection
+
+#define NUMBER_OF_THREADS 4
+
+typedef struct
+{
+  int info;
+  int size;
+  double *reaction;
+} TestResult;
+
+typedef struct
+{
+  TestCase *collection;
+  int number_of_tests;
+  int first_test;
+  TestResult *results;
+} ThreadData;
+
+static void solve_test(TestCase *current, TestResult *result)
+{
+  FrictionContactProblem *problem = frictionContact_new_from_filename(current->filename);
+  SolverOptions *options = solver_options_copy(current->options);
+
+  result->size = problem->dimension * problem->numberOfContacts;
+  result->reaction = (double *)calloc(result->size, sizeof(double));
+  double *velocity = (double *)calloc(result->size, sizeof(double));
+
+  result->info = fc3d_driver(problem, result->reaction, velocity, options);
+
+  free(velocity);
+  solver_options_delete(options);
+  free(options);
+  frictionContactProblem_free(problem);
+}
+
+static void *solve_collection(void *arg)
+{
+  ThreadData *data = (ThreadData *)arg;
+  for(int k = 0; k < data->number_of_tests; ++k)
+  {
+    int test = (data->first_test + k) % data->number_of_tests;
+    solve_test(&data->collection[test], &data->results[test]);
+  }
+  return NULL;
+}
+
+int main(void)
+{
+  const char **_data_collection = data_collection();
+  int n_data = 0;
+  while(strcmp(_data_collection[n_data], "---") != 0)
+    n_data++;
+
+  int number_of_tests;
+  TestCase *collection = build_test_collection(n_data, _data_collection, &number_of_tests);
+  printf("%i tests for %i data files, %i threads.\n", number_of_tests, n_data, NUMBER_OF_THREADS);
+
+  /* reference results */
+  TestResult *reference = (TestResult *)malloc(number_of_tests * sizeof(TestResult));
+  for(int test = 0; test < number_of_tests; ++test)
+    solve_test(&collection[test], &reference[test]);
+
+  pthread_t threads[NUMBER_OF_THREADS];
+  ThreadData data[NUMBER_OF_THREADS];
+  for(int t = 0; t < NUMBER_OF_THREADS; ++t)
+  {
+    data[t].collection = collection;
+    data[t].number_of_tests = number_of_tests;
+    data[t].first_test = t * number_of_tests / NUMBER_OF_THREADS;
+    data[t].results = (TestResult *)malloc(number_of_tests * sizeof(TestResult));
+    if(pthread_create(&threads[t], NULL, solve_collection, &data[t]))
+    {
+      printf("pthread_create failed\n");
+      return 1;
+    }
+  }
+
+  int out = 0;
+  for(int t = 0; t < NUMBER_OF_THREADS; ++t)
+  {
+    pthread_join(threads[t], NULL);
+    for(int test = 0; test < number_of_tests; ++test)
+    {
+      TestResult *result = &data[t].results[test];
+      if(result->info != reference[test].info
+          || result->size != reference[test].size
+          || memcmp(result->reaction, reference[test].reaction, result->size * sizeof(double)))
+      {
+        printf("thread %i, test %i (%s): result differs from the serial one\n",
+               t, test, collection[test].filename);
+        out = 1;
+      }
+      free(result->reaction);
+    }
+    free(data[t].results);
+  }
+
+  /* batch solve */
+  FrictionContactProblem **problems = (FrictionContactProblem **)malloc(number_of_tests * sizeof(FrictionContactProblem *));
+  SolverOptions **options = (SolverOptions **)malloc(number_of_tests * sizeof(SolverOptions *));
+  double **reactions = (double **)malloc(number_of_tests * sizeof(double *));
+  double **velocities = (double **)malloc(number_of_tests * sizeof(double *));
+  int *info = (int *)malloc(number_of_tests * sizeof(int));
+  double *time = (double *)malloc(number_of_tests * sizeof(double));
+  int number_of_failures = 0;
+  for(int test = 0; test < number_of_tests; ++test)
+  {
+    problems[test] = frictionContact_new_from_filename(collection[test].filename);
+    options[test] = solver_options_copy(collection[test].options);
+    reactions[test] = (double *)calloc(reference[test].size, sizeof(double));
+    velocities[test] = (double *)calloc(reference[test].size, sizeof(double));
+    if(reference[test].info)
+      number_of_failures++;
+  }
+
+  if(fc3d_driver_batch(number_of_tests, problems, reactions, velocities, options, info, time)
+      != number_of_failures)
+  {
+    printf("fc3d_driver_batch: wrong number of failures\n");
+    out = 1;
+  }
+  /* a fatal error stops only the solve of its problem */
+  int solverId = options[0]->solverId;
+  options[0]->solverId = SICONOS_LCP_LEMKE;
+  int fatal_info;
+  double fatal_time;
+  if(fc3d_driver_batch(1, problems, reactions, velocities, options, &fatal_info, &fatal_time) != 1
+      || fatal_info != SICONOS_FRICTION_3D_BATCH_FATAL_ERROR)
+  {
+    printf("fc3d_driver_batch: fatal error not reported\n");
+    out = 1;
+  }
+  options[0]->solverId = solverId;
+
+  for(int test = 0; test < number_of_tests; ++test)
+  {
+    if(info[test] != reference[test].info
+        || memcmp(reactions[test], reference[test].reaction, reference[test].size * sizeof(double))
+        || !(time[test] >= 0.))
+    {
+      printf("fc3d_driver_batch, test %i (%s): result differs from the serial one\n",
+             test, collection[test].filename);
+      out = 1;
+    }
+    free(reactions[test]);
+    free(velocities[test]);
+    solver_options_delete(options[test]);
+    free(options[test]);
+    frictionContactProblem_free(problems[test]);
+    free(reference[test].reaction);
+  }
+  free(problems);
+  free(options);
+  free(reactions);
+  free(velocities);
+  free(info);
+  free(time);
+  free(reference);
+  free_test_collection(collection, number_of_tests);
+
+  if(!out)
+    printf("all the concurrent and batch solves match the serial ones.\n");
+  return out;
+}
@@ -51,6 +51,7 @@
 
 #ifdef DEBUG_MESSAGES
 #include "NumericsVector.h"
+#include "tlsdef.h"
 #endif
 
 const char* const   SICONOS_GENERIC_MECHANICAL_NSGS_STR = "GMP_NSGS";
@@ -224,8 +225,8 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction, double *
     return 0;
 }
 #ifdef GENERICMECHANICAL_DEBUG_CMP
-static int SScmp = 0;
-static int SScmpTotal = 0;
+static tlsvar int SScmp = 0;
+static tlsvar int SScmpTotal = 0;
 #endif
 //#define GMP_WRITE_PRB
 //static double sCoefLS=1.0;
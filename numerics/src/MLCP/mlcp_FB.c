@@ -28,12 +28,13 @@
 #include "mlcp_FB.h"                            // for mlcp_FB_getNbDWork
 #include "numerics_verbose.h"                   // for verbose
 #include "SiconosBlas.h"                              // for cblas_dcopy
+#include "tlsdef.h"                                   // for tlsvar
 
-static int sN = 0;
-static int sM = 0;
-static MixedLinearComplementarityProblem* sProblem;
-static double* sFz = 0;
-static double sMaxError = 0;
+static tlsvar int sN = 0;
+static tlsvar int sM = 0;
+static tlsvar MixedLinearComplementarityProblem* sProblem;
+static tlsvar double* sFz = 0;
+static tlsvar double sMaxError = 0;
 
 static void computeFz(double* z);
 static void F_MCPFischerBurmeister(int size, double* z, double* FBz, int a);
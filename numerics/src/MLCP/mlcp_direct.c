@@ -52,6 +52,7 @@ dim(v)=nn
 
 #define DEBUG_MESSAGES
 #include "siconos_debug.h"
+#include "tlsdef.h"
 
 
 
@@ -69,21 +70,21 @@ struct dataComplementarityConf
   lapack_int* IPV;
 };
 
-static double * sp_curDouble = 0;
-static int * sp_curInt = 0;
-static double * sQ = 0;
-static int s_numberOfCC = 0;
-static int s_maxNumberOfCC = 0;
-static struct dataComplementarityConf * spFirstCC = 0;
-static struct dataComplementarityConf * sp_curCC = 0;
-static double sTolneg = 0;
-static double sTolpos = 0;
-static int s_n;
-static int s_m;
-static int s_nbLines;
-static int s_npM;
-static int* spIntBuf;
-static int sProblemChanged = 0;
+static tlsvar double * sp_curDouble = 0;
+static tlsvar int * sp_curInt = 0;
+static tlsvar double * sQ = 0;
+static tlsvar int s_numberOfCC = 0;
+static tlsvar int s_maxNumberOfCC = 0;
+static tlsvar struct dataComplementarityConf * spFirstCC = 0;
+static tlsvar struct dataComplementarityConf * sp_curCC = 0;
+static tlsvar double sTolneg = 0;
+static tlsvar double sTolpos = 0;
+static tlsvar int s_n;
+static tlsvar int s_m;
+static tlsvar int s_nbLines;
+static tlsvar int s_npM;
+static tlsvar int* spIntBuf;
+static tlsvar int sProblemChanged = 0;
 
 static double * mydMalloc(int n);
 static int * myiMalloc(int n);
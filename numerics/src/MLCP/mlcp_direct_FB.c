@@ -32,14 +32,15 @@ dim(v)=nn
 #include "SolverOptions.h"                      // for SolverOptions
 #include "mlcp_FB.h"                            // for mlcp_FB_getNbDWork
 #include "mlcp_direct.h"                        // for mlcp_direct_getNbDWork
+#include "tlsdef.h"                             // for tlsvar
 
-static int sN;
-static int sM;
+static tlsvar int sN;
+static tlsvar int sM;
 
-static int * siWorkFB = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkFB = 0;
-static double * sdWorkDirect = 0;
+static tlsvar int * siWorkFB = 0;
+static tlsvar int * siWorkDirect = 0;
+static tlsvar double * sdWorkFB = 0;
+static tlsvar double * sdWorkDirect = 0;
 
 int mlcp_direct_FB_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
@@ -40,14 +40,15 @@ dim(v)=nn
 
 /* #define DEBUG_MESSAGES */
 #include "siconos_debug.h"
+#include "tlsdef.h"
 
-static int sN;
-static int sM;
+static tlsvar int sN;
+static tlsvar int sM;
 
-static int * siWorkEnum = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkEnum = 0;
-static double * sdWorkDirect = 0;
+static tlsvar int * siWorkEnum = 0;
+static tlsvar int * siWorkDirect = 0;
+static tlsvar double * sdWorkEnum = 0;
+static tlsvar double * sdWorkDirect = 0;
 
 void mlcp_direct_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
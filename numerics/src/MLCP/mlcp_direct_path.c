@@ -20,9 +20,10 @@
 #include "MLCP_Solvers.h"                       // for mixedLinearComplement...
 #include "MixedLinearComplementarityProblem.h"  // for MixedLinearComplement...
 #include "mlcp_direct.h"                        // for mlcp_direct_addConfig...
+#include "tlsdef.h"                             // for tlsvar
 
-static int sN;
-static int sM;
+static tlsvar int sN;
+static tlsvar int sM;
 
 
 void mlcp_direct_path_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
@@ -32,14 +32,15 @@ dim(v)=nn
 #include "SolverOptions.h"                      // for SolverOptions
 #include "mlcp_direct.h"                        // for mlcp_direct_getNbDWork
 #include "mlcp_path_enum.h"                     // for mlcp_path_enum, mlcp_...
+#include "tlsdef.h"                             // for tlsvar
 
-static int sN;
-static int sM;
+static tlsvar int sN;
+static tlsvar int sM;
 
-static int * siWorkPathEnum = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkPathEnum = 0;
-static double * sdWorkDirect = 0;
+static tlsvar int * siWorkPathEnum = 0;
+static tlsvar int * siWorkDirect = 0;
+static tlsvar double * sdWorkPathEnum = 0;
+static tlsvar double * sdWorkDirect = 0;
 
 void mlcp_direct_path_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
@@ -21,9 +21,10 @@
 #include "MixedLinearComplementarityProblem.h"  // for MixedLinearComplement...
 #include "mlcp_direct.h"                        // for mlcp_direct_addConfig...
 #include "mlcp_simplex.h"                       // for mlcp_simplex_init
+#include "tlsdef.h"                             // for tlsvar
 
-static int sN;
-static int sM;
+static tlsvar int sN;
+static tlsvar int sM;
 
 void mlcp_direct_simplex_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
@@ -32,14 +32,15 @@ dim(v)=nn
 #include "MixedLinearComplementarityProblem.h"  // for mixedLinearComplement...
 #include "SolverOptions.h"                      // for SolverOptions
 #include "mlcp_enum.h"                          // for mlcp_enum_getNbDWork
+#include "tlsdef.h"                             // for tlsvar
 
-static int sN;
-static int sM;
+static tlsvar int sN;
+static tlsvar int sM;
 
-static int * siWorkEnum = 0;
-static int * siWorkPath = 0;
-static double * sdWorkEnum = 0;
-static double * sdWorkPath = 0;
+static tlsvar int * siWorkEnum = 0;
+static tlsvar int * siWorkPath = 0;
+static tlsvar double * sdWorkEnum = 0;
+static tlsvar double * sdWorkPath = 0;
 
 int mlcp_path_enum_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
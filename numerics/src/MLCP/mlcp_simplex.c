@@ -39,8 +39,9 @@ dim(v)=nn
 #include <math.h>
 /*import external implementation*/
 #include "external_mlcp_simplex.h"
+#include "tlsdef.h"
 
-static int sIsInitialize = 0;
+static tlsvar int sIsInitialize = 0;
 #endif
 
 void mlcp_simplex_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
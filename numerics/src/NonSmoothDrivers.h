@@ -19,6 +19,13 @@
 /*!\file NonSmoothDrivers.h
   This file provides all generic functions (drivers), interfaces to the different formulations for Non-Smooth Problems available in Numerics.
   
+  The drivers are reentrant: independent problems may be solved concurrently
+  from several threads, as long as each call has its own problem, its own
+  output vectors and its own SolverOptions. The SolverOptions is the per-call
+  context (work arrays, solver data, internal solvers) and must not be shared
+  by concurrent calls. The remaining internal state (verbosity, logger, error
+  handling, local solvers state) is thread-local.
+
   \todo solve_qp does not exist
 
   Use fc3d tools.
@@ -113,6 +120,29 @@ extern "C"
   */
   int fc3d_driver(FrictionContactProblem* problem, double *reaction , double *velocity, SolverOptions* options);
 
+  /**
+      Solves a set of independent friction-contact 3D problems with fc3d_driver.
+      When OpenMP is available, the problems are solved concurrently (the
+      number of threads is the OpenMP one), the largest problems first.
+
+      \param[in] number_of_problems the number of problems
+      \param[in] problems the problems
+      \param[in,out] reactions reaction vector of each problem
+      \param[in,out] velocities velocity vector of each problem
+      \param[in,out] options solver options of each problem. They must be
+      distinct objects. The number of iterations and the residual of each
+      solve are available in their iparam[SICONOS_IPARAM_ITER_DONE] and
+      dparam[SICONOS_DPARAM_RESIDU].
+      \param[out] info result of fc3d_driver for each problem (may be
+      NULL), or SICONOS_FRICTION_3D_BATCH_FATAL_ERROR if its solve has been
+      stopped by a fatal error (see sn_fatal_error())
+      \param[out] time wall-clock time of each solve, in seconds (may be NULL)
+      \return the number of problems for which the solver did not succeed
+  */
+  int fc3d_driver_batch(int number_of_problems, FrictionContactProblem** problems,
+                        double **reactions, double **velocities, SolverOptions** options,
+                        int* info, double* time);
+
   /**
      General interface to solvers for rolling friction-contact 3D problem
   
@@ -27,6 +27,7 @@
 #include <stdlib.h>            // for realloc, exit, free, malloc, EXIT_FAILURE
 #include <string.h>            // for strtok_r, memcpy, strncmp
 #include "SiconosCompat.h"     // for SN_PTRDIFF_T_F
+#include "tlsdef.h"            // for tlsvar, DESTRUCTOR_ATTR
 #include "numerics_verbose.h"  // for CHECK_IO
 #define LDL_LONG
 #include "ldl.h"
@@ -113,6 +114,36 @@ int CSparseMatrix_aaxpby(const double alpha, const CSparseMatrix *A,
   return 1;
 
 }
+/* minimal number of columns to share CSparseMatrix_taaxpby between threads */
+#define CSPARSE_TAAXPBY_PARALLEL_MIN_COLUMNS 2048
+
+int CSparseMatrix_taaxpby(const double alpha, const CSparseMatrix *A,
+                          const double *restrict x,
+                          const double beta, double *restrict y)
+{
+  if(!CS_CSC(A) || !x || !y) return (0);	     /* check inputs */
+
+  CS_INT n = A->n;
+  CS_INT *Ap = A->p;
+  CS_INT *Ai = A->i;
+  double *Ax = A->x;
+
+  /* each column of A gives one entry of y: the columns may be processed
+   * concurrently */
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(static) if(n >= CSPARSE_TAAXPBY_PARALLEL_MIN_COLUMNS)
+#endif
+  for(CS_INT j=0 ; j<n ; j++)
+  {
+    double yj = beta * y[j];
+    for(CS_INT p = Ap [j] ; p < Ap [j+1] ; p++)
+    {
+      yj += alpha * Ax [p] * x [Ai [p]];
+    }
+    y[j] = yj;
+  }
+  return 1;
+}
 /* A <-- alpha*A */
 int CSparseMatrix_scal(const double alpha, const CSparseMatrix *A)
 {
@@ -242,11 +273,290 @@ CSparseMatrix* CSparseMatrix_spfree_on_stack(CSparseMatrix* A)
   return NULL;
 }
 
+/* sizes of the p and i arrays of a matrix, whatever its format */
+static void CSparseMatrix_pattern_sizes(const cs* const A, CS_INT* p_size, CS_INT* i_size)
+{
+  if(A->nz >= 0) /* triplet */
+  {
+    *p_size = A->nz;
+    *i_size = A->nz;
+  }
+  else if(A->nz == -2) /* compressed rows */
+  {
+    *p_size = A->m + 1;
+    *i_size = A->p[A->m];
+  }
+  else
+  {
+    *p_size = A->n + 1;
+    *i_size = A->p[A->n];
+  }
+}
+
+static size_t hash_combine(size_t seed, CS_INT v)
+{
+  return seed ^ ((size_t)v + (size_t)0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+size_t CSparseMatrix_pattern_fingerprint(const CSparseMatrix* const A)
+{
+  assert(A);
+  CS_INT p_size, i_size;
+  CSparseMatrix_pattern_sizes(A, &p_size, &i_size);
+
+  size_t h = hash_combine(hash_combine(hash_combine(0, A->m), A->n), A->nz);
+  for(CS_INT k = 0; k < p_size; ++k)
+    h = hash_combine(h, A->p[k]);
+  for(CS_INT k = 0; k < i_size; ++k)
+    h = hash_combine(h, A->i[k]);
+  return h;
+}
+
+CSparseMatrix_pattern* CSparseMatrix_pattern_new(const CSparseMatrix* const A, size_t fingerprint)
+{
+  assert(A);
+  CS_INT p_size, i_size;
+  CSparseMatrix_pattern_sizes(A, &p_size, &i_size);
+
+  CSparseMatrix_pattern* P = (CSparseMatrix_pattern*)malloc(sizeof(CSparseMatrix_pattern));
+  P->m = A->m;
+  P->n = A->n;
+  P->nz = A->nz;
+  P->fingerprint = fingerprint;
+  P->p = (CS_INT*)malloc((p_size > 0 ? p_size : 1) * sizeof(CS_INT));
+  P->i = (CS_INT*)malloc((i_size > 0 ? i_size : 1) * sizeof(CS_INT));
+  memcpy(P->p, A->p, p_size * sizeof(CS_INT));
+  memcpy(P->i, A->i, i_size * sizeof(CS_INT));
+  return P;
+}
+
+int CSparseMatrix_pattern_match(const CSparseMatrix_pattern* const P, const CSparseMatrix* const A,
+                                size_t fingerprint)
+{
+  assert(P);
+  assert(A);
+  if(P->fingerprint != fingerprint || P->m != A->m || P->n != A->n || P->nz != A->nz)
+    return 0;
+
+  /* the fingerprints are equal, the patterns are compared to rule out a collision */
+  CS_INT p_size, i_size;
+  CSparseMatrix_pattern_sizes(A, &p_size, &i_size);
+  return !memcmp(P->p, A->p, p_size * sizeof(CS_INT))
+         && !memcmp(P->i, A->i, i_size * sizeof(CS_INT));
+}
+
+CSparseMatrix_pattern* CSparseMatrix_pattern_free(CSparseMatrix_pattern* P)
+{
+  if(P)
+  {
+    free(P->p);
+    free(P->i);
+    free(P);
+  }
+  return NULL;
+}
+
+/* position of the entry (i, j) in the compressed column matrix C, -1 if
+ * it is not in the pattern of C */
+static CS_INT cs_entry_position(const CSparseMatrix* const C, CS_INT i, CS_INT j)
+{
+  for(CS_INT p = C->p[j]; p < C->p[j + 1]; ++p)
+  {
+    if(C->i[p] == i)
+      return p;
+  }
+  return -1;
+}
+
+CS_INT* CSparseMatrix_triplet_to_csc_map(const CSparseMatrix* const T, const CSparseMatrix* const C)
+{
+  assert(T && T->nz >= 0);
+  assert(C && C->nz == -1);
+  if(T->m != C->m || T->n != C->n)
+    return NULL;
+
+  CS_INT* map = (CS_INT*)malloc((T->nz > 0 ? T->nz : 1) * sizeof(CS_INT));
+  for(CS_INT k = 0; k < T->nz; ++k)
+  {
+    map[k] = cs_entry_position(C, T->i[k], T->p[k]);
+    if(map[k] < 0)
+    {
+      free(map);
+      return NULL;
+    }
+  }
+  return map;
+}
+
+CS_INT* CSparseMatrix_transpose_map(const CSparseMatrix* const A, const CSparseMatrix* const AT)
+{
+  assert(A && A->nz == -1);
+  assert(AT && AT->nz == -1);
+  if(A->m != AT->n || A->n != AT->m)
+    return NULL;
+
+  CS_INT nnz = A->p[A->n];
+  CS_INT* map = (CS_INT*)malloc((nnz > 0 ? nnz : 1) * sizeof(CS_INT));
+  for(CS_INT j = 0; j < A->n; ++j)
+  {
+    for(CS_INT p = A->p[j]; p < A->p[j + 1]; ++p)
+    {
+      map[p] = cs_entry_position(AT, j, A->i[p]);
+      if(map[p] < 0)
+      {
+        free(map);
+        return NULL;
+      }
+    }
+  }
+  return map;
+}
+
+void CSparseMatrix_scatter_values(CS_INT nz, const double* const x, const CS_INT* const map,
+                                  CSparseMatrix* C)
+{
+  assert(C && C->nz == -1);
+  memset(C->x, 0, C->p[C->n] * sizeof(double));
+  for(CS_INT k = 0; k < nz; ++k)
+    C->x[map[k]] += x[k];
+}
+
+/* Cache of symbolic analyses, keyed on the sparsity pattern of the analysed
+ * matrix. It is thread local (the numerics drivers are reentrant) and keeps
+ * the CS_SYMBOLIC_CACHE_SIZE most recently used analyses. */
+#define CS_SYMBOLIC_CACHE_SIZE 4
+
+typedef struct
+{
+  int kind;
+  CS_INT order;
+  CSparseMatrix_pattern* pattern;
+  void* data;
+  void (*free_data)(void*);
+  unsigned long last_use;
+} CSparseMatrix_symbolic_entry;
+
+static tlsvar CSparseMatrix_symbolic_entry symbolic_cache[CS_SYMBOLIC_CACHE_SIZE];
+static tlsvar unsigned long symbolic_cache_clock = 0;
+
+static void CSparseMatrix_symbolic_entry_clear(CSparseMatrix_symbolic_entry* e)
+{
+  if(e->data && e->free_data)
+    e->free_data(e->data);
+  e->pattern = CSparseMatrix_pattern_free(e->pattern);
+  e->data = NULL;
+  e->free_data = NULL;
+  e->last_use = 0;
+}
+
+void* CSparseMatrix_symbolic_get(const CSparseMatrix* const A, int kind, CS_INT order)
+{
+  size_t fingerprint = 0;
+  int fingerprint_computed = 0;
+  for(int k = 0; k < CS_SYMBOLIC_CACHE_SIZE; ++k)
+  {
+    CSparseMatrix_symbolic_entry* e = &symbolic_cache[k];
+    if(!e->pattern || e->kind != kind || e->order != order)
+      continue;
+    if(!fingerprint_computed)
+    {
+      fingerprint = CSparseMatrix_pattern_fingerprint(A);
+      fingerprint_computed = 1;
+    }
+    if(CSparseMatrix_pattern_match(e->pattern, A, fingerprint))
+    {
+      DEBUG_PRINTF("CSparseMatrix_symbolic_get: reuse of the analysis of kind %i\n", kind);
+      e->last_use = ++symbolic_cache_clock;
+      return e->data;
+    }
+  }
+  return NULL;
+}
+
+void CSparseMatrix_symbolic_set(const CSparseMatrix* const A, int kind, CS_INT order,
+                                void* data, void (*free_data)(void*))
+{
+  size_t fingerprint = CSparseMatrix_pattern_fingerprint(A);
+
+  /* an analysis of the same pattern is replaced, otherwise the least
+   * recently used entry */
+  CSparseMatrix_symbolic_entry* e = &symbolic_cache[0];
+  for(int k = 0; k < CS_SYMBOLIC_CACHE_SIZE; ++k)
+  {
+    CSparseMatrix_symbolic_entry* ek = &symbolic_cache[k];
+    if(ek->pattern && ek->kind == kind && ek->order == order
+        && CSparseMatrix_pattern_match(ek->pattern, A, fingerprint))
+    {
+      e = ek;
+      break;
+    }
+    if(ek->last_use < e->last_use)
+      e = ek;
+  }
+  CSparseMatrix_symbolic_entry_clear(e);
+
+  e->kind = kind;
+  e->order = order;
+  e->pattern = CSparseMatrix_pattern_new(A, fingerprint);
+  e->data = data;
+  e->free_data = free_data;
+  e->last_use = ++symbolic_cache_clock;
+}
+
+void CSparseMatrix_symbolic_cache_clear(void)
+{
+  for(int k = 0; k < CS_SYMBOLIC_CACHE_SIZE; ++k)
+    CSparseMatrix_symbolic_entry_clear(&symbolic_cache[k]);
+}
+
+static void CSparseMatrix_symbolic_cache_finalize(void) DESTRUCTOR_ATTR;
+static void CSparseMatrix_symbolic_cache_finalize(void)
+{
+  CSparseMatrix_symbolic_cache_clear();
+}
+
+static CS_INT* cs_int_dup(const CS_INT* a, CS_INT size)
+{
+  if(!a)
+    return NULL;
+  CS_INT* b = cs_malloc(size, sizeof(CS_INT));
+  memcpy(b, a, size * sizeof(CS_INT));
+  return b;
+}
+
+/* copy of a symbolic analysis of a square matrix of size n
+ * (the leftmost array is only used by QR and is not copied) */
+static css* cs_symbolic_copy(const css* S, CS_INT n)
+{
+  if(!S)
+    return NULL;
+  css* C = cs_calloc(1, sizeof(css));
+  *C = *S;
+  C->pinv = cs_int_dup(S->pinv, n);
+  C->q = cs_int_dup(S->q, n);
+  C->parent = cs_int_dup(S->parent, n);
+  C->cp = cs_int_dup(S->cp, n + 1);
+  C->leftmost = NULL;
+  return C;
+}
+
+static void cs_symbolic_free(void* S)
+{
+  cs_sfree((css*)S);
+}
+
 int CSparseMatrix_lu_factorization(CS_INT order, const cs *A, double tol, CSparseMatrix_factors * cs_lu_A)
 {
   assert(A);
   cs_lu_A->n = A->n;
-  css* S = cs_sqr(order, A, 0);
+  /* the ordering only depends on the pattern of A */
+  css* S = cs_symbolic_copy((css*)CSparseMatrix_symbolic_get(A, CS_SYMBOLIC_LU, order), A->n);
+  if(!S)
+  {
+    S = cs_sqr(order, A, 0);
+    if(S)
+      CSparseMatrix_symbolic_set(A, CS_SYMBOLIC_LU, order, cs_symbolic_copy(S, A->n), &cs_symbolic_free);
+  }
   cs_lu_A->S = S;
   cs_lu_A->N = cs_lu(A, S, tol);
 
@@ -256,7 +566,15 @@ int CSparseMatrix_chol_factorization(CS_INT order, const cs *A,  CSparseMatrix_f
 {
   assert(A);
   cs_chol_A->n = A->n;
-  css* S = cs_schol(order, A);
+  /* the ordering, the elimination tree and the column counts only depend
+   * on the pattern of A */
+  css* S = cs_symbolic_copy((css*)CSparseMatrix_symbolic_get(A, CS_SYMBOLIC_CHOL, order), A->n);
+  if(!S)
+  {
+    S = cs_schol(order, A);
+    if(S)
+      CSparseMatrix_symbolic_set(A, CS_SYMBOLIC_CHOL, order, cs_symbolic_copy(S, A->n), &cs_symbolic_free);
+  }
   cs_chol_A->S = S;
   cs_chol_A->N = cs_chol(A, S);
 
@@ -295,18 +613,40 @@ int CSparseMatrix_ldlt_factorization(CS_INT order, const cs *A,  CSparseMatrix_f
   CS_INT* Lnz = cs_malloc (n, sizeof (CS_INT)) ;
   CS_INT* Flag =  cs_malloc (n, sizeof (CS_INT)) ;
 
-  /* ordering with amd */
   CS_INT * Perm, *PermInv;
-  cs_ldlt_A->N->pinv = Perm  = cs_amd (order, A) ;  /* We used pinv to store Perm !! */
   PermInv = cs_malloc (n, sizeof (CS_INT)) ;
 
-
-  DEBUG_EXPR(for (int k =0; k< n+1; k++){printf("%li\t", Perm[k]);}printf("\n"););
-
-  /* symbolic factorization to get Lp, Parent, Lnz, and Pinv */
-  LDL_symbolic (n, Ap, Ai, Lp, Parent, Lnz, Flag, Perm, PermInv) ;
-  DEBUG_EXPR(for (int k =0; k< n+1; k++){printf("%li\t", Lp[k]);}printf("\n"););
-  DEBUG_EXPR(for (int k =0; k< n; k++){printf("%li\t", Flag[k]);}printf("\n"););
+  /* the symbolic analysis (stored as a css: q = Perm, pinv = PermInv,
+   * parent = Parent, cp = Lp) only depends on the pattern of A */
+  css* Sc = (css*)CSparseMatrix_symbolic_get(A, CS_SYMBOLIC_LDLT, order);
+  if(Sc)
+  {
+    Perm = cs_int_dup(Sc->q, n);
+    if(Perm)
+      memcpy(PermInv, Sc->pinv, n * sizeof(CS_INT));
+    memcpy(Parent, Sc->parent, n * sizeof(CS_INT));
+    memcpy(Lp, Sc->cp, (n+1) * sizeof(CS_INT));
+  }
+  else
+  {
+    /* ordering with amd */
+    Perm  = cs_amd (order, A) ;
+
+    DEBUG_EXPR(for (int k =0; k< n+1; k++){printf("%li\t", Perm[k]);}printf("\n"););
+
+    /* symbolic factorization to get Lp, Parent, Lnz, and Pinv */
+    LDL_symbolic (n, Ap, Ai, Lp, Parent, Lnz, Flag, Perm, PermInv) ;
+    DEBUG_EXPR(for (int k =0; k< n+1; k++){printf("%li\t", Lp[k]);}printf("\n"););
+    DEBUG_EXPR(for (int k =0; k< n; k++){printf("%li\t", Flag[k]);}printf("\n"););
+
+    css symbolic = {0};
+    symbolic.q = Perm;
+    symbolic.pinv = Perm ? PermInv : NULL;
+    symbolic.parent = Parent;
+    symbolic.cp = Lp;
+    CSparseMatrix_symbolic_set(A, CS_SYMBOLIC_LDLT, order, cs_symbolic_copy(&symbolic, n), &cs_symbolic_free);
+  }
+  cs_ldlt_A->N->pinv = Perm;  /* We used pinv to store Perm !! */
 
   /* factorization */
   lnz = Lp [n] ;
@@ -208,6 +208,130 @@ extern "C"
    */
   void CSparseMatrix_free_lu_factors(CSparseMatrix_factors* cs_lu_A);
 
+  /** Copy of the sparsity pattern of a matrix, used to check that the
+   *  pattern of a matrix has not changed since a symbolic analysis */
+  typedef struct {
+    CS_INT m;           /**< number of rows */
+    CS_INT n;           /**< number of columns */
+    CS_INT nz;          /**< nz field of the matrix (storage format) */
+    size_t fingerprint; /**< hash of the pattern */
+    CS_INT* p;          /**< copy of the column pointers (or column indices) */
+    CS_INT* i;          /**< copy of the row indices */
+  } CSparseMatrix_pattern;
+
+  /** Compute a hash of the sparsity pattern of a matrix (compressed
+   *  columns, compressed rows or triplet). Two matrices with the same
+   *  structure have the same fingerprint, whatever their values.
+   *
+   *  \param A the matrix
+   *  \return the fingerprint
+   */
+  size_t CSparseMatrix_pattern_fingerprint(const CSparseMatrix* const A);
+
+  /** Copy the sparsity pattern of a matrix
+   *
+   *  \param A the matrix
+   *  \param fingerprint the fingerprint of A (see CSparseMatrix_pattern_fingerprint)
+   *  \return a newly allocated pattern
+   */
+  CSparseMatrix_pattern* CSparseMatrix_pattern_new(const CSparseMatrix* const A, size_t fingerprint);
+
+  /** Check whether a matrix has a given sparsity pattern
+   *
+   *  \param P the pattern
+   *  \param A the matrix
+   *  \param fingerprint the fingerprint of A (see CSparseMatrix_pattern_fingerprint)
+   *  \return 1 if the pattern of A is P, 0 otherwise
+   */
+  int CSparseMatrix_pattern_match(const CSparseMatrix_pattern* const P, const CSparseMatrix* const A,
+                                  size_t fingerprint);
+
+  /** Free a pattern
+   *
+   *  \param P the pattern
+   *  \return NULL on success
+   */
+  CSparseMatrix_pattern* CSparseMatrix_pattern_free(CSparseMatrix_pattern* P);
+
+  /** Positions of the entries of a triplet matrix in a compressed column
+   *  matrix whose pattern contains the pattern of the triplet, for updates
+   *  of the values of C without a new compression (see
+   *  CSparseMatrix_scatter_values).
+   *
+   *  \param T a triplet matrix
+   *  \param C a compressed column matrix of the same size
+   *  \return map[k] the position in C->x of the k-th entry of T (to be
+   *  freed by the caller), NULL if an entry of T is not in the pattern of C
+   */
+  CS_INT* CSparseMatrix_triplet_to_csc_map(const CSparseMatrix* const T, const CSparseMatrix* const C);
+
+  /** Positions of the entries of a compressed column matrix in (the
+   *  compressed column storage of) its transpose.
+   *
+   *  \param A a compressed column matrix
+   *  \param AT a compressed column matrix with the pattern of the
+   *  transpose of A
+   *  \return map[p] the position in AT->x of A->x[p] (to be freed by the
+   *  caller), NULL if an entry of A is not in the pattern of AT
+   */
+  CS_INT* CSparseMatrix_transpose_map(const CSparseMatrix* const A, const CSparseMatrix* const AT);
+
+  /** Set the values of a compressed column matrix from the values of a
+   *  matrix with the same pattern: C->x = 0, then C->x[map[k]] += x[k]
+   *  (duplicated entries are summed up).
+   *
+   *  \param nz the number of values
+   *  \param x the values
+   *  \param map the positions of the values in C->x, as computed by
+   *  CSparseMatrix_triplet_to_csc_map or CSparseMatrix_transpose_map
+   *  \param[in,out] C the compressed column matrix
+   */
+  void CSparseMatrix_scatter_values(CS_INT nz, const double* const x, const CS_INT* const map,
+                                    CSparseMatrix* C);
+
+  /** Kinds of symbolic analyses kept in the cache */
+  typedef enum {
+    CS_SYMBOLIC_LU,      /**< CSparse LU (css from cs_sqr) */
+    CS_SYMBOLIC_CHOL,    /**< CSparse Cholesky (css from cs_schol) */
+    CS_SYMBOLIC_LDLT,    /**< LDL ordering and elimination tree */
+    CS_SYMBOLIC_UMFPACK, /**< UMFPACK Symbolic object */
+    CS_SYMBOLIC_SUPERLU  /**< SuperLU column permutation */
+  } CSparseMatrix_symbolic_kind;
+
+  /** Get a symbolic analysis (ordering, elimination tree, ...) previously
+   *  computed for a matrix with the same sparsity pattern as A.
+   *
+   *  The matrices factorized along a Newton loop or from one time step
+   *  to the next usually keep the same pattern: their factorizations only
+   *  redo the numerical phase. The cache is local to the calling thread
+   *  and keeps the last few analyses; it owns the returned data, which is
+   *  valid until the next call to CSparseMatrix_symbolic_set.
+   *
+   *  \param A the matrix to factorize
+   *  \param kind the kind of analysis (a CSparseMatrix_symbolic_kind)
+   *  \param order the ordering used by the analysis
+   *  \return the analysis, or NULL if the cache has none for this pattern
+   */
+  void* CSparseMatrix_symbolic_get(const CSparseMatrix* const A, int kind, CS_INT order);
+
+  /** Store a symbolic analysis of A in the cache of the calling thread,
+   *  the cache takes the ownership of data.
+   *
+   *  \param A the analysed matrix
+   *  \param kind the kind of analysis (a CSparseMatrix_symbolic_kind)
+   *  \param order the ordering used by the analysis
+   *  \param data the analysis
+   *  \param free_data function releasing data
+   */
+  void CSparseMatrix_symbolic_set(const CSparseMatrix* const A, int kind, CS_INT order,
+                                  void* data, void (*free_data)(void*));
+
+  /** Release all the symbolic analyses kept by the calling thread.
+   *  The cache of the main thread is released at exit, other threads
+   *  should call this function before terminating.
+   */
+  void CSparseMatrix_symbolic_cache_clear(void);
+
   /** Matrix vector multiplication : y = alpha*A*x+beta*y
    *
    *  \param[in] alpha matrix coefficient
@@ -220,6 +344,20 @@ extern "C"
   int CSparseMatrix_aaxpby(const double alpha, const CSparseMatrix *A, const double *x,
                            const double beta, double *y);
 
+  /** Transposed matrix vector multiplication : y = alpha*A^T*x+beta*y.
+   *  Each entry of y is computed from a column of A, large matrices are
+   *  shared between threads (if numerics is built with OpenMP).
+   *
+   *  \param[in] alpha matrix coefficient
+   *  \param[in] A the sparse matrix (compressed columns)
+   *  \param[in] x pointer on a dense vector of size A->m
+   *  \param[in] beta vector coefficient
+   *  \param[in, out] y pointer on a dense vector of size A->n
+   *  \return 0 if A x or y is NULL else 1
+   */
+  int CSparseMatrix_taaxpby(const double alpha, const CSparseMatrix *A, const double *x,
+                            const double beta, double *y);
+
   /** Allocate a CSparse matrix for future copy (as in NSM_copy)
    *
    *  \param m the matrix used as model
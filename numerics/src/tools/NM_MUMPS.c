@@ -121,6 +121,13 @@ void NM_MUMPS_set_id(NumericsMatrix* A, DMUMPS_STRUC_C* id)
 
 void NM_MUMPS(NumericsMatrix* A, int job)
 {
+  /* a new instance or a new analysis invalidates the analysed pattern */
+  if(job < 0 || job == 1 || job == 4 || job == 6)
+  {
+    NSM_linear_solver_params* params = NSM_linearSolverParams(A);
+    params->analysed_pattern = CSparseMatrix_pattern_free(params->analysed_pattern);
+  }
+
 #ifdef SICONOS_HAS_MPI
   if(NM_MPI_rank(A)==0)
   {
@@ -160,6 +167,41 @@ void NM_MUMPS(NumericsMatrix* A, int job)
 #endif
 }
 
+void NM_MUMPS_factorize(NumericsMatrix* A)
+{
+  /* The analysis is skipped when the pattern of A is the one of the last
+   * analysis done by this MUMPS instance (the job number is sent to the
+   * other processes by NM_MUMPS). */
+  NSM_linear_solver_params* params = NSM_linearSolverParams(A);
+
+  if(NM_MPI_rank(A) == 0)
+  {
+    DMUMPS_STRUC_C* mumps_id = NM_MUMPS_id(A);
+    CSparseMatrix* triplet = mumps_id->sym ? NM_half_triplet(A) : NM_triplet(A);
+    size_t fingerprint = CSparseMatrix_pattern_fingerprint(triplet);
+
+    if(params->analysed_pattern
+        && CSparseMatrix_pattern_match(params->analysed_pattern, triplet, fingerprint))
+    {
+      DEBUG_PRINT("NM_MUMPS_factorize: same pattern, the analysis is reused\n");
+      NM_MUMPS(A, 2); /* factorization */
+    }
+    else
+    {
+      NM_MUMPS(A, 4); /* analyzis,factorization */
+      if(mumps_id->info[0] >= 0)
+      {
+        params->analysed_pattern = CSparseMatrix_pattern_new(triplet, fingerprint);
+      }
+    }
+  }
+  else
+  {
+    /* listening process, the job is sent by the process 0 */
+    NM_MUMPS(A, 4);
+  }
+}
+
 void NM_MUMPS_set_icntl(NumericsMatrix* A, unsigned int index, int val)
 {
   DMUMPS_STRUC_C* mumps_id = NM_MUMPS_id(A);
@@ -162,6 +162,14 @@ extern "C"
    */
   void NM_MUMPS(NumericsMatrix* A, int job);
 
+  /** Factorize the matrix set in the MUMPS instance (see NM_MUMPS_set_matrix).
+   *  The analysis phase is skipped if the last analysis done by the
+   *  instance was on a matrix with the same sparsity pattern.
+   *
+   *  \param A the matrix holding the MUMPS config
+   */
+  void NM_MUMPS_factorize(NumericsMatrix* A);
+
   /** Free the config data for MUMPS
    *
    *  \param param p a pointer on the linear solver parameters
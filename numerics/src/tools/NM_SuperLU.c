@@ -23,6 +23,7 @@
 #ifdef WITH_SUPERLU
 
 #include <slu_ddefs.h>
+#include <string.h> // for memcpy
 #include "CSparseMatrix_internal.h"
 #include "NumericsMatrix_internal.h"
 #include "NumericsSparseMatrix.h"
@@ -106,8 +107,21 @@ NM_SuperLU_WS* NM_SuperLU_factorize(NumericsMatrix* A)
 
   dCreate_CompCol_Matrix(&SA, C->m, C->n, nnz, C->x, indices, pointers, SLU_NC, SLU_D, SLU_GE);
 
+  /* the column ordering only depends on the pattern of C, it is reused
+   * if a matrix with the same pattern has already been factorized */
   int permc_spec = 3;
-  get_perm_c(permc_spec, &SA, superlu_ws->perm_c);
+  int_t* perm_c = (int_t*)CSparseMatrix_symbolic_get(C, CS_SYMBOLIC_SUPERLU, permc_spec);
+  if(perm_c)
+  {
+    memcpy(superlu_ws->perm_c, perm_c, C->n * sizeof(int_t));
+  }
+  else
+  {
+    get_perm_c(permc_spec, &SA, superlu_ws->perm_c);
+    perm_c = (int_t*)malloc(C->n * sizeof(int_t));
+    memcpy(perm_c, superlu_ws->perm_c, C->n * sizeof(int_t));
+    CSparseMatrix_symbolic_set(C, CS_SYMBOLIC_SUPERLU, permc_spec, perm_c, &free);
+  }
 
   sp_preorder(superlu_ws->options, &SA, superlu_ws->perm_c, etree, &SAC);
 
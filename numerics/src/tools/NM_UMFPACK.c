@@ -25,6 +25,11 @@
 #include "NumericsMatrix.h"
 #include "NumericsSparseMatrix.h"
 
+static void NM_UMFPACK_free_symbolic(void* symbolic)
+{
+  UMFPACK_FN(free_symbolic)(&symbolic);
+}
+
 NM_UMFPACK_WS* NM_UMFPACK_factorize(NumericsMatrix* A)
 {
   NSM_linear_solver_params* params = NSM_linearSolverParams(A);
@@ -47,16 +52,25 @@ NM_UMFPACK_WS* NM_UMFPACK_factorize(NumericsMatrix* A)
 
   CS_INT status;
 
-  status = UMFPACK_FN(symbolic)(C->m, C->n, C->p, C->i, C->x, &(umfpack_ws->symbolic), umfpack_ws->control, umfpack_ws->info);
+  /* the symbolic analysis only depends on the pattern of C, it is reused
+   * if a matrix with the same pattern has already been factorized */
+  void* symbolic = CSparseMatrix_symbolic_get(C, CS_SYMBOLIC_UMFPACK, 0);
 
-  if(status)
+  if(!symbolic)
   {
-    umfpack_ws->control[UMFPACK_PRL] = 1;
-    UMFPACK_FN(report_status)(umfpack_ws->control, status);
-    return NULL;
+    status = UMFPACK_FN(symbolic)(C->m, C->n, C->p, C->i, C->x, &symbolic, umfpack_ws->control, umfpack_ws->info);
+
+    if(status)
+    {
+      umfpack_ws->control[UMFPACK_PRL] = 1;
+      UMFPACK_FN(report_status)(umfpack_ws->control, status);
+      return NULL;
+    }
+
+    CSparseMatrix_symbolic_set(C, CS_SYMBOLIC_UMFPACK, 0, symbolic, &NM_UMFPACK_free_symbolic);
   }
 
-  status = UMFPACK_FN(numeric)(C->p, C->i, C->x, umfpack_ws->symbolic, &(umfpack_ws->numeric), umfpack_ws->control, umfpack_ws->info);
+  status = UMFPACK_FN(numeric)(C->p, C->i, C->x, symbolic, &(umfpack_ws->numeric), umfpack_ws->control, umfpack_ws->info);
 
   if(status)
   {
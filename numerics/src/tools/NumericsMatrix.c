@@ -19,6 +19,7 @@
 
 #include <assert.h>  // for assert
 #include <float.h>   // for DBL_EPSILON
+#include <limits.h>  // for UINT_MAX
 #include <math.h>    // for fabs, fmax, NAN
 #include <stdint.h>  // for SIZE_MAX
 #include <stdio.h>   // for printf, fprintf, size_t, fscanf
@@ -49,6 +50,10 @@
 #include <openssl/sha.h>
 #endif
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 #ifdef WITH_MKL_SPBLAS
 #include "MKL_common.h"
 #include "NM_MKL_spblas.h"
@@ -499,6 +504,75 @@ void NM_row_prod_no_diag3(size_t sizeX, int block_start, size_t row_start, Numer
 
   NM_version_sync(A);
 }
+/* minimal number of rows of a NM_SPARSE matrix to share NM_gemv and
+ * NM_gemv_no_diag3 between threads */
+#define NM_GEMV_PARALLEL_MIN_ROWS 2048
+
+void NM_gemv_no_diag3(NumericsMatrix* A, const double* x, const double* q, double* y) {
+  assert(A);
+  assert(x);
+  assert(q);
+  assert(y);
+  assert(y != x);
+  assert(A->size0 % 3 == 0);
+  assert(A->size0 == A->size1);
+
+  int n = A->size0;
+
+  switch (A->storageType) {
+    case NM_DENSE: {
+      /* y = q + A x, then the products by the diagonal blocks are removed */
+      double* M = A->matrix0;
+      assert(M);
+      if (y != q) cblas_dcopy(n, q, 1, y, 1);
+      cblas_dgemv(CblasColMajor, CblasNoTrans, n, n, 1.0, M, n, x, 1, 1.0, y, 1);
+      for (int i = 0; i < n; i += 3) {
+        double* diag = &M[i + i * n];
+        for (int k = 0; k < 3; ++k)
+          y[i + k] -= diag[k] * x[i] + diag[k + n] * x[i + 1] + diag[k + 2 * n] * x[i + 2];
+      }
+      break;
+    }
+    case NM_SPARSE_BLOCK: {
+      SBM_gemv_no_diag_3x3(n, n, A->matrix1, x, q, y);
+      break;
+    }
+    case NM_SPARSE: {
+      /* the rows of A, as in NM_row_prod_no_diag3 */
+      CSparseMatrix* M;
+      if (A->matrix2->origin == NSM_CSR) {
+        M = NM_csr(A);
+      } else {
+        M = NM_csc_trans(A);
+      }
+
+      CS_INT* Mp = M->p;
+      CS_INT* Mi = M->i;
+      double* Mx = M->x;
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) if (n >= NM_GEMV_PARALLEL_MIN_ROWS)
+#endif
+      for (int i = 0; i < n; ++i) {
+        CS_INT diag_start = i - i % 3;
+        double yi = q[i];
+        for (CS_INT p = Mp[i]; p < Mp[i + 1]; ++p) {
+          CS_INT j = Mi[p];
+          if (j < diag_start || j >= diag_start + 3) yi += Mx[p] * x[j];
+        }
+        y[i] = yi;
+      }
+      break;
+    }
+    default: {
+      fprintf(stderr, "NM_gemv_no_diag3 :: unknown matrix storage %d", A->storageType);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  NM_version_sync(A);
+}
+
 void NM_row_prod_no_diag2(size_t sizeX, int block_start, size_t row_start, NumericsMatrix* A,
                           double* x, double* y, bool init) {
   assert(A);
@@ -641,6 +715,120 @@ void NM_row_prod_no_diag1x1(size_t sizeX, int block_start, size_t row_start, Num
   NM_version_sync(A);
 }
 
+/* Add the edge (i,j) of the block graph of A to the (growing) list of edges. */
+static void NM_block_graph_add_edge(size_t i, size_t j, size_t** edges, size_t* nb_edges,
+                                    size_t* capacity) {
+  if (i == j) return;
+  if (*nb_edges == *capacity) {
+    *capacity = *capacity ? 2 * *capacity : 64;
+    *edges = (size_t*)realloc(*edges, 2 * *capacity * sizeof(size_t));
+  }
+  (*edges)[2 * *nb_edges] = i;
+  (*edges)[2 * *nb_edges + 1] = j;
+  (*nb_edges)++;
+}
+
+unsigned int NM_block_coloring(NumericsMatrix* A, unsigned int block_size, unsigned int* color) {
+  assert(A);
+  assert(color);
+  assert(block_size > 0);
+
+  size_t nb_blocks = 0;
+  size_t* edges = NULL;
+  size_t nb_edges = 0, capacity = 0;
+
+  /* 1 - Collect the off-diagonal non-zero blocks of A */
+  switch (A->storageType) {
+    case NM_DENSE: {
+      assert(A->size0 % block_size == 0);
+      nb_blocks = A->size0 / block_size;
+      for (size_t bj = 0; bj < nb_blocks; ++bj) {
+        for (size_t bi = 0; bi < nb_blocks; ++bi) {
+          if (bi == bj) continue;
+          int nonzero = 0;
+          for (size_t j = bj * block_size; j < (bj + 1) * block_size && !nonzero; ++j)
+            for (size_t i = bi * block_size; i < (bi + 1) * block_size; ++i)
+              if (A->matrix0[i + j * A->size0] != 0.0) {
+                nonzero = 1;
+                break;
+              }
+          if (nonzero) NM_block_graph_add_edge(bi, bj, &edges, &nb_edges, &capacity);
+        }
+      }
+      break;
+    }
+    case NM_SPARSE_BLOCK: {
+      SparseBlockStructuredMatrix* M = A->matrix1;
+      nb_blocks = M->blocknumber0;
+      /* filled1 is 0 for an SBM without block rows */
+      for (size_t bi = 0; bi + 1 < M->filled1; ++bi) {
+        for (size_t p = M->index1_data[bi]; p < M->index1_data[bi + 1]; ++p) {
+          NM_block_graph_add_edge(bi, M->index2_data[p], &edges, &nb_edges, &capacity);
+        }
+      }
+      break;
+    }
+    case NM_SPARSE: {
+      assert(A->size0 % block_size == 0);
+      nb_blocks = A->size0 / block_size;
+      CSparseMatrix* M = NM_csc(A);
+      for (CS_INT j = 0; j < M->n; ++j) {
+        for (CS_INT p = M->p[j]; p < M->p[j + 1]; ++p) {
+          NM_block_graph_add_edge((size_t)M->i[p] / block_size, (size_t)j / block_size, &edges,
+                                  &nb_edges, &capacity);
+        }
+      }
+      break;
+    }
+    default: {
+      numerics_error("NM_block_coloring", "unknown matrix storage %d", A->storageType);
+    }
+  }
+
+  /* 2 - Symmetrized adjacency of the block graph (compressed row form) */
+  size_t* adj_ptr = (size_t*)calloc(nb_blocks + 1, sizeof(size_t));
+  for (size_t e = 0; e < nb_edges; ++e) {
+    adj_ptr[edges[2 * e] + 1]++;
+    adj_ptr[edges[2 * e + 1] + 1]++;
+  }
+  for (size_t b = 0; b < nb_blocks; ++b) adj_ptr[b + 1] += adj_ptr[b];
+
+  size_t* adj = (size_t*)malloc((adj_ptr[nb_blocks] + 1) * sizeof(size_t));
+  size_t* pos = (size_t*)malloc((nb_blocks + 1) * sizeof(size_t));
+  memcpy(pos, adj_ptr, (nb_blocks + 1) * sizeof(size_t));
+  for (size_t e = 0; e < nb_edges; ++e) {
+    adj[pos[edges[2 * e]]++] = edges[2 * e + 1];
+    adj[pos[edges[2 * e + 1]]++] = edges[2 * e];
+  }
+  free(edges);
+  free(pos);
+
+  /* 3 - Greedy coloring: each block row takes the smallest color not
+     used by its already colored neighbours */
+  unsigned int number_of_colors = 0;
+  size_t* forbidden = (size_t*)malloc((nb_blocks + 1) * sizeof(size_t));
+  for (size_t c = 0; c <= nb_blocks; ++c) forbidden[c] = SIZE_MAX;
+
+  for (size_t b = 0; b < nb_blocks; ++b) color[b] = UINT_MAX;
+
+  for (size_t b = 0; b < nb_blocks; ++b) {
+    for (size_t p = adj_ptr[b]; p < adj_ptr[b + 1]; ++p) {
+      unsigned int c = color[adj[p]];
+      if (c != UINT_MAX) forbidden[c] = b;
+    }
+    unsigned int c = 0;
+    while (forbidden[c] == b) c++;
+    color[b] = c;
+    if (c + 1 > number_of_colors) number_of_colors = c + 1;
+  }
+
+  free(forbidden);
+  free(adj);
+  free(adj_ptr);
+
+  return number_of_colors;
+}
+
 void NM_internalData_free(NumericsMatrix* m) {
   assert(m && "NM_internalData_free, m == NULL");
   if (m->internalData) {
@@ -1712,6 +1900,76 @@ void NM_copy_diag_block3(NumericsMatrix* M, int block_row_nb, double** Block) {
   }
 }
 
+NumericsMatrix* NM_extract_principal_submatrix(NumericsMatrix* A, unsigned int block_size,
+                                               unsigned int n, const unsigned int* blocks) {
+  assert(A);
+  assert(A->size0 == A->size1);
+  NumericsMatrix* B = NULL;
+  int size = (int)(n * block_size);
+  switch (A->storageType) {
+    case NM_DENSE: {
+      B = NM_create(NM_DENSE, size, size);
+      for (unsigned int kj = 0; kj < n; ++kj) {
+        for (unsigned int j = 0; j < block_size; ++j) {
+          double* Bcol = B->matrix0 + (size_t)(kj * block_size + j) * size;
+          const double* Acol = A->matrix0 + (size_t)(blocks[kj] * block_size + j) * A->size0;
+          for (unsigned int ki = 0; ki < n; ++ki)
+            memcpy(Bcol + ki * block_size, Acol + blocks[ki] * block_size,
+                   block_size * sizeof(double));
+        }
+      }
+      break;
+    }
+    case NM_SPARSE_BLOCK: {
+      B = NM_create(NM_SPARSE_BLOCK, size, size);
+      SBM_extract_principal_submatrix(A->matrix1, n, blocks, B->matrix1);
+      break;
+    }
+    case NM_SPARSE: {
+      /* position of the rows/columns of A in B, -1 if dropped */
+      int* position = (int*)malloc(A->size0 * sizeof(int));
+      for (int i = 0; i < A->size0; ++i) position[i] = -1;
+      for (unsigned int k = 0; k < n; ++k)
+        for (unsigned int i = 0; i < block_size; ++i)
+          position[blocks[k] * block_size + i] = (int)(k * block_size + i);
+
+      CSparseMatrix* csc = NM_csc(A);
+      CS_INT* Ap = csc->p;
+      CS_INT* Ai = csc->i;
+      double* Ax = csc->x;
+      CS_INT nz = 0;
+      for (unsigned int k = 0; k < n; ++k)
+        for (unsigned int j = 0; j < block_size; ++j) {
+          CS_INT col = blocks[k] * block_size + j;
+          for (CS_INT p = Ap[col]; p < Ap[col + 1]; ++p)
+            if (position[Ai[p]] >= 0) nz++;
+        }
+
+      B = NM_create(NM_SPARSE, size, size);
+      NM_triplet_alloc(B, nz);
+      CSparseMatrix* triplet = B->matrix2->triplet;
+      for (unsigned int k = 0; k < n; ++k)
+        for (unsigned int j = 0; j < block_size; ++j) {
+          CS_INT col = blocks[k] * block_size + j;
+          for (CS_INT p = Ap[col]; p < Ap[col + 1]; ++p)
+            if (position[Ai[p]] >= 0) {
+              triplet->i[triplet->nz] = position[Ai[p]];
+              triplet->p[triplet->nz] = position[col];
+              triplet->x[triplet->nz] = Ax[p];
+              triplet->nz++;
+            }
+        }
+      free(position);
+      break;
+    }
+    default: {
+      numerics_error("NM_extract_principal_submatrix", "unknown storageType %d for matrix\n",
+                     A->storageType);
+    }
+  }
+  return B;
+}
+
 void NM_add_to_diag3(NumericsMatrix* M, double alpha) {
   size_t n = M->size0;
   switch (M->storageType) {
@@ -2140,12 +2398,21 @@ void NM_clearSparse(NumericsMatrix* A) {
   /* no need to reset version! */
 }
 
+/* the positions of the triplet entries in the csc storage are lost when
+ * one of them is cleared */
+static void NM_clearCSCMap(NumericsMatrix* A) {
+  free(A->matrix2->csc_map);
+  A->matrix2->csc_map = NULL;
+  A->matrix2->csc_map_pattern = CSparseMatrix_pattern_free(A->matrix2->csc_map_pattern);
+}
+
 void NM_clearTriplet(NumericsMatrix* A) {
   if (A->matrix2) {
     if (A->matrix2->triplet) {
       cs_spfree(A->matrix2->triplet);
     }
     A->matrix2->triplet = NULL;
+    NM_clearCSCMap(A);
     NSM_reset_version(A->matrix2, NSM_TRIPLET);
   }
 }
@@ -2166,6 +2433,7 @@ void NM_clearCSC(NumericsMatrix* A) {
       cs_spfree(A->matrix2->csc);
     }
     A->matrix2->csc = NULL;
+    NM_clearCSCMap(A);
     NSM_reset_version(A->matrix2, NSM_CSC);
   }
 }
@@ -2176,6 +2444,8 @@ void NM_clearCSCTranspose(NumericsMatrix* A) {
       cs_spfree(A->matrix2->trans_csc);
     }
     A->matrix2->trans_csc = NULL;
+    free(A->matrix2->trans_csc_map);
+    A->matrix2->trans_csc_map = NULL;
   }
   /* no version for csc transpose as it is a terminal format */
 }
@@ -2468,6 +2738,35 @@ NumericsSparseMatrix* numericsSparseMatrix(NumericsMatrix* A) {
   return A->matrix2;
 }
 
+/* entries of the blocks of B appended to the triplet T, row of blocks by
+ * row of blocks */
+static void NM_SBM_fill_triplet(const SparseBlockStructuredMatrix* const B, CSparseMatrix* T) {
+  /* iteration on row, cr : current row */
+  for (unsigned int cr = 0; cr < B->filled1 - 1; ++cr) {
+    for (size_t bn = B->index1_data[cr]; bn < B->index1_data[cr + 1]; ++bn) {
+      /* cc : current column */
+      size_t cc = B->index2_data[bn];
+      unsigned int inbr = B->blocksize0[cr];
+      unsigned int roffset = 0;
+      unsigned int coffset = 0;
+      if (cr != 0) {
+        roffset = B->blocksize0[cr - 1];
+        inbr -= roffset;
+      }
+      unsigned int inbc = B->blocksize1[cc];
+      if (cc != 0) {
+        coffset = B->blocksize1[cc - 1];
+        inbc -= coffset;
+      }
+      for (unsigned j = 0; j < inbc; ++j) {
+        for (unsigned i = 0; i < inbr; ++i) {
+          CHECK_RETURN(CSparseMatrix_entry(T, i + roffset, j + coffset, B->block[bn][i + j * inbr]));
+        }
+      }
+    }
+  }
+}
+
 CSparseMatrix* NM_triplet(NumericsMatrix* A) {
   if (numericsSparseMatrix(A)->triplet &&
       (NM_max_version(A) > NSM_version(numericsSparseMatrix(A), NSM_TRIPLET))) {
@@ -2495,33 +2794,7 @@ CSparseMatrix* NM_triplet(NumericsMatrix* A) {
         A->matrix2->triplet = cs_spalloc(0, 0, 1, 1, 1);
 
         if (A->matrix1) {
-          /* iteration on row, cr : current row */
-          for (unsigned int cr = 0; cr < A->matrix1->filled1 - 1; ++cr) {
-            for (size_t bn = A->matrix1->index1_data[cr]; bn < A->matrix1->index1_data[cr + 1];
-                 ++bn) {
-              /* cc : current column */
-              size_t cc = A->matrix1->index2_data[bn];
-              unsigned int inbr = A->matrix1->blocksize0[cr];
-              unsigned int roffset = 0;
-              unsigned int coffset = 0;
-              if (cr != 0) {
-                roffset = A->matrix1->blocksize0[cr - 1];
-                inbr -= roffset;
-              }
-              unsigned int inbc = A->matrix1->blocksize1[cc];
-              if (cc != 0) {
-                coffset = A->matrix1->blocksize1[cc - 1];
-                inbc -= coffset;
-              }
-              for (unsigned j = 0; j < inbc; ++j) {
-                for (unsigned i = 0; i < inbr; ++i) {
-                  CHECK_RETURN(CSparseMatrix_entry(A->matrix2->triplet, i + roffset,
-                                                   j + coffset,
-                                                   A->matrix1->block[bn][i + j * inbr]));
-                }
-              }
-            }
-          }
+          NM_SBM_fill_triplet(A->matrix1, A->matrix2->triplet);
           NSM_set_version(A->matrix2, NSM_TRIPLET, NM_version(A, NM_SPARSE_BLOCK));
         } else if (A->matrix0) {
           /* version set in NM_dense_to_sparse */
@@ -2744,17 +3017,159 @@ CSparseMatrix* NM_csc(NumericsMatrix* A) {
 }
 
 CSparseMatrix* NM_csc_trans(NumericsMatrix* A) {
+  CSparseMatrix* csc = NM_csc(A);
+
+  /* the transpose is computed again if the csc matrix has changed */
+  if (numericsSparseMatrix(A)->trans_csc &&
+      A->matrix2->trans_csc_version != NSM_version(A->matrix2, NSM_CSC)) {
+    NM_clearCSCTranspose(A);
+  }
+
   if (!numericsSparseMatrix(A)->trans_csc) {
     assert(A->matrix2);
-    A->matrix2->trans_csc = cs_transpose(NM_csc(A), 1); /* value = 1
-                                                         * ->
-                                                         * allocation */
+    A->matrix2->trans_csc = cs_transpose(csc, 1); /* value = 1
+                                                   * ->
+                                                   * allocation */
+    A->matrix2->trans_csc_version = NSM_version(A->matrix2, NSM_CSC);
   }
 
   NM_version_sync(A);
   return A->matrix2->trans_csc;
 }
 
+/* the values of the triplet storage of A (version new_version) have been
+ * updated: the csc storage and its transpose are updated in place if they
+ * were up to date (version old_version), with the positions of the entries
+ * kept from one update to the next. */
+static int NM_update_csc_values(NumericsMatrix* A, version_t old_version, version_t new_version) {
+  NumericsSparseMatrix* M = A->matrix2;
+  CSparseMatrix* T = M->triplet;
+  int info = 0;
+
+  if (M->csc && NSM_version(M, NSM_CSC) == old_version) {
+    size_t fingerprint = CSparseMatrix_pattern_fingerprint(T);
+    if (!M->csc_map || !CSparseMatrix_pattern_match(M->csc_map_pattern, T, fingerprint)) {
+      NM_clearCSCMap(A);
+      M->csc_map = CSparseMatrix_triplet_to_csc_map(T, M->csc);
+      if (M->csc_map) M->csc_map_pattern = CSparseMatrix_pattern_new(T, fingerprint);
+    }
+    if (M->csc_map) {
+      CSparseMatrix_scatter_values(T->nz, T->x, M->csc_map, M->csc);
+      NSM_set_version(M, NSM_CSC, new_version);
+    } else {
+      /* new pattern: the csc storage is computed again when needed */
+      NM_clearCSC(A);
+      NM_clearCSCTranspose(A);
+      info = 1;
+    }
+  }
+  return info;
+}
+
+/* the values of the csc storage of A have been updated from version
+ * old_version: same thing for its transpose */
+static int NM_update_csc_trans_values(NumericsMatrix* A, version_t old_version) {
+  NumericsSparseMatrix* M = A->matrix2;
+  int info = 0;
+
+  if (M->trans_csc && M->csc && M->trans_csc_version == old_version) {
+    if (!M->trans_csc_map) M->trans_csc_map = CSparseMatrix_transpose_map(M->csc, M->trans_csc);
+    if (M->trans_csc_map) {
+      CSparseMatrix_scatter_values(M->csc->p[M->csc->n], M->csc->x, M->trans_csc_map,
+                                   M->trans_csc);
+      M->trans_csc_version = NSM_version(M, NSM_CSC);
+    } else {
+      NM_clearCSCTranspose(A);
+      info = 1;
+    }
+  }
+  return info;
+}
+
+int NM_update_values(NumericsMatrix* A) {
+  assert(A);
+  NumericsSparseMatrix* M = A->matrix2;
+  int info = 0;
+
+  switch (A->storageType) {
+    case NM_DENSE: {
+      /* the sparse storages are computed again when needed */
+      NM_inc_version(A, NM_DENSE);
+      break;
+    }
+    case NM_SPARSE_BLOCK: {
+      assert(A->matrix1);
+      version_t old_version = NM_version(A, NM_SPARSE_BLOCK);
+      NM_inc_version(A, NM_SPARSE_BLOCK);
+      version_t new_version = NM_version(A, NM_SPARSE_BLOCK);
+      if (M && M->triplet && NSM_version(M, NSM_TRIPLET) == old_version) {
+        /* same blocks: the triplet is filled again without allocation */
+        M->triplet->nz = 0;
+        NM_SBM_fill_triplet(A->matrix1, M->triplet);
+        NSM_set_version(M, NSM_TRIPLET, new_version);
+        version_t old_csc_version = NSM_version(M, NSM_CSC);
+        info = NM_update_csc_values(A, old_version, new_version);
+        info |= NM_update_csc_trans_values(A, old_csc_version);
+      }
+      break;
+    }
+    case NM_SPARSE: {
+      assert(M);
+      switch (M->origin) {
+        case NSM_TRIPLET: {
+          version_t old_version = NSM_version(M, NSM_TRIPLET);
+          version_t old_csc_version = NSM_version(M, NSM_CSC);
+          NSM_inc_version(M, NSM_TRIPLET);
+          info = NM_update_csc_values(A, old_version, NSM_version(M, NSM_TRIPLET));
+          info |= NM_update_csc_trans_values(A, old_csc_version);
+          break;
+        }
+        case NSM_CSC: {
+          version_t old_version = NSM_version(M, NSM_CSC);
+          NSM_inc_version(M, NSM_CSC);
+          info = NM_update_csc_trans_values(A, old_version);
+          break;
+        }
+        case NSM_CSR:
+        case NSM_HALF_TRIPLET: {
+          NSM_inc_version(M, M->origin);
+          break;
+        }
+        default: {
+          NSM_UNKNOWN_ERR("NM_update_values", M->origin);
+          exit(EXIT_FAILURE);
+        }
+      }
+      break;
+    }
+    default: {
+      numerics_error("NM_update_values", "unknown storageType %d", A->storageType);
+    }
+  }
+
+  /* the factorizations (and the preserved copy) are computed again when
+   * needed, the symbolic analyses of the unchanged pattern are reused */
+  if (!NM_destructible(A)) NM_copy(A, A->destructible);
+  NumericsMatrix* D = A->destructible;
+  if (D->internalData) {
+    D->internalData->isInversed = false;
+    D->internalData->isLUfactorized = false;
+    D->internalData->isCholeskyfactorized = false;
+    D->internalData->isLDLTfactorized = false;
+  }
+  if (D->matrix2 && D->matrix2->linearSolverParams) {
+    NSM_linear_solver_params* p = D->matrix2->linearSolverParams;
+    /* a MUMPS instance keeps its analysis for the next factorization */
+    if (p->solver_free_hook && p->solver != NSM_MUMPS) {
+      (*p->solver_free_hook)(p);
+      p->solver_free_hook = NULL;
+    }
+  }
+
+  NM_version_sync(A);
+  return info;
+}
+
 CSparseMatrix* NM_csr(NumericsMatrix* A) {
   assert(A);
   assert(NM_version(A, A->storageType) == NM_max_version(A));
@@ -2825,6 +3240,16 @@ void NM_gemv(const double alpha, NumericsMatrix* A, const double* x, const doubl
 
     case NM_SPARSE: {
       assert(A->storageType == NM_SPARSE);
+#ifdef WITH_OPENMP
+      /* the product on the csc matrix scatters the columns of A in y and
+       * cannot be shared between threads. For large matrices, the rows of A
+       * (columns of the cached transpose) are shared between threads. */
+      if (A->size0 >= NM_GEMV_PARALLEL_MIN_ROWS && omp_get_max_threads() > 1 &&
+          !omp_in_parallel()) {
+        CHECK_RETURN(CSparseMatrix_taaxpby(alpha, NM_csc_trans(A), x, beta, y));
+        break;
+      }
+#endif
       CHECK_RETURN(CSparseMatrix_aaxpby(alpha, NM_csc(A), x, beta, y));
       break;
     }
@@ -2846,7 +3271,8 @@ void NM_tgemv(const double alpha, NumericsMatrix* A, const double* x, const doub
     }
     case NM_SPARSE_BLOCK:
     case NM_SPARSE: {
-      CHECK_RETURN(CSparseMatrix_aaxpby(alpha, NM_csc_trans(A), x, beta, y));
+      /* each column of A gives one entry of y, no transpose is needed */
+      CHECK_RETURN(CSparseMatrix_taaxpby(alpha, NM_csc(A), x, beta, y));
       break;
     }
     default: {
@@ -3345,7 +3771,7 @@ int NM_LU_factorize(NumericsMatrix* Ao) {
 
             NM_MUMPS_set_matrix(A);
 
-            NM_MUMPS(A, 4); /* analyzis,factorization */
+            NM_MUMPS_factorize(A); /* analyzis (if the pattern has changed), factorization */
 
             DMUMPS_STRUC_C* mumps_id = NM_MUMPS_id(A);
 
@@ -4971,7 +5397,7 @@ int NM_Cholesky_factorize(NumericsMatrix* Ao) {
 
             NM_MUMPS_set_matrix(A);
 
-            NM_MUMPS(A, 4); /* analyzis,factorization */
+            NM_MUMPS_factorize(A); /* analyzis (if the pattern has changed), factorization */
 
             DMUMPS_STRUC_C* mumps_id = NM_MUMPS_id(A);
 
@@ -5388,7 +5814,7 @@ int NM_LDLT_factorize(NumericsMatrix* Ao) {
 
             NM_MUMPS_set_matrix(A);
 
-            NM_MUMPS(A, 4); /* analyzis,factorization */
+            NM_MUMPS_factorize(A); /* analyzis (if the pattern has changed), factorization */
 
             DMUMPS_STRUC_C* mumps_id = NM_MUMPS_id(A);
 
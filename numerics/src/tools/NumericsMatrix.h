@@ -221,13 +221,36 @@ extern "C"
   CSparseMatrix* NM_csc(NumericsMatrix *A);
 
   /** Creation, if needed, of the transposed compress column storage
-   *  from compress column storage.
+   *  from compress column storage. The transpose is computed again when
+   *  the version of the compress column storage has changed.
    *
    *  \param[in,out] A a NumericsMatrix with sparse block storage.
    *  \return the transposed compressed column matrix created in A.
    */
   CSparseMatrix* NM_csc_trans(NumericsMatrix* A);
 
+  /** Update of the values of a matrix with an unchanged pattern.
+   *
+   *  The values of the storage of origin of A (A->storageType and, for
+   *  NM_SPARSE, A->matrix2->origin) have been rewritten in place, with the
+   *  same entries (the same blocks for NM_SPARSE_BLOCK). The version of
+   *  this storage is incremented and the up to date triplet, csc and
+   *  transposed csc storages are updated in place, without allocation:
+   *  the positions of the entries in the compressed storages are computed
+   *  at the first update and kept while the pattern does not change.
+   *  The other storages (dense, half triplet, csr) are computed again when
+   *  needed, as are the factorizations of A, which reuse the symbolic
+   *  analysis of the pattern.
+   *
+   *  If the pattern has changed after all, the compressed storages are
+   *  cleared and computed again when needed.
+   *
+   *  \param[in,out] A the matrix
+   *  \return 0 if all the up to date storages have been updated in place,
+   *  1 if some of them have been cleared (new pattern)
+   */
+  int NM_update_values(NumericsMatrix* A);
+
   /** Creation, if needed, of compress row storage of a NumericsMatrix
    *  \warning This rely on the MKL
    *
@@ -495,6 +518,21 @@ extern "C"
   void NM_copy_diag_block3(NumericsMatrix* M, int block_row_nb, double **Block);
 
 
+  /** Extract a principal submatrix: the rows and columns of A are grouped
+   *  by blocks of block_size, B keeps the blocks listed in blocks (in this
+   *  order for the dense and sparse storages, which must be increasing for
+   *  the SBM storage, whose blocks must be the ones of the SBM). The
+   *  storage of B is the one of A, the values are copied.
+   *
+   *  \param[in] A a square NumericsMatrix
+   *  \param[in] block_size the size of the blocks
+   *  \param[in] n the number of blocks to keep
+   *  \param[in] blocks the indices of the blocks to keep
+   *  \return the new matrix, of size n*block_size
+   */
+  RawNumericsMatrix* NM_extract_principal_submatrix(NumericsMatrix* A, unsigned int block_size,
+                                                   unsigned int n, const unsigned int* blocks);
+
   /** Set the submatrix B into the matrix A on the position defined in
    *  (start_i, start_j) position.
    *
@@ -561,6 +599,22 @@ extern "C"
   */
   void NM_row_prod_no_diag3(size_t sizeX, int block_start, size_t row_start, NumericsMatrix* A, double* x, double* y, bool init);
 
+  /** Product by the extra-diagonal 3x3 blocks of a square matrix,
+      y = q + (A - blockdiag(A))*x, i.e. the result of
+      NM_row_prod_no_diag3 for all the rows of blocks (contacts) at once.
+
+      The matrix is streamed once and the rows are shared between OpenMP
+      threads for large matrices: this is the product needed once per
+      iteration by Jacobi-like sweeps, instead of one row product per
+      contact.
+
+      \param[in] A the matrix to be multiplied (size 3n x 3n)
+      \param[in] x the vector to be multiplied
+      \param[in] q the vector added to the product
+      \param[out] y the resulting vector, different from x (it may be q)
+  */
+  void NM_gemv_no_diag3(NumericsMatrix* A, const double* x, const double* q, double* y);
+
   /** Row of a Matrix - vector product y = rowA*x or y += rowA*x, rowA being a submatrix of A (2 rows and sizeX columns)
       \param[in] sizeX dim of the vector x
       \param[in] block_start block number (only used for SBM)
@@ -575,7 +629,25 @@ extern "C"
 
   void NM_row_prod_no_diag1x1(size_t sizeX, int block_start, size_t row_start, NumericsMatrix* A, double* x, double* y, bool init);
 
+  /** Greedy coloring of the (symmetrized) graph of the off-diagonal
+      non-zero blocks of A: two block rows i and j get different colors as
+      soon as A_ij or A_ji is non-zero. Block rows of the same color are
+      then uncoupled, as needed by parallel Gauss-Seidel sweeps.
+
+      \param[in] A the matrix (square blocks)
+      \param[in] block_size size of the blocks (unused if A is SBM)
+      \param[out] color color of each block row, array of size
+      A->size0/block_size (or blocknumber0 for SBM) allocated by the caller
+      \return the number of colors
+  */
+  unsigned int NM_block_coloring(NumericsMatrix* A, unsigned int block_size, unsigned int* color);
+
   /** Matrix vector multiplication : y = alpha A x + beta y
+   *
+   *  With OpenMP, the products by large sparse matrices are shared between
+   *  the threads (OMP_NUM_THREADS or omp_set_num_threads): by rows of
+   *  blocks for NM_SPARSE_BLOCK, by rows using the cached transpose of the
+   *  csc matrix (see NM_csc_trans) for NM_SPARSE.
    *
    *  \param[in] alpha scalar
    *  \param[in] A a NumericsMatrix
@@ -607,6 +679,9 @@ extern "C"
   RawNumericsMatrix * NM_multiply(NumericsMatrix* A, NumericsMatrix* B);
 
   /** Transposed matrix multiplication : y += alpha transpose(A) x + y
+   *
+   *  For sparse matrices, each entry of y is computed from a column of the
+   *  csc matrix, the columns of large matrices are shared between threads.
    *
    *  \param[in] alpha scalar
    *  \param[in] A a NumericsMatrix
@@ -838,7 +913,11 @@ extern "C"
      subsequent calls to NM_LU_solve.
      If the matrix is not preserved, then it is replaced by the
      factorized part.
-   
+     For sparse matrices, the symbolic analysis (ordering, elimination
+     tree) of a matrix with the same sparsity pattern as a previously
+     factorized one is reused, only the numerical factorization is
+     done (see CSparseMatrix_symbolic_get).
+
      \param[in] A the NumericsMatrix
      \return an int, 0 means the matrix has been factorized. 
   */
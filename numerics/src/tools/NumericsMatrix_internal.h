@@ -52,7 +52,8 @@ extern "C"
  * Structure for holding the data UMFPACK needs
  */
 typedef struct {
-  void* symbolic; /**< for the symbolic analysis */
+  void* symbolic; /**< for the symbolic analysis (unused: the analysis is kept in the
+                   * symbolic cache, see CSparseMatrix_symbolic_get) */
   void* numeric;  /**< for the numerical factorization */
   double control[UMFPACK_CONTROL]; /**< control parameters */
   double info[UMFPACK_INFO]; /**< information from UMFPACK */
@@ -157,6 +157,10 @@ void NSM_null(NumericsSparseMatrix* A)
   A->half_triplet = NULL;
   A->csc = NULL;
   A->trans_csc = NULL;
+  A->trans_csc_version = 0;
+  A->csc_map = NULL;
+  A->csc_map_pattern = NULL;
+  A->trans_csc_map = NULL;
   A->csr = NULL;
   A->diag_indx = NULL;
   A->origin = NSM_UNKNOWN;
@@ -243,6 +247,11 @@ NumericsSparseMatrix* NSM_clear(NumericsSparseMatrix* A)
     cs_spfree(A->csr);
     A->csr = NULL;
   }
+  free(A->csc_map);
+  A->csc_map = NULL;
+  A->csc_map_pattern = CSparseMatrix_pattern_free(A->csc_map_pattern);
+  free(A->trans_csc_map);
+  A->trans_csc_map = NULL;
   if(A->diag_indx)
   {
     free(A->diag_indx);
@@ -442,6 +451,7 @@ NSM_linear_solver_params* NSM_linearSolverParams_new(void)
   p->iWork = NULL;
   p->dWork = NULL;
   p->linalg_data = NULL;
+  p->analysed_pattern = NULL;
 
   return p;
 }
@@ -497,6 +507,8 @@ NSM_linear_solver_params* NSM_linearSolverParams_free(NSM_linear_solver_params*
     p->linalg_data = NULL;
   }
 
+  p->analysed_pattern = CSparseMatrix_pattern_free(p->analysed_pattern);
+
   free(p);
   return NULL;
 }
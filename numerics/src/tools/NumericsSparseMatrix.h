@@ -76,6 +76,9 @@ extern "C"
     int dWorkSize;
 
     linalg_data_t* linalg_data; /**< data for the linear algebra */
+
+    CSparseMatrix_pattern* analysed_pattern; /**< pattern of the matrix analysed by the
+                                              * solver instance in linear_solver_data (MUMPS) */
   };
 
   /**\enum NumericsSparseOrigin NumericsSparseMatrix.h
@@ -93,6 +96,12 @@ extern "C"
     CSparseMatrix* half_triplet;    /**< half triplet format for symmetric matrices */
     CSparseMatrix* csc;             /**< csc matrix */
     CSparseMatrix* trans_csc;       /**< transpose of a csc matrix (used by CSparse) */
+    version_t trans_csc_version;    /**< version of the csc matrix transposed in trans_csc */
+    CS_INT*        csc_map;         /**< positions in csc of the triplet entries, for
+                                         the updates of values of NM_update_values */
+    CSparseMatrix_pattern* csc_map_pattern; /**< pattern of the triplet csc_map was
+                                                 computed for */
+    CS_INT*        trans_csc_map;   /**< positions in trans_csc of the csc entries */
     CSparseMatrix* csr;             /**< csr matrix, only supported with mkl */
     CS_INT*        diag_indx;       /**< indices for the diagonal terms.
                                          Very useful for the proximal perturbation */
@@ -248,11 +248,20 @@ SolverOptions * solver_options_copy(SolverOptions* source)
   // Create a new solver options, with default setup
   SolverOptions * options = solver_options_create(source->solverId);
 
-  for(size_t i=0; i < OPTIONS_PARAM_SIZE; ++i)
+  if(options->iSize != source->iSize)
   {
+    options->iparam = (int *)realloc(options->iparam, source->iSize * sizeof(int));
+    options->iSize = source->iSize;
+  }
+  if(options->dSize != source->dSize)
+  {
+    options->dparam = (double *)realloc(options->dparam, source->dSize * sizeof(double));
+    options->dSize = source->dSize;
+  }
+  for(int i=0; i < source->iSize; ++i)
     options->iparam[i] = source->iparam[i];
+  for(int i=0; i < source->dSize; ++i)
     options->dparam[i] = source->dparam[i];
-  }
 
   if(source->dWork)
   {
@@ -272,7 +281,12 @@ SolverOptions * solver_options_copy(SolverOptions* source)
   // this assert should be ensured by solver_options_create and initialize.
 
   for(size_t i=0; i<options->numberOfInternalSolvers; ++i)
+  {
+    // replace the default internal solver
+    solver_options_delete(options->internalSolvers[i]);
+    free(options->internalSolvers[i]);
     options->internalSolvers[i] = solver_options_copy(source->internalSolvers[i]);
+  }
 
   // Warning pointer links!
   if(source->callback)
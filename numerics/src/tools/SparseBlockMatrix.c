@@ -61,6 +61,7 @@ void SBM_null(SparseBlockStructuredMatrix* sbm)
 {
   sbm->nbblocks = 0;
   sbm->block = NULL;
+  sbm->block_data = NULL;
   sbm->blocknumber0 = 0;
   sbm->blocknumber1 = 0;
   sbm->blocksize0 = NULL;
@@ -112,6 +113,15 @@ void SBM_clear(SparseBlockStructuredMatrix *sbm)
     sbm->blocksize1 = NULL;
   }
 
+  if(sbm->block_data)
+  {
+    /* packed storage: the blocks point into block_data */
+    free(sbm->block_data);
+    sbm->block_data = NULL;
+    for(unsigned int i = 0 ; i < sbm->nbblocks ; i++)
+      sbm->block[i] = NULL;
+  }
+
   for(unsigned int i = 0 ; i < sbm->nbblocks ; i++)
   {
     if(sbm->block[i])
@@ -152,6 +162,122 @@ void SBM_clear(SparseBlockStructuredMatrix *sbm)
   sbm->nbblocks = 0;
 }
 
+/* size of the blocks of M if they are all square and of the same size,
+ * 0 otherwise */
+static unsigned int SBM_uniform_block_size(const SparseBlockStructuredMatrix* const M)
+{
+  if(M->blocknumber0 == 0)
+    return 0;
+  unsigned int n = M->blocksize0[0];
+  for(unsigned int i = 1; i < M->blocknumber0; i++)
+  {
+    if(M->blocksize0[i] - M->blocksize0[i-1] != n)
+      return 0;
+  }
+  for(unsigned int j = 0; j < M->blocknumber1; j++)
+  {
+    if(M->blocksize1[j] != (j+1) * n)
+      return 0;
+  }
+  return n;
+}
+
+int SBM_pack_blocks(SparseBlockStructuredMatrix* M)
+{
+  assert(M);
+  if(M->block_data || M->nbblocks == 0)
+    return 0;
+
+  /* all the blocks must be square and of the same size */
+  unsigned int n = SBM_uniform_block_size(M);
+  if(!n)
+    return 1;
+
+  size_t block_length = (size_t)n * n;
+  double * data = (double*) malloc(M->nbblocks * block_length * sizeof(double));
+  for(unsigned int i = 0; i < M->nbblocks; i++)
+  {
+    double * packed_block = data + i * block_length;
+    memcpy(packed_block, M->block[i], block_length * sizeof(double));
+    free(M->block[i]);
+    M->block[i] = packed_block;
+  }
+  M->block_data = data;
+  return 0;
+}
+
+
+void SBM_extract_principal_submatrix(const SparseBlockStructuredMatrix* const A,
+                                     unsigned int n, const unsigned int* index,
+                                     SparseBlockStructuredMatrix* B)
+{
+  assert(A);
+  assert(B);
+  assert(A->blocknumber0 == A->blocknumber1);
+
+  /* position of the block rows/columns of A in B, -1 if dropped */
+  int * position = (int*) malloc(A->blocknumber1 * sizeof(int));
+  for(unsigned int j = 0; j < A->blocknumber1; j++)
+    position[j] = -1;
+  for(unsigned int k = 0; k < n; k++)
+  {
+    assert(index[k] < A->blocknumber1);
+    assert(k == 0 || index[k] > index[k-1]);
+    position[index[k]] = k;
+  }
+
+  B->blocknumber0 = n;
+  B->blocknumber1 = n;
+  B->blocksize0 = (unsigned int*) malloc(n * sizeof(unsigned int));
+  B->blocksize1 = (unsigned int*) malloc(n * sizeof(unsigned int));
+  for(unsigned int k = 0; k < n; k++)
+  {
+    unsigned int size = A->blocksize0[index[k]];
+    if(index[k])
+      size -= A->blocksize0[index[k] - 1];
+    B->blocksize0[k] = k ? B->blocksize0[k-1] + size : size;
+    B->blocksize1[k] = B->blocksize0[k];
+  }
+
+  B->filled1 = n + 1;
+  B->index1_data = (size_t*) malloc(B->filled1 * sizeof(size_t));
+  B->index1_data[0] = 0;
+  for(unsigned int k = 0; k < n; k++)
+  {
+    size_t nb = 0;
+    if(index[k] + 1 < A->filled1)
+      for(size_t blockNum = A->index1_data[index[k]]; blockNum < A->index1_data[index[k] + 1]; blockNum++)
+        if(position[A->index2_data[blockNum]] >= 0)
+          nb++;
+    B->index1_data[k+1] = B->index1_data[k] + nb;
+  }
+
+  B->nbblocks = (unsigned int) B->index1_data[n];
+  B->filled2 = B->nbblocks;
+  B->index2_data = (size_t*) malloc(B->filled2 * sizeof(size_t));
+  B->block = (double**) malloc(B->nbblocks * sizeof(double*));
+  size_t blockNumB = 0;
+  for(unsigned int k = 0; k < n; k++)
+  {
+    if(index[k] + 1 >= A->filled1)
+      continue;
+    unsigned int nbRows = B->blocksize0[k] - (k ? B->blocksize0[k-1] : 0);
+    for(size_t blockNum = A->index1_data[index[k]]; blockNum < A->index1_data[index[k] + 1]; blockNum++)
+    {
+      int col = position[A->index2_data[blockNum]];
+      if(col < 0)
+        continue;
+      unsigned int nbCols = B->blocksize1[col] - (col ? B->blocksize1[col-1] : 0);
+      B->index2_data[blockNumB] = col;
+      B->block[blockNumB] = (double*) malloc(nbRows * nbCols * sizeof(double));
+      memcpy(B->block[blockNumB], A->block[blockNum], nbRows * nbCols * sizeof(double));
+      blockNumB++;
+    }
+  }
+  free(position);
+
+  SBM_pack_blocks(B);
+}
 
 void SBM_print(const SparseBlockStructuredMatrix* const m)
 {
@@ -306,6 +432,9 @@ static sparse_matrix_iterator sparseMatrixBegin(const CSparseMatrix* const spars
 static int sparseMatrixNext(sparse_matrix_iterator* it);
 
 
+/* minimal number of rows of blocks to share SBM_gemv between threads */
+#define SBM_GEMV_PARALLEL_MIN_ROWS 1024
+
 void SBM_gemv(unsigned int sizeX, unsigned int sizeY, double alpha, const SparseBlockStructuredMatrix* const restrict A, const double* restrict x, double beta, double* restrict y)
 {
   /* Product SparseMat - vector, y = A*x (init = 1 = true) or y += A*x (init = 0 = false) */
@@ -322,50 +451,49 @@ void SBM_gemv(unsigned int sizeX, unsigned int sizeY, double alpha, const Sparse
   assert(sizeX == A->blocksize1[A->blocknumber1 - 1]);
   assert(sizeY == A->blocksize0[A->blocknumber0 - 1]);
 
-  /* Column (block) position of the current block*/
-  size_t colNumber;
-  /* Number of rows/columns of the current block */
-  unsigned int nbRows, nbColumns;
-  /* Position of the sub-block of x multiplied by the sub-block of A */
-  unsigned int posInX = 0;
-  /* Position of the sub-block of y, result of the product */
-  unsigned int posInY = 0;
-
   /* Loop over all non-null blocks
-     Works whatever the ordering order of the block is, in A->block
+     Works whatever the ordering order of the block is, in A->block.
+     The rows of blocks write in distinct parts of y and may be
+     processed concurrently.
   */
   cblas_dscal(sizeY, beta, y, 1);
 
-  for(unsigned int currentRowNumber = 0 ; currentRowNumber < A->filled1 - 1; ++currentRowNumber)
+  int nbRowsOfBlocks = (int)A->filled1 - 1;
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(static) if(nbRowsOfBlocks >= SBM_GEMV_PARALLEL_MIN_ROWS)
+#endif
+  for(int currentRowNumber = 0 ; currentRowNumber < nbRowsOfBlocks; ++currentRowNumber)
   {
     /* Get dim. of the current block */
-    nbRows = A->blocksize0[currentRowNumber];
+    unsigned int nbRows = A->blocksize0[currentRowNumber];
     if(currentRowNumber != 0)
       nbRows -= A->blocksize0[currentRowNumber - 1];
     assert((nbRows <= sizeY));
+    /* Get position in y for the ouput sub-block, result of the product */
+    unsigned int posInY = 0;
+    if(currentRowNumber != 0)
+      posInY += A->blocksize0[currentRowNumber - 1];
+
     for(size_t blockNum = A->index1_data[currentRowNumber];
         blockNum < A->index1_data[currentRowNumber + 1]; ++blockNum)
     {
       assert(blockNum < A->filled2);
 
-      colNumber = A->index2_data[blockNum];
+      /* Column (block) position of the current block*/
+      size_t colNumber = A->index2_data[blockNum];
 
       assert(colNumber < sizeX);
 
-      nbColumns = A->blocksize1[colNumber];
+      unsigned int nbColumns = A->blocksize1[colNumber];
       if(colNumber != 0)
         nbColumns -= A->blocksize1[colNumber - 1];
 
       assert((nbColumns <= sizeX));
 
       /* Get position in x of the sub-block multiplied by A sub-block */
-      posInX = 0;
+      unsigned int posInX = 0;
       if(colNumber != 0)
         posInX += A->blocksize1[colNumber - 1];
-      /* Get position in y for the ouput sub-block, result of the product */
-      posInY = 0;
-      if(currentRowNumber != 0)
-        posInY += A->blocksize0[currentRowNumber - 1];
       /* Computes y[] += currentBlock*x[] */
       if(nbRows == 3 && nbColumns == 3)
       {
@@ -379,6 +507,9 @@ void SBM_gemv(unsigned int sizeX, unsigned int sizeY, double alpha, const Sparse
     }
   }
 }
+/* minimal number of rows of blocks to share SBM_gemv_3x3 between threads */
+#define SBM_GEMV_3X3_PARALLEL_MIN_ROWS 1024
+
 void SBM_gemv_3x3(unsigned int sizeX, unsigned int sizeY, const SparseBlockStructuredMatrix* const restrict A,  double* const restrict x, double* restrict y)
 {
   /* Product SparseMat - vector, y = vector product y += alpha*A*x  for block of size 3x3 */
@@ -396,10 +527,15 @@ void SBM_gemv_3x3(unsigned int sizeX, unsigned int sizeY, const SparseBlockStruc
   assert(sizeY == A->blocksize0[A->blocknumber0 - 1]);
 
   /* Loop over all non-null blocks
-     Works whatever the ordering order of the block is, in A->block
+     Works whatever the ordering order of the block is, in A->block.
+     The rows of blocks write in distinct parts of y and may be
+     processed concurrently.
   */
-
-  for(unsigned int currentRowNumber = 0 ; currentRowNumber < A->filled1 - 1; ++currentRowNumber)
+  int nbRowsOfBlocks = (int)A->filled1 - 1;
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(static) if(nbRowsOfBlocks >= SBM_GEMV_3X3_PARALLEL_MIN_ROWS)
+#endif
+  for(int currentRowNumber = 0 ; currentRowNumber < nbRowsOfBlocks; ++currentRowNumber)
   {
     /* Get dim. of the current block */
     int nbRows = A->blocksize0[currentRowNumber];
@@ -440,8 +576,62 @@ void SBM_gemv_3x3(unsigned int sizeX, unsigned int sizeY, const SparseBlockStruc
       assert((nbColumns == 3));
       assert((nbRows == 3));
       mvp3x3(A->block[blockNum], &x[posInX], &y[posInY]);
+    }
+  }
+}
+void SBM_gemv_no_diag_3x3(unsigned int sizeX, unsigned int sizeY, const SparseBlockStructuredMatrix* const restrict A,
+                          const double* const restrict x, const double* q, double* y)
+{
+  /* y = q + sum over the extra-diagonal blocks of Aij.xj, for all the rows
+     of blocks at once (a sweep of SBM_row_prod_no_diag_3x3 over all rows) */
+
+  assert(A);
+  assert(x);
+  assert(q);
+  assert(y);
+  assert(y != x);
+  assert(A->blocksize0);
+  assert(A->blocksize1);
+  assert(A->index1_data);
+  assert(A->index2_data);
+
+  assert(sizeX == A->blocksize1[A->blocknumber1 - 1]);
+  assert(sizeY == A->blocksize0[A->blocknumber0 - 1]);
+
+  int nbRowsOfBlocks = (int)A->filled1 - 1;
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(static) if(nbRowsOfBlocks >= SBM_GEMV_3X3_PARALLEL_MIN_ROWS)
+#endif
+  for(int currentRowNumber = 0 ; currentRowNumber < nbRowsOfBlocks; ++currentRowNumber)
+  {
+    assert(A->blocksize0[currentRowNumber] - (currentRowNumber ? A->blocksize0[currentRowNumber - 1] : 0) == 3);
+
+    unsigned int posInY = 0;
+    if(currentRowNumber != 0)
+      posInY += A->blocksize0[currentRowNumber - 1];
+
+    double yLocal[3] = {q[posInY], q[posInY + 1], q[posInY + 2]};
 
+    for(size_t blockNum = A->index1_data[currentRowNumber];
+        blockNum < A->index1_data[currentRowNumber + 1];
+        ++blockNum)
+    {
+      size_t colNumber = A->index2_data[blockNum];
+      if(colNumber == (size_t)currentRowNumber)
+        continue;
+
+      assert(colNumber < sizeX);
+      unsigned int posInX = 0;
+      if(colNumber != 0)
+        posInX += A->blocksize1[colNumber - 1];
+      assert(A->blocksize1[colNumber] - posInX == 3);
+
+      mvp3x3(A->block[blockNum], &x[posInX], yLocal);
     }
+
+    y[posInY] = yLocal[0];
+    y[posInY + 1] = yLocal[1];
+    y[posInY + 2] = yLocal[2];
   }
 }
 void SBM_extract_component_3x3(const SparseBlockStructuredMatrix* const restrict A, SparseBlockStructuredMatrix*  B,
@@ -1989,6 +2179,7 @@ SparseBlockStructuredMatrix *  SBM_new_from_file(FILE *file)
       }
     }
   }
+  SBM_pack_blocks(m);
   return m;
 }
 
@@ -2299,6 +2490,19 @@ int SBM_copy(const SparseBlockStructuredMatrix* const A, SparseBlockStructuredMa
 
   int need_blocks = 0;
 
+  /* a packed B is reused only if its blocks can be overwritten in place,
+   * i.e. if all the blocks of A have the size of the blocks of B */
+  if(B->block_data && (!copyBlock || B->nbblocks < A->nbblocks ||
+                       SBM_uniform_block_size(A) != B->blocksize0[0]))
+  {
+    free(B->block_data);
+    B->block_data = NULL;
+    for(unsigned i=0; i<B->nbblocks; ++i)
+      B->block [i] = NULL;
+    if(copyBlock)
+      need_blocks = 1;
+  }
+
   if(B->nbblocks < A->nbblocks)
   {
     need_blocks = 1;
@@ -2341,7 +2545,16 @@ int SBM_copy(const SparseBlockStructuredMatrix* const A, SparseBlockStructuredMa
   memcpy(B->index1_data, A->index1_data, A->filled1 * sizeof(size_t));
   memcpy(B->index2_data, A->index2_data, A->filled2 * sizeof(size_t));
 
-  if(copyBlock)
+  if(copyBlock && need_blocks && A->block_data)
+  {
+    /* keep the packed storage of A */
+    size_t block_length = (size_t)A->blocksize0[0] * A->blocksize0[0];
+    B->block_data = (double*) malloc(A->nbblocks * block_length * sizeof(double));
+    memcpy(B->block_data, A->block_data, A->nbblocks * block_length * sizeof(double));
+    for(unsigned int n = 0; n < A->nbblocks; n++)
+      B->block[n] = B->block_data + n * block_length;
+  }
+  else if(copyBlock)
   {
     unsigned int currentRowNumber ;
     size_t colNumber;
@@ -3288,8 +3501,13 @@ void SBMfree(SparseBlockStructuredMatrix* A, unsigned int level)
 
   if(level & NUMERICS_SBM_FREE_BLOCK)
   {
-    for(unsigned int i = 0; i < A->nbblocks; i++)
-      free(A->block[i]);
+    if(A->block_data)
+      free(A->block_data);
+    else
+    {
+      for(unsigned int i = 0; i < A->nbblocks; i++)
+        free(A->block[i]);
+    }
   }
   free(A->block);
   free(A->blocksize0);
@@ -59,6 +59,10 @@
  
    \param index2_data index2_data is of size filled2
    index2_data[blockNumber] -> columnNumber.
+   \param block_data if all the blocks have the same square size n,
+   they can be stored in a single contiguous array (see SBM_pack_blocks()).
+   Then block[i] == block_data + i*n*n and block_data is the only
+   allocation to be freed. block_data is NULL otherwise.
 
    
    Related functions: SBM_gemv(), SBM_row_prod(), SBM_clear(),
@@ -114,6 +118,9 @@ struct SparseBlockStructuredMatrix
   /* the number of non null blocks */
   unsigned int nbblocks;
   double **block;
+  /* contiguous storage of the blocks (packed storage), NULL if the blocks
+     are allocated one by one */
+  double *block_data;
   /* the number of rows of blocks */
   unsigned int blocknumber0;
   /* the number of columns of blocks */
@@ -243,6 +250,26 @@ extern "C"
                   const SparseBlockStructuredMatrix* const A,
                   double* const x, double* y);
 
+  /**
+     Product by the extra-diagonal blocks of a matrix of 3x3 blocks,
+     y = q + (A - diag(A))*x, that is for each row of blocks i
+     y_i = q_i + sum over j != i of A_ij x_j.
+
+     It is the product computed by SBM_row_prod_no_diag_3x3 for all the
+     rows of blocks in a single pass over A (the rows are shared between
+     OpenMP threads for large matrices), as needed by Jacobi-like sweeps.
+
+     \param[in] sizeX dim of the vector x
+     \param[in] sizeY dim of the vectors q and y
+     \param[in] A the matrix to be multiplied
+     \param[in] x the vector to be multiplied
+     \param[in] q the vector added to the product
+     \param[out] y the resulting vector, different from x (it may be q)
+  */
+  void SBM_gemv_no_diag_3x3(unsigned int sizeX, unsigned int sizeY,
+                            const SparseBlockStructuredMatrix* const A,
+                            const double* const x, const double* q, double* y);
+
   /**
      SparseBlockStructuredMatrix - SparseBlockStructuredMatrix product C = alpha*A*B + beta*C
      The routine has to be used with precaution. The allocation of C is not done
@@ -360,6 +387,30 @@ extern "C"
                                  unsigned int *row_components, unsigned int row_components_size,
                                  unsigned int *col_components, unsigned int col_components_size);
 
+  /** Store all the blocks of a matrix in a single contiguous array
+   *  (packed storage, see block_data). The blocks must be square, of the same
+   *  size and owned by the matrix. The block pointers are updated, so that
+   *  all the SBM_* functions work unchanged on the packed matrix.
+   *
+   *  \param[in,out] M the matrix
+   *  \return 0 if the blocks are packed (or already were), 1 if the
+   *  block sizes are not uniform (M is left unchanged)
+   */
+  int SBM_pack_blocks(SparseBlockStructuredMatrix* M);
+
+  /** Extract the principal submatrix of A made of the block rows and
+   *  block columns listed in index. The blocks are copied (and packed if
+   *  their sizes are uniform, see SBM_pack_blocks()).
+   *
+   *  \param[in] A the source SBM (square in blocks)
+   *  \param[in] n the number of block rows/columns to keep
+   *  \param[in] index the block rows/columns of A to keep, in increasing order
+   *  \param[out] B the target SBM, empty on entry (see SBM_new())
+   */
+  void SBM_extract_principal_submatrix(const SparseBlockStructuredMatrix* const A,
+                                       unsigned int n, const unsigned int* index,
+                                       SparseBlockStructuredMatrix* B);
+
   /** 
       Destructor for SparseBlockStructuredMatrix objects
     
@@ -398,7 +449,8 @@ extern "C"
   void SBM_read_in_file(SparseBlockStructuredMatrix* const M, FILE *file);
 
   /**
-     Create from file a SparseBlockStructuredMatrix with  memory allocation
+     Create from file a SparseBlockStructuredMatrix with  memory allocation.
+     If the blocks have a uniform size, they are packed (see SBM_pack_blocks())
      
      \param file the corresponding name of the file
      \return the matrix to be displayed
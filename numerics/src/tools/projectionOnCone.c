@@ -19,6 +19,11 @@
 #include <math.h>    // for sqrt
 #include <stdio.h>   // for fprintf, stderr
 #include <stdlib.h>  // for exit, EXIT_FAILURE
+#include "SiconosConfig.h" // for WITH_OPENMP // IWYU pragma: keep
+
+/* Under this number of contacts, the batched projections are not
+   worth a parallel region. */
+#define PROJECTION_ON_CONE_BATCH_PARALLEL_MIN_SIZE 1024
 
 unsigned projectionOnCone(double* r, double  mu)
 {
@@ -91,3 +96,77 @@ void projectionOnSecondOrderCone(double* r, double  mu, int size)
   }
 
 }
+
+/* Branch free version of projectionOnCone, such that a loop over the
+   contacts can be vectorized. The three cases are computed and the
+   right one is selected. */
+static inline void projectionOnCone_select(double* r0, double* r1, double* r2, double mu)
+{
+  double normT = sqrt(*r1 * *r1 + *r2 * *r2);
+  int dual = (mu * normT <= - *r0);
+  int inside = (normT <= mu * *r0);
+
+  /* boundary case, with a safe denominator for the other cases */
+  double denT = (normT > 0.0) ? normT : 1.0;
+  double rn = (mu * normT + *r0) / (mu * mu + 1.0);
+  double rt1 = mu * rn * *r1 / denT;
+  double rt2 = mu * rn * *r2 / denT;
+
+  *r0 = dual ? 0.0 : (inside ? *r0 : rn);
+  *r1 = dual ? 0.0 : (inside ? *r1 : rt1);
+  *r2 = dual ? 0.0 : (inside ? *r2 : rt2);
+}
+
+void projectionOnCone_batch(double* r, const double* mu, unsigned int nc)
+{
+#ifdef WITH_OPENMP
+  #pragma omp parallel for simd schedule(static) if(nc >= PROJECTION_ON_CONE_BATCH_PARALLEL_MIN_SIZE)
+#endif
+  for(unsigned int ic = 0; ic < nc; ++ic)
+  {
+    projectionOnCone_select(&r[3*ic], &r[3*ic+1], &r[3*ic+2], mu[ic]);
+  }
+}
+
+void projectionOnCone_DeSaxce_batch(double* r, const double* u, const double* mu,
+                                    double rho, unsigned int nc)
+{
+#ifdef WITH_OPENMP
+  #pragma omp parallel for simd schedule(static) if(nc >= PROJECTION_ON_CONE_BATCH_PARALLEL_MIN_SIZE)
+#endif
+  for(unsigned int ic = 0; ic < nc; ++ic)
+  {
+    const double* ui = &u[3*ic];
+    double normUT = sqrt(ui[1] * ui[1] + ui[2] * ui[2]);
+    double r0 = r[3*ic] - rho * (ui[0] + mu[ic] * normUT);
+    double r1 = r[3*ic+1] - rho * ui[1];
+    double r2 = r[3*ic+2] - rho * ui[2];
+    projectionOnCone_select(&r0, &r1, &r2, mu[ic]);
+    r[3*ic] = r0;
+    r[3*ic+1] = r1;
+    r[3*ic+2] = r2;
+  }
+}
+
+double projectionOnCone_DeSaxce_residual_batch(const double* r, const double* u, const double* mu,
+                                               unsigned int nc)
+{
+  double error = 0.0;
+#ifdef WITH_OPENMP
+  #pragma omp parallel for simd schedule(static) reduction(+:error) if(nc >= PROJECTION_ON_CONE_BATCH_PARALLEL_MIN_SIZE)
+#endif
+  for(unsigned int ic = 0; ic < nc; ++ic)
+  {
+    const double* ri = &r[3*ic];
+    const double* ui = &u[3*ic];
+    double p0 = ri[0] - ui[0] - mu[ic] * sqrt(ui[1] * ui[1] + ui[2] * ui[2]);
+    double p1 = ri[1] - ui[1];
+    double p2 = ri[2] - ui[2];
+    projectionOnCone_select(&p0, &p1, &p2, mu[ic]);
+    p0 = ri[0] - p0;
+    p1 = ri[1] - p1;
+    p2 = ri[2] - p2;
+    error += p0 * p0 + p1 * p1 + p2 * p2;
+  }
+  return error;
+}
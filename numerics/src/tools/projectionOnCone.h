@@ -61,6 +61,46 @@ unsigned projectionOnDualCone(double *u, double mu);
 */
 void projectionOnSecondOrderCone(double *r, double mu, int size);
 
+/**
+   projectionOnCone_batch projection of nc contiguous vectors of \f$ R^3 \f$
+   on their cones, as projectionOnCone. The loop over the contacts is
+   vectorized, and multithreaded for large sizes if OpenMP is enabled.
+
+   \param[in,out] r the vectors to be projected, r[3*nc]
+   \param[in] mu the coefficients of friction, mu[nc]
+   \param[in] nc the number of contacts
+*/
+void projectionOnCone_batch(double *r, const double *mu, unsigned int nc);
+
+/**
+   projectionOnCone_DeSaxce_batch fixed point step of projection type
+   methods for all contacts:
+   \f$ r \leftarrow P_K(r - \rho (u + \mu \|u_T\| e_N)) \f$,
+   computed as projectionOnCone_batch.
+
+   \param[in,out] r the reactions, r[3*nc]
+   \param[in] u the velocities, u[3*nc]
+   \param[in] mu the coefficients of friction, mu[nc]
+   \param[in] rho the step length
+   \param[in] nc the number of contacts
+*/
+void projectionOnCone_DeSaxce_batch(double *r, const double *u, const double *mu,
+                                    double rho, unsigned int nc);
+
+/**
+   projectionOnCone_DeSaxce_residual_batch squared norm of the natural map
+   \f$ \sum \|r - P_K(r - (u + \mu \|u_T\| e_N))\|^2 \f$ over all
+   contacts, computed as projectionOnCone_batch.
+
+   \param[in] r the reactions, r[3*nc]
+   \param[in] u the velocities, u[3*nc]
+   \param[in] mu the coefficients of friction, mu[nc]
+   \param[in] nc the number of contacts
+   \return the sum of the squared local errors
+*/
+double projectionOnCone_DeSaxce_residual_batch(const double *r, const double *u,
+                                               const double *mu, unsigned int nc);
+
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
 #endif
@@ -21,6 +21,7 @@
 #include <stdbool.h>  // for false, bool, true
 #endif
 #include <stdlib.h>   // for NULL, abort, size_t
+#include <string.h>   // for memcpy, strncpy
 #include "tlsdef.h"   // for tlsvar
 
 tlsvar jmp_buf internal_jmp_buf;
@@ -32,6 +33,10 @@ tlsvar bool internal_jmp_buf_used = false;
 tlsvar const char* internal_jmp_buf_err = NULL;
 tlsvar const char* external_jmp_buf_err = NULL;
 
+/* copy of the message of the last fatal error: the message given to
+ * sn_fatal_error may live on the stack of a frame left by longjmp */
+tlsvar char fatal_error_msg[2048];
+
 typedef void (*external_fault_handler_t)(size_t, const char*);
 tlsvar external_fault_handler_t external_fault_handler = NULL;
 
@@ -46,6 +51,18 @@ void sn_release_jmp_buf(void)
   external_jmp_buf_used = false;
 }
 
+int sn_save_jmp_buf(jmp_buf* buf)
+{
+  memcpy(*buf, external_jmp_buf, sizeof(jmp_buf));
+  return external_jmp_buf_used;
+}
+
+void sn_restore_jmp_buf(jmp_buf* buf, int used)
+{
+  memcpy(external_jmp_buf, *buf, sizeof(jmp_buf));
+  external_jmp_buf_used = used;
+}
+
 jmp_buf* sn_get_internal_jmp_buf(void)
 {
   internal_jmp_buf_used = true;
@@ -67,13 +84,15 @@ void sn_fatal_error(SN_ERROR_T code, const char* msg)
   if(internal_jmp_buf_used)
   {
     internal_jmp_buf_used = false;
-    internal_jmp_buf_err = msg;
+    strncpy(fatal_error_msg, msg, sizeof(fatal_error_msg) - 1);
+    internal_jmp_buf_err = fatal_error_msg;
     longjmp(internal_jmp_buf, code);
   }
   else if(external_jmp_buf_used)
   {
     external_jmp_buf_used = false;
-    external_jmp_buf_err = msg;
+    strncpy(fatal_error_msg, msg, sizeof(fatal_error_msg) - 1);
+    external_jmp_buf_err = fatal_error_msg;
     longjmp(external_jmp_buf, code);
   }
   else
@@ -50,6 +50,20 @@ extern "C"
    * function has been successful*/
   void sn_release_jmp_buf(void);
 
+  /** Save the external jmp buffer and its status, before it is set for a
+   * nested call. It must be restored with sn_restore_jmp_buf() once the
+   * nested call is over.
+   * \param[out] buf where the buffer is saved
+   * \return 1 if the buffer is in use, 0 otherwise
+   */
+  int sn_save_jmp_buf(jmp_buf* buf);
+
+  /** Restore the external jmp buffer saved by sn_save_jmp_buf()
+   * \param[in] buf the saved buffer
+   * \param[in] used the status returned by sn_save_jmp_buf()
+   */
+  void sn_restore_jmp_buf(jmp_buf* buf, int used);
+
   /* Get the internal jmp buffer and mark it as used
    * \warning this function is ment to be called inside the numerics library.
    * To use the exception handler from an external library/executable, use
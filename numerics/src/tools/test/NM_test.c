@@ -38,6 +38,9 @@
 #include "numericsMatrixTestFunction.h"  // for test_build_first_4_NM, NM_de...
 #include "numerics_verbose.h"            // for numerics_error
 #include "sanitizer.h"                   // for MSAN_INIT_VAR
+#ifdef WITH_OPENMP
+#include <omp.h>                         // for omp_set_num_threads
+#endif
 
 
 #ifdef WITH_MUMPS
@@ -3804,6 +3807,486 @@ static int test_NM_max_by_columns_and_rows(void)
 }
 
 
+static int test_NM_extract_principal_submatrix(void)
+{
+  printf("========= Starts Numerics tests for NM_extract_principal_submatrix ========= \n");
+  /* 4x4 blocks of size 3, the blocks (i,j) with i = j mod 2 are non null */
+  int size = 12;
+  NumericsMatrix * A[3];
+  A[0] = NM_create(NM_DENSE, size, size);
+  NumericsMatrix * A_sparse = NM_create(NM_SPARSE, size, size);
+  NM_triplet_alloc(A_sparse, 0);
+  for(int i = 0; i < size; i++)
+    for(int j = 0; j < size; j++)
+      if((i/3 - j/3) % 2 == 0)
+      {
+        NM_entry(A[0], i, j, i + 0.01 * j + 1.);
+        NM_entry(A_sparse, i, j, i + 0.01 * j + 1.);
+      }
+  A[1] = NM_create(NM_SPARSE_BLOCK, size, size);
+  SBM_from_csparse(3, NM_csc(A_sparse), A[1]->matrix1);
+  A[2] = A_sparse;
+
+  unsigned int blocks[2] = {1, 3};
+  int info = 0;
+  for(int k = 0; k < 3; k++)
+  {
+    NumericsMatrix * B = NM_extract_principal_submatrix(A[k], 3, 2, blocks);
+    if(B->storageType != A[k]->storageType || B->size0 != 6 || B->size1 != 6)
+      info = 1;
+    for(int i = 0; i < 6; i++)
+      for(int j = 0; j < 6; j++)
+        if(NM_get_value(B, i, j) != NM_get_value(A[0], blocks[i/3] * 3 + i % 3, blocks[j/3] * 3 + j % 3))
+          info = 1;
+    if(info)
+      printf("NM_extract_principal_submatrix failed for storage %i\n", A[k]->storageType);
+    NM_clear(B);
+    free(B);
+  }
+  for(int k = 0; k < 3; k++)
+  {
+    NM_clear(A[k]);
+    free(A[k]);
+  }
+  printf("========= End Numerics tests for NM_extract_principal_submatrix ========= \n");
+  return info;
+}
+
+/* products by matrices large enough to be shared between threads */
+static int test_NM_gemv_parallel(void)
+{
+  printf("========= Starts Numerics tests for NumericsMatrix (test_NM_gemv_parallel) ========= \n");
+#ifdef WITH_OPENMP
+  int max_threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  /* block tridiagonal matrix with 3x3 blocks */
+  int nb = 1100;
+  int n = 3 * nb;
+  NumericsMatrix * A_sparse = NM_create(NM_SPARSE, n, n);
+  NM_triplet_alloc(A_sparse, 0);
+  double * A_dense = (double*)calloc(n * n, sizeof(double));
+  for(int i = 0; i < n; i++)
+    for(int j = 3 * (i/3 - 1); j < 3 * (i/3 + 2); j++)
+      if(j >= 0 && j < n)
+      {
+        double a = (i == j) ? 10. : 1. / (1. + i + 2 * j);
+        NM_entry(A_sparse, i, j, a);
+        A_dense[i + j * n] = a;
+      }
+  NumericsMatrix * A_sbm = NM_create(NM_SPARSE_BLOCK, n, n);
+  SBM_from_csparse(3, NM_csc(A_sparse), A_sbm->matrix1);
+
+  double * x = (double*)malloc(n * sizeof(double));
+  double * y = (double*)malloc(n * sizeof(double));
+  double * y_ref = (double*)malloc(n * sizeof(double));
+  for(int i = 0; i < n; i++)
+    x[i] = 1. + sin(i);
+
+  int info = 0;
+  NumericsMatrix * A[2] = {A_sparse, A_sbm};
+  for(int pass = 0; pass < 2; pass++)
+  {
+    if(pass == 1)
+    {
+      /* the values of A change: the cached transpose must be updated */
+      NM_add_to_diag3(A_sparse, 1.);
+      NM_add_to_diag3(A_sbm, 1.);
+      for(int i = 0; i < n; i++)
+        A_dense[i + i * n] += 1.;
+    }
+    for(int k = 0; k < 2; k++)
+      for(int trans = 0; trans < 2; trans++)
+      {
+        for(int i = 0; i < n; i++)
+          y[i] = y_ref[i] = cos(i);
+        cblas_dgemv(CblasColMajor, trans ? CblasTrans : CblasNoTrans, n, n, 2., A_dense, n, x, 1, 0.5, y_ref, 1);
+        if(trans)
+          NM_tgemv(2., A[k], x, 0.5, y);
+        else
+          NM_gemv(2., A[k], x, 0.5, y);
+        for(int i = 0; i < n; i++)
+          if(fabs(y[i] - y_ref[i]) > 1e-12 * (1. + fabs(y_ref[i])))
+          {
+            printf("pass %i, storage %i, trans %i: wrong product at %i (%e != %e)\n",
+                   pass, A[k]->storageType, trans, i, y[i], y_ref[i]);
+            info = 1;
+            break;
+          }
+      }
+  }
+
+  NM_clear(A_sparse);
+  free(A_sparse);
+  NM_clear(A_sbm);
+  free(A_sbm);
+  free(A_dense);
+  free(x);
+  free(y);
+  free(y_ref);
+#ifdef WITH_OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+  printf("========= End Numerics tests for NumericsMatrix (test_NM_gemv_parallel) ========= \n");
+  return info;
+}
+
+/* products by the extra-diagonal blocks, compared to the row products */
+static int test_NM_gemv_no_diag3(void)
+{
+  printf("========= Starts Numerics tests for NumericsMatrix (test_NM_gemv_no_diag3) ========= \n");
+#ifdef WITH_OPENMP
+  int max_threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+#endif
+  /* 3x3 blocks, each contact interacting with its neighbours and with a
+     far away one */
+  int nc = 1100;
+  int n = 3 * nc;
+  NumericsMatrix * A_sparse = NM_create(NM_SPARSE, n, n);
+  NM_triplet_alloc(A_sparse, 0);
+  NumericsMatrix * A_dense = NM_create(NM_DENSE, n, n);
+  for(int ci = 0; ci < nc; ci++)
+  {
+    int cols[4] = {ci - 1, ci, ci + 1, (ci + nc / 2) % nc};
+    for(int c = 0; c < 4; c++)
+    {
+      int cj = cols[c];
+      if(cj < 0 || cj >= nc || (c == 3 && abs(cj - ci) <= 1))
+        continue;
+      for(int i = 3 * ci; i < 3 * ci + 3; i++)
+        for(int j = 3 * cj; j < 3 * cj + 3; j++)
+        {
+          double a = (i == j) ? 10. : 1. / (1. + i + 2 * j);
+          NM_entry(A_sparse, i, j, a);
+          NM_entry(A_dense, i, j, a);
+        }
+    }
+  }
+  NumericsMatrix * A_sbm = NM_create(NM_SPARSE_BLOCK, n, n);
+  SBM_from_csparse(3, NM_csc(A_sparse), A_sbm->matrix1);
+
+  double * x = (double*)malloc(n * sizeof(double));
+  double * q = (double*)malloc(n * sizeof(double));
+  double * y = (double*)malloc(n * sizeof(double));
+  double * y_ref = (double*)malloc(n * sizeof(double));
+  for(int i = 0; i < n; i++)
+  {
+    x[i] = 1. + sin(i);
+    q[i] = cos(i);
+  }
+  for(int ci = 0; ci < nc; ci++)
+  {
+    for(int k = 0; k < 3; k++)
+      y_ref[3 * ci + k] = q[3 * ci + k];
+    NM_row_prod_no_diag3(n, ci, 3 * ci, A_dense, x, &y_ref[3 * ci], false);
+  }
+
+  int info = 0;
+  NumericsMatrix * A[3] = {A_dense, A_sparse, A_sbm};
+  for(int k = 0; k < 3; k++)
+    for(int in_place = 0; in_place < 2; in_place++)
+    {
+      for(int i = 0; i < n; i++)
+        y[i] = in_place ? q[i] : 0.;
+      NM_gemv_no_diag3(A[k], x, in_place ? y : q, y);
+      for(int i = 0; i < n; i++)
+        if(fabs(y[i] - y_ref[i]) > 1e-12 * (1. + fabs(y_ref[i])))
+        {
+          printf("storage %i, in place %i: wrong product at %i (%e != %e)\n",
+                 A[k]->storageType, in_place, i, y[i], y_ref[i]);
+          info = 1;
+          break;
+        }
+    }
+
+  NM_clear(A_sparse);
+  free(A_sparse);
+  NM_clear(A_dense);
+  free(A_dense);
+  NM_clear(A_sbm);
+  free(A_sbm);
+  free(x);
+  free(q);
+  free(y);
+  free(y_ref);
+#ifdef WITH_OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+  printf("========= End Numerics tests for NumericsMatrix (test_NM_gemv_no_diag3) ========= \n");
+  return info;
+}
+
+static int test_NM_block_coloring(void)
+{
+  printf("========= Starts Numerics tests for NumericsMatrix (test_NM_block_coloring) ========= \n");
+  /* 3x3 blocks, each block row coupled with its neighbours and with a
+     far away one */
+  int nc = 50;
+  int n = 3 * nc;
+  NumericsMatrix * A_sparse = NM_create(NM_SPARSE, n, n);
+  NM_triplet_alloc(A_sparse, 0);
+  NumericsMatrix * A_dense = NM_create(NM_DENSE, n, n);
+  for(int i = 0; i < n * n; i++)
+    A_dense->matrix0[i] = 0.;
+  for(int ci = 0; ci < nc; ci++)
+  {
+    int cols[4] = {ci - 1, ci, ci + 1, (ci + nc / 2) % nc};
+    for(int c = 0; c < 4; c++)
+    {
+      int cj = cols[c];
+      if(cj < 0 || cj >= nc)
+        continue;
+      for(int i = 3 * ci; i < 3 * ci + 3; i++)
+        for(int j = 3 * cj; j < 3 * cj + 3; j++)
+        {
+          NM_entry(A_sparse, i, j, 1.);
+          NM_entry(A_dense, i, j, 1.);
+        }
+    }
+  }
+  NumericsMatrix * A_sbm = NM_create(NM_SPARSE_BLOCK, n, n);
+  SBM_from_csparse(3, NM_csc(A_sparse), A_sbm->matrix1);
+
+  int info = 0;
+  unsigned int * color = (unsigned int*)malloc(nc * sizeof(unsigned int));
+  NumericsMatrix * A[3] = {A_dense, A_sparse, A_sbm};
+  for(int k = 0; k < 3; k++)
+  {
+    unsigned int number_of_colors = NM_block_coloring(A[k], 3, color);
+    if(number_of_colors < 2 || number_of_colors > 4)
+    {
+      printf("storage %i: %u colors\n", A[k]->storageType, number_of_colors);
+      info = 1;
+    }
+    for(int ci = 0; ci < nc; ci++)
+    {
+      int cols[3] = {ci - 1, ci + 1, (ci + nc / 2) % nc};
+      for(int c = 0; c < 3; c++)
+        if(cols[c] >= 0 && cols[c] < nc && cols[c] != ci
+           && color[ci] == color[cols[c]])
+        {
+          printf("storage %i: coupled blocks %i and %i have the same color\n",
+                 A[k]->storageType, ci, cols[c]);
+          info = 1;
+        }
+      if(color[ci] >= number_of_colors)
+        info = 1;
+    }
+  }
+
+  /* a matrix without block rows */
+  NumericsMatrix * A_empty = NM_create(NM_SPARSE_BLOCK, 0, 0);
+  if(NM_block_coloring(A_empty, 3, color) != 0)
+  {
+    printf("empty SBM: colors found\n");
+    info = 1;
+  }
+
+  NM_clear(A_sparse);
+  free(A_sparse);
+  NM_clear(A_dense);
+  free(A_dense);
+  NM_clear(A_sbm);
+  free(A_sbm);
+  NM_clear(A_empty);
+  free(A_empty);
+  free(color);
+  printf("========= End Numerics tests for NumericsMatrix (test_NM_block_coloring) ========= \n");
+  return info;
+}
+
+/* values of the tridiagonal matrices of test_NM_update_values */
+static double update_values_entry(int i, int j, int k)
+{
+  return (i == j) ? 4. + k + 0.1 * i : -1. - 0.2 * k;
+}
+
+/* y = A x with the csc storage of A, minus the same product with R */
+static double update_values_product_error(CSparseMatrix* A, NumericsMatrix* R, double * x, double * y)
+{
+  int n = R->size0;
+  for(int i = 0; i < n; i++)
+    y[i] = 0.;
+  CSparseMatrix_aaxpby(1., A, x, 0., y);
+  NM_gemv(-1., R, x, 1., y);
+  return cblas_dnrm2(n, y, 1);
+}
+
+/* new values in place in matrices with the same pattern */
+static int test_NM_update_values(void)
+{
+  printf("========= Starts Numerics tests for NumericsMatrix (test_NM_update_values) ========= \n");
+  int n = 30;
+  int info = 0;
+  double * x = (double*)malloc(n * sizeof(double));
+  double * y = (double*)malloc(n * sizeof(double));
+  double * b = (double*)malloc(n * sizeof(double));
+  for(int i = 0; i < n; i++)
+    x[i] = 1. + sin(i);
+
+  NumericsMatrix * A = NM_create(NM_SPARSE, n, n);
+  NM_triplet_alloc(A, 0);
+  for(int i = 0; i < n; i++)
+    for(int j = i - 1; j <= i + 1; j++)
+      if(j >= 0 && j < n)
+        NM_entry(A, i, j, update_values_entry(i, j, 0));
+  NSM_linearSolverParams(A)->solver = NSM_CSPARSE;
+  NM_csc_trans(A);
+
+  for(int k = 1; k < 4 && !info; k++)
+  {
+    CSparseMatrix * csc = A->matrix2->csc;
+    CSparseMatrix * trans_csc = A->matrix2->trans_csc;
+
+    CSparseMatrix * T = A->matrix2->triplet;
+    for(CS_INT e = 0; e < T->nz; e++)
+      T->x[e] = update_values_entry(T->i[e], T->p[e], k);
+    if(k == 3)
+      /* new entry: the compressed storages must be computed again */
+      CSparseMatrix_entry(T, 0, n - 1, 1.);
+
+    if(NM_update_values(A) != (k == 3))
+    {
+      printf("k = %i: wrong return value of NM_update_values\n", k);
+      info = 1;
+    }
+    if(k < 3 && (NM_csc(A) != csc || NM_csc_trans(A) != trans_csc))
+    {
+      printf("k = %i: the compressed storages have been allocated again\n", k);
+      info = 1;
+    }
+
+    NumericsMatrix * R = NM_create(NM_SPARSE, n, n);
+    NM_triplet_alloc(R, 0);
+    for(int i = 0; i < n; i++)
+      for(int j = i - 1; j <= i + 1; j++)
+        if(j >= 0 && j < n)
+          NM_entry(R, i, j, update_values_entry(i, j, k));
+    if(k == 3)
+      NM_entry(R, 0, n - 1, 1.);
+
+    double err = update_values_product_error(NM_csc(A), R, x, y);
+    NumericsMatrix * RT = NM_transpose(R);
+    err += update_values_product_error(NM_csc_trans(A), RT, x, y);
+    NM_clear(RT);
+    free(RT);
+
+    /* the factorization uses the new values */
+    for(int i = 0; i < n; i++)
+      b[i] = y[i] = 1. + i;
+    info += NM_LU_solve(A, b, 1);
+    NM_gemv(-1., R, b, 1., y);
+    double res = cblas_dnrm2(n, y, 1);
+    printf("k = %i, error on products = %e, residual = %e\n", k, err, res);
+    if(err > 1e-12 || res >= sqrt(DBL_EPSILON))
+      info = 1;
+    NM_clear(R);
+    free(R);
+  }
+
+  /* sparse block storage: the triplet and csc storages follow the blocks */
+  NumericsMatrix * S = NM_create(NM_SPARSE_BLOCK, n, n);
+  SBM_from_csparse(3, NM_csc(A), S->matrix1);
+  CSparseMatrix * csc = NM_csc(S);
+  SparseBlockStructuredMatrix * B = S->matrix1;
+  for(size_t bn = 0; bn < B->nbblocks; bn++)
+    for(int e = 0; e < 9; e++)
+      B->block[bn][e] *= 2.;
+  if(NM_update_values(S) || NM_csc(S) != csc || S->storageType != NM_SPARSE_BLOCK)
+  {
+    printf("sparse block storage: the csc storage has not been updated in place\n");
+    info = 1;
+  }
+  for(int i = 0; i < n; i++)
+    y[i] = 0.;
+  CSparseMatrix_aaxpby(1., NM_csc(S), x, 0., y);
+  NM_gemv(-2., A, x, 1., y);
+  double err = cblas_dnrm2(n, y, 1);
+  printf("sparse block storage, error on products = %e\n", err);
+  if(err > 1e-12)
+    info = 1;
+
+  NM_clear(A);
+  free(A);
+  NM_clear(S);
+  free(S);
+  free(x);
+  free(y);
+  free(b);
+  CSparseMatrix_symbolic_cache_clear();
+  printf("========= End Numerics tests for NumericsMatrix (test_NM_update_values) ========= \n");
+  return info;
+}
+
+/* factorizations of matrices with the same pattern and different values:
+ * the symbolic analysis of the first one is reused for the others */
+static int test_NM_factorize_same_pattern(void)
+{
+  printf("========= Starts Numerics tests for NumericsMatrix (test_NM_factorize_same_pattern) ========= \n");
+  int n = 20;
+  int info = 0;
+  double * b = (double*)malloc(n * sizeof(double));
+  double * y = (double*)malloc(n * sizeof(double));
+
+  for(int k = 0; k < 3 && !info; k++)
+  {
+    /* symmetric positive definite tridiagonal matrix */
+    NumericsMatrix * M = NM_create(NM_SPARSE, n, n);
+    NM_triplet_alloc(M, 0);
+    for(int i = 0; i < n; i++)
+    {
+      NM_entry(M, i, i, 4. + k + 0.1 * i);
+      if(i > 0)
+        NM_entry(M, i, i - 1, -1. - 0.2 * k);
+      if(i < n - 1)
+        NM_entry(M, i, i + 1, -1. - 0.2 * k);
+    }
+    NM_csc(M);
+
+    for(int method = 0; method < 3; method++)
+    {
+      NumericsMatrix * F = NM_create(NM_SPARSE, n, n);
+      NM_copy(M, F);
+      NSM_linear_solver_params* p = NSM_linearSolverParams(F);
+      p->solver = NSM_CSPARSE;
+      p->LDLT_solver = NSM_CSPARSE;
+      int kind = method == 0 ? CS_SYMBOLIC_LU : (method == 1 ? CS_SYMBOLIC_CHOL : CS_SYMBOLIC_LDLT);
+      if(k > 0 && !CSparseMatrix_symbolic_get(NM_csc(F), kind, 1))
+      {
+        printf("no symbolic analysis found for method %i\n", method);
+        info = 1;
+      }
+
+      for(int i = 0; i < n; i++)
+        b[i] = y[i] = 1. + i;
+      if(method == 0)
+        info += NM_LU_solve(F, b, 1);
+      else if(method == 1)
+        info += NM_Cholesky_solve(F, b, 1);
+      else
+        info += NM_LDLT_solve(F, b, 1);
+
+      NM_gemv(-1.0, M, b, 1.0, y);
+      double res = cblas_dnrm2(n, y, 1);
+      printf("k = %i, method = %i, residual = %e\n", k, method, res);
+      if(fabs(res) >= sqrt(DBL_EPSILON))
+        info = 1;
+      NM_clear(F);
+      free(F);
+    }
+    NM_clear(M);
+    free(M);
+  }
+  CSparseMatrix_symbolic_cache_clear();
+
+  free(b);
+  free(y);
+  printf("========= End Numerics tests for NumericsMatrix (test_NM_factorize_same_pattern) ========= \n");
+  return info;
+}
+
+
 #if defined(WITH_MA57) || defined(WITH_MUMPS)
 
 #if defined(WITH_MA57)
@@ -4314,6 +4797,12 @@ int main(int argc, char *argv[])
   info += test_NM_compute_balancing_matrices_sym();
   info += test_NM_compute_balancing_matrices_rectangle();
   info += test_NM_max_by_columns_and_rows();
+  info += test_NM_extract_principal_submatrix();
+  info += test_NM_factorize_same_pattern();
+  info += test_NM_gemv_parallel();
+  info += test_NM_gemv_no_diag3();
+  info += test_NM_block_coloring();
+  info += test_NM_update_values();
 
 
   info +=    test_NM_inv();
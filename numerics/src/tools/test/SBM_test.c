@@ -23,6 +23,7 @@
  */
 
 #include "SBM_test.h"
+#include <math.h>                        // for fabs
 #include <stdio.h>                       // for printf, fclose, fopen, FILE
 #include <stdlib.h>                      // for free, malloc, calloc
 #include "CSparseMatrix_internal.h"               // for CSparseMatrix_spfree_on_stack
@@ -1262,6 +1263,98 @@ int SBM_entry_all(void)
 
 }
 
+static int SBM_pack_blocks_all(void)
+{
+  printf("========= Starts SBM tests for SBM_pack_blocks ========= \n");
+  double tol = 1e-14;
+  int info = 0;
+
+  /* uniform 3x3 blocks: packed when read from file */
+  FILE *file = fopen("data/SBM1.dat", "r");
+  SparseBlockStructuredMatrix * M = SBM_new_from_file(file);
+  fclose(file);
+  if(!M->block_data)
+    info = 1;
+  for(unsigned int i = 0; i < M->nbblocks; i++)
+  {
+    if(M->block[i] != M->block_data + 9 * i)
+      info = 1;
+  }
+
+  int n = M->blocksize0[M->blocknumber0 - 1];
+  int m = M->blocksize1[M->blocknumber1 - 1];
+  double * denseMat = (double *)malloc(n * m * sizeof(double));
+  SBM_to_dense(M, denseMat);
+
+  /* deep copy keeps the packed storage */
+  SparseBlockStructuredMatrix * B = SBM_new();
+  SBM_copy(M, B, 1);
+  if(!B->block_data || B->block_data == M->block_data)
+    info = 1;
+  info += SBM_dense_equal(B, denseMat, tol);
+
+  /* 3x3 and generic products on the packed storage */
+  double * x = (double *)malloc(m * sizeof(double));
+  double * y1 = (double *)calloc(n, sizeof(double));
+  double * y2 = (double *)calloc(n, sizeof(double));
+  for(int i = 0; i < m; i++)
+    x[i] = (double)(i + 1);
+  SBM_gemv(m, n, 1.0, B, x, 0.0, y1);
+  SBM_gemv_3x3(m, n, B, x, y2);
+  for(int i = 0; i < n; i++)
+  {
+    if(fabs(y1[i] - y2[i]) > tol)
+      info = 1;
+  }
+  free(x);
+  free(y1);
+  free(y2);
+  free(denseMat);
+  SBM_clear(B);
+  free(B);
+  SBM_clear(M);
+  free(M);
+
+  /* non uniform blocks: the storage is unchanged */
+  file = fopen("data/SBM2.dat", "r");
+  M = SBM_new_from_file(file);
+  fclose(file);
+  if(M->block_data || SBM_pack_blocks(M) != 1)
+    info = 1;
+
+  /* a packed B with blocks of the size of the first block of M, but
+   * M is not uniform: B must not be reused */
+  NumericsMatrix * U = NM_create(NM_SPARSE, 40, 40);
+  NM_triplet_alloc(U, 0);
+  for(int i = 0; i < 40; i++)
+    for(int j = 0; j < 40; j++)
+      NM_entry(U, i, j, 1.0 + i + 40 * j);
+  B = SBM_new();
+  SBM_from_csparse(5, NM_csc(U), B);
+  if(SBM_pack_blocks(B) || !B->block_data || B->nbblocks < M->nbblocks)
+    info = 1;
+  SBM_copy(M, B, 1);
+  if(B->block_data)
+    info = 1;
+  n = M->blocksize0[M->blocknumber0 - 1];
+  m = M->blocksize1[M->blocknumber1 - 1];
+  denseMat = (double *)malloc(n * m * sizeof(double));
+  SBM_to_dense(M, denseMat);
+  info += SBM_dense_equal(B, denseMat, tol);
+  free(denseMat);
+  SBM_clear(B);
+  free(B);
+  NM_clear(U);
+  free(U);
+  SBM_clear(M);
+  free(M);
+
+  if(info)
+    printf("========= Ends SBM tests for SBM_pack_blocks :  Unsuccessfull ========= \n");
+  else
+    printf("========= Ends SBM tests for SBM_pack_blocks :  successfull ========= \n");
+  return info;
+}
 
 int main()
 {
@@ -1286,5 +1379,7 @@ int main()
 
   info += SBM_extract_component_3x3_all();
 
+  info += SBM_pack_blocks_all();
+
   return info;
 }
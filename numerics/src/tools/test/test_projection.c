@@ -1,6 +1,8 @@
 #include <assert.h>                   // for assert
 #include <projectionOnRollingCone.h>  // for display_status_rolling_cone
+#include <projectionOnCone.h>         // for projectionOnCone_batch
 #include <stdio.h>                    // for printf
+#include <stdlib.h>                   // for malloc, free
 #include "siconos_debug.h"                    // for DEBUG_EXPR
 #include "math.h"                     // for sqrt
 
@@ -19,6 +21,16 @@ static double orthogonality(double * reaction, double * reaction_ori)
   return ortho;
 }
 
+static double compute_diff_n(double * a, double * b, int n)
+{
+  double diff =0.0;
+  for(int i =0; i<n; i++)
+  {
+    diff += (a[i] - b[i])*(a[i] - b[i]);
+  }
+  return sqrt(diff);
+}
+
 static double compute_diff(double * reaction, double * reaction_again)
 {
   double diff =0.0;
@@ -61,6 +73,41 @@ static int test_projection(double * reaction, double mu, double mur)
   return status;
 
 }
+/* the batched projection must give the same results as projectionOnCone */
+static int test_projection_batch(void)
+{
+  printf("################################ \n");
+  printf("start test projectionOnCone_batch \n");
+  printf("################################ \n");
+  int nc = 64;
+  double * r = (double*)malloc(3 * nc * sizeof(double));
+  double * r_ref = (double*)malloc(3 * nc * sizeof(double));
+  double * mu = (double*)malloc(nc * sizeof(double));
+  for(int ic = 0; ic < nc; ic++)
+  {
+    mu[ic] = 0.1 * (ic % 7);
+    r[3 * ic] = cos(0.7 * ic);
+    r[3 * ic + 1] = 2.0 * sin(1.3 * ic);
+    r[3 * ic + 2] = sin(0.4 * ic);
+  }
+  r[0] = 1.0; r[1] = 0.0; r[2] = 0.0;   /* normT == 0 */
+  for(int i = 0; i < 3 * nc; i++) r_ref[i] = r[i];
+
+  unsigned int status_count[3] = {0, 0, 0};
+  for(int ic = 0; ic < nc; ic++)
+    status_count[projectionOnCone(&r_ref[3 * ic], mu[ic])]++;
+  projectionOnCone_batch(r, mu, nc);
+
+  double diff = compute_diff_n(r, r_ref, 3 * nc);
+  printf("cases dual/inside/boundary = %u/%u/%u, diff = %e\n",
+         status_count[PROJCONE_DUAL], status_count[PROJCONE_INSIDE], status_count[PROJCONE_BOUNDARY], diff);
+  free(r);
+  free(r_ref);
+  free(mu);
+  return (diff > 1e-14) || !status_count[PROJCONE_DUAL] ||
+         !status_count[PROJCONE_INSIDE] || !status_count[PROJCONE_BOUNDARY];
+}
+
 int main(void)
 {
 
@@ -136,6 +183,8 @@ int main(void)
     info+=1;
   }
 
+  info += test_projection_batch();
+
   return info;
 
 }
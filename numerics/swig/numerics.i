@@ -196,6 +196,7 @@ static char* format_msg_concat(const char* msg1, const char* msg2)
  %rename (AVI) AffineVariationalInequalities;
 
  %ignore lcp_compute_error_only;
+ %ignore fc3d_driver_batch; // arrays of problems and vectors, no typemap yet
 
  // -- Numpy typemaps --
  // See http://docs.scipy.org/doc/numpy/reference/swig.interface-file.html.
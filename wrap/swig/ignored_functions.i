@@ -9,6 +9,8 @@
 %ignore SiconosGraph::default_color_type const;
 %ignore SiconosGraph::color const;
 %ignore SiconosGraph::index const;
+%ignore SiconosGraph::flat;
+%ignore SiconosGraph::FlatGraph;
 %ignore SiconosMatrix::operator() const;
 %ignore SiconosMatrix::block() const;
 %ignore SiconosMatrix::block(unsigned int) const;